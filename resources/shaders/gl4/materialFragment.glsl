@@ -7,12 +7,16 @@ uniform vec4 modulateColor;
 uniform float globalTime;
 
 in vec3 uv;
+in vec4 vertexColor;
+flat in uint tiled;
 out vec4 result;
 
 void main() {
-    vec4 color = texture(textureUnit, uv);
+    // Merged faces span several blocks, repeat the texture the same way separate faces would map it
+    vec3 coord = tiled != 0u ? vec3(fract(uv.xy) * 0.99, uv.z) : uv;
+    vec4 color = texture(textureUnit, coord);
     if (alphaTest && color.w < 1.0) {
         discard;
     }
-    result = color * modulateColor;
+    result = color * modulateColor * vertexColor;
 }
\ No newline at end of file
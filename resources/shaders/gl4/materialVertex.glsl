@@ -6,11 +6,14 @@ layout(location = 0) in vec3 vp;
 layout(location = 1) in vec2 uvIn;
 layout(location = 2) in float texIndexIn;
 layout(location = 3) in uint flagsIn;
+layout(location = 4) in vec4 colorIn;
 
 uniform mat4 mvp;
 uniform float globalTime;
 
 out vec3 uv;
+out vec4 vertexColor;
+flat out uint tiled;
 
 vec3 waterWave(in vec3 position) {
     float displacement = sin(globalTime * 2.13 + 1.05 * position.x) * waveHeight;
@@ -18,7 +21,9 @@ vec3 waterWave(in vec3 position) {
 }
 
 void main() {
-    vec3 pos = flagsIn == 1 ? waterWave(vp) : vp;
+    vec3 pos = (flagsIn & 1u) != 0u ? waterWave(vp) : vp;
     gl_Position = mvp * vec4(pos, 1.0);
     uv = vec3(uvIn, texIndexIn);
+    vertexColor = colorIn;
+    tiled = flagsIn & 2u;
 }
\ No newline at end of file
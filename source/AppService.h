@@ -35,6 +35,7 @@
 #include "TextureManager.h"
 #include "Video.h"
 #include "script/ScriptManager.h"
+#include "Profiler.h"
 
 namespace Duel6 {
     class AppService {
@@ -47,12 +48,14 @@ namespace Duel6 {
         PlayerControlsManager &controlsManager;
         Sound &sound;
         Script::ScriptManager &scriptManager;
+        Profiler &profiler;
 
     public:
         AppService(Font &font, Console &console, TextureManager &textureManager, Video &video, Input &input,
-                PlayerControlsManager &controlsManager, Sound &sound, Script::ScriptManager &scriptManager)
+                PlayerControlsManager &controlsManager, Sound &sound, Script::ScriptManager &scriptManager,
+                Profiler &profiler)
                 : font(font), console(console), textureManager(textureManager), video(video), input(input),
-                  controlsManager(controlsManager), sound(sound), scriptManager(scriptManager) {}
+                  controlsManager(controlsManager), sound(sound), scriptManager(scriptManager), profiler(profiler) {}
 
         Font &getFont() {
             return font;
@@ -84,6 +87,10 @@ namespace Duel6 {
         Script::ScriptManager &getScriptManager() {
             return scriptManager;
         }
+
+        Profiler &getProfiler() {
+            return profiler;
+        }
     };
 }
 
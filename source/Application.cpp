@@ -28,6 +28,7 @@
 #ifdef D6_SCRIPTING_LUA
     #include <lua.hpp>
 #endif
+#include <algorithm>
 #include "VideoException.h"
 #include "InfoMessageQueue.h"
 #include "Game.h"
@@ -75,7 +76,8 @@ namespace Duel6 {
     Application::Application(Int32 argc, char **argv)
             : console(Console::ExpandFlag), input(console), controlsManager(input), sound(20, console),
               scriptContext(console, sound, gameSettings), scriptManager(scriptContext),
-              requestClose(false) {
+              simulation(profiler.getTickTimes()), requestClose(false) {
+        Uint64 startCounter = SDL_GetPerformanceCounter();
         if (SDL_Init(SDL_INIT_VIDEO) != 0) {
             D6_THROW(VideoException, Format("Unable to set graphics mode: {0}") << SDL_GetError());
         }
@@ -112,7 +114,8 @@ namespace Duel6 {
         font = std::make_unique<Font>(video->getRenderer());
         font->load(D6_FILE_TTF_FONT, console);
 
-        service = std::make_unique<AppService>(*font, console, *textureManager, *video, input, controlsManager, sound, scriptManager);
+        service = std::make_unique<AppService>(*font, console, *textureManager, *video, input, controlsManager, sound,
+                                               scriptManager, profiler);
 
         gameResources.load(console, sound, *textureManager);
 
@@ -131,6 +134,9 @@ namespace Duel6 {
         scriptManager.registerLoaders();
         menu->initialize();
 
+        Float64 startupTime = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+        console.printLine(Format("\n...Startup time: {0} ms") << Int32(startupTime * 1000));
+
         // Execute config script and command line arguments
         console.printLine("\n===Config===");
         ConsoleCommands::registerCommands(console, *service, *menu, gameSettings);
@@ -142,6 +148,7 @@ namespace Duel6 {
     }
 
     Application::~Application() {
+        simulation.stop();
         game.reset();
         menu.reset();
         font.reset();
@@ -255,37 +262,84 @@ namespace Duel6 {
         }
     }
 
-    void Application::syncUpdateAndRender(Context &context) {
-        static Uint32 curTime = 0;
+    void Application::syncUpdate(Context &context) {
+        static Uint64 curCounter = SDL_GetPerformanceCounter();
         static Float64 accumulatedTime = 0.0f;
-        Uint32 lastTime = curTime;
-
-        context.render();
-        video->screenUpdate(console, *font);
+        Uint64 lastCounter = curCounter;
+        // Updates run on the simulation thread, only the frames are drawn here
+        bool concurrent = simulation.isRunning() && context.canUpdateConcurrently();
 
-        curTime = SDL_GetTicks();
-        Float64 elapsedTime = (curTime - lastTime) * 0.001f;
-        accumulatedTime += elapsedTime;
+        curCounter = SDL_GetPerformanceCounter();
+        Float64 elapsedTime = Float64(curCounter - lastCounter) / SDL_GetPerformanceFrequency();
+        accumulatedTime = concurrent ? 0.0 : accumulatedTime + elapsedTime;
 
         while (accumulatedTime > updateTime) {
+            Uint64 startCounter = SDL_GetPerformanceCounter();
             context.update(Float32(updateTime));
+            profiler.getTickTimes().add(
+                    Float64(SDL_GetPerformanceCounter() - startCounter) * 1000.0 / SDL_GetPerformanceFrequency());
             accumulatedTime -= updateTime;
         }
+
+        // Text printed by worker threads since the last frame
+        console.flush();
+        // The remainder of the elapsed time is drawn as part of the next update
+        video->setInterpolation(concurrent ? simulation.getInterpolation() : Float32(accumulatedTime / updateTime));
+    }
+
+    Int32 Application::getMaxFps() const {
+        Int32 maxFps = gameSettings.getMaxFps();
+        Int32 menuMaxFps = gameSettings.getMenuMaxFps();
+        if (Context::exists() && Context::getCurrent().is(*menu) && menuMaxFps > 0) {
+            return maxFps > 0 ? std::min(maxFps, menuMaxFps) : menuMaxFps;
+        }
+        return maxFps;
     }
 
     void Application::run() {
         Context::push(*menu);
+        Uint64 lastFrameCounter = SDL_GetPerformanceCounter();
 
         while (Context::exists() && !requestClose) {
-            Context &context = Context::getCurrent();
-            processEvents(context);
-            syncUpdateAndRender(context);
+            video->getFramePacer().startFrame();
+            if (gameSettings.isThreadedUpdate() != simulation.isRunning()) {
+                if (gameSettings.isThreadedUpdate()) {
+                    simulation.start();
+                } else {
+                    simulation.stop();
+                }
+            }
 
-            if (context.isClosed()) {
-                Context::pop();
+            {
+                // The simulation thread waits only for the events and the updates due here, not for the frame
+                std::lock_guard<TicketMutex> lock(simulation.getWorldMutex());
+                Context &context = Context::getCurrent();
+                processEvents(context);
+                syncUpdate(context);
+
+                if (context.isClosed()) {
+                    Context::pop();
+                }
+                if (Context::exists()) {
+                    Context::getCurrent().beforeRender();
+                }
             }
+
+            if (Context::exists()) {
+                Context::getCurrent().render();
+                video->renderConsole(console, *font);
+            }
+
+            video->swapBuffers();
+            Uint64 frameCounter = SDL_GetPerformanceCounter();
+            profiler.getFrameTimes().add(
+                    Float64(frameCounter - lastFrameCounter) * 1000.0 / SDL_GetPerformanceFrequency());
+            lastFrameCounter = frameCounter;
+
+            video->getFramePacer().wait(getMaxFps());
         }
 
+        simulation.stop();
         while (Context::exists()) // Pop all contexts (if any) to execute all beforeClose logic
         {
             Context::pop();
@@ -34,6 +34,7 @@
 #include "Menu.h"
 #include "Game.h"
 #include "Video.h"
+#include "SimulationThread.h"
 #include "script/ScriptManager.h"
 
 namespace Duel6 {
@@ -50,6 +51,8 @@ namespace Duel6 {
         GameResources gameResources;
         Script::ScriptContext scriptContext;
         Script::ScriptManager scriptManager;
+        Profiler profiler;
+        SimulationThread simulation;
         std::unique_ptr<Menu> menu;
         std::unique_ptr<Game> game;
         std::unique_ptr<AppService> service;
@@ -77,7 +80,9 @@ namespace Duel6 {
 
         void joyDeviceAddedEvent(Context & context, const JoyDeviceAddedEvent & event);
         void joyDeviceRemovedEvent(Context & context, const JoyDeviceRemovedEvent & event);
-        void syncUpdateAndRender(Context &context);
+        void syncUpdate(Context &context);
+
+        Int32 getMaxFps() const;
     };
 }
 
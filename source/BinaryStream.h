@@ -0,0 +1,141 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_BINARYSTREAM_H
+#define DUEL6_BINARYSTREAM_H
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Type.h"
+#include "IoException.h"
+
+namespace Duel6 {
+    /**
+     * Appends plain values to a byte buffer in the native byte order. Objects that refer to others
+     * write their indexes, see writeIndex().
+     */
+    class BinaryWriter {
+    private:
+        std::vector<Uint8> data;
+
+    public:
+        template<class T>
+        void write(const T &value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written");
+            const Uint8 *bytes = reinterpret_cast<const Uint8 *>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        void write(const std::string &value) {
+            write(Uint16(value.size()));
+            data.insert(data.end(), value.begin(), value.end());
+        }
+
+        /**
+         * Writes position of the value in the list, -1 when it is not there.
+         */
+        template<class T>
+        void writeIndex(const std::vector<T> &values, const T &value) {
+            Int16 index = -1;
+            for (Size i = 0; i < values.size(); i++) {
+                if (values[i] == value) {
+                    index = Int16(i);
+                    break;
+                }
+            }
+            write(index);
+        }
+
+        const std::vector<Uint8> &getData() const {
+            return data;
+        }
+
+        std::vector<Uint8> &getData() {
+            return data;
+        }
+    };
+
+    class BinaryReader {
+    private:
+        const std::vector<Uint8> &data;
+        Size position;
+
+    public:
+        explicit BinaryReader(const std::vector<Uint8> &data)
+                : data(data), position(0) {}
+
+        template<class T>
+        T read() {
+            static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read");
+            T value;
+            memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        template<class T>
+        void read(T &value) {
+            value = read<T>();
+        }
+
+        std::string readString() {
+            Size length = read<Uint16>();
+            const char *chars = reinterpret_cast<const char *>(take(length));
+            return std::string(chars, length);
+        }
+
+        /**
+         * Reads an index written by BinaryWriter::writeIndex().
+         * @return value at the index or the fallback for -1
+         */
+        template<class T>
+        T readIndex(const std::vector<T> &values, const T &fallback) {
+            Int16 index = read<Int16>();
+            if (index >= Int16(values.size())) {
+                D6_THROW(IoException, "Binary data refers to a missing item");
+            }
+            return index < 0 ? fallback : values[index];
+        }
+
+        bool isEnd() const {
+            return position == data.size();
+        }
+
+    private:
+        const Uint8 *take(Size length) {
+            if (position + length > data.size()) {
+                D6_THROW(IoException, "Binary data is truncated");
+            }
+            const Uint8 *bytes = data.data() + position;
+            position += length;
+            return bytes;
+        }
+    };
+}
+
+#endif
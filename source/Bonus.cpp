@@ -156,12 +156,6 @@ namespace Duel6 {
         this->position.z = 0.5f;
     }
 
-    void Bonus::render(Renderer &renderer, Texture texture) const {
-        Vector pos = getSpritePosition();
-        Material material = Material::makeMaskedTexture(texture);
-        renderer.quadXY(pos, Vector(1.0f, 1.0f), Vector(0.1f, 0.9f, Float32(textureIndex)), Vector(0.8f, -0.8f), material);
-    }
-
     Vector Bonus::getSpritePosition() const {
         return Vector(position.x - 0.2f, position.y - 0.2f, 0.47f);
     }
@@ -178,12 +172,6 @@ namespace Duel6 {
         collider.velocity.y *= 2;
     }
 
-    void LyingWeapon::render(Renderer &renderer) const {
-        Vector pos = getSpritePosition();
-        Material material = Material::makeMaskedTexture(weapon.getBonusTexture());
-        renderer.quadXY(pos, Vector(1.0f, 1.0f), Vector(0.1f, 0.9f, Float32(weapon.getBonusTextureIndex())), Vector(0.8f, -0.8f), material);
-    }
-
     Vector LyingWeapon::getSpritePosition() const {
         auto position = collider.position;
         return Vector(position.x, position.y, 0.47f);
@@ -120,8 +120,6 @@ namespace Duel6 {
     public:
         Bonus(BonusType type, Int32 duration, const Vector &position, Int32 textureIndex);
 
-        void render(Renderer &renderer, Texture texture) const;
-
         const BonusType &getType() const {
             return bonus;
         }
@@ -134,6 +132,10 @@ namespace Duel6 {
             return position;
         }
 
+        Int32 getTextureIndex() const {
+            return textureIndex;
+        }
+
         Vector getDimensions() const {
             return Vector(0.6f, 0.6f);
         }
@@ -157,8 +159,6 @@ namespace Duel6 {
 
         LyingWeapon(Weapon weapon, Int32 bullets, const Vector &position);
 
-        void render(Renderer &renderer) const;
-
         const Weapon &getWeapon() const {
             return weapon;
         }
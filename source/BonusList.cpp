@@ -25,35 +25,43 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include "math/Math.h"
+#include "math/Random.h"
 #include "Sound.h"
 #include "BonusList.h"
 #include "World.h"
 #include "collision/Collision.h"
+#include "RenderState.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
     BonusList::BonusList(const GameSettings &settings, const GameResources &resources, World &world)
-            : settings(settings), texture(resources.getBonusTextures()), world(world) {}
+            : settings(settings), texture(resources.getBonusTextures()), world(world),
+              bonusGrid(world.getLevel().getWidth(), world.getLevel().getHeight()),
+              weaponGrid(world.getLevel().getWidth(), world.getLevel().getHeight()), nextBonusKey(0),
+              nextWeaponKey(0) {}
 
-    void BonusList::render(Renderer &renderer) const {
+    void BonusList::captureRenderState(RenderState &state) const {
+        state.bonuses.clear();
         for (const Bonus &bonus : bonuses) {
-            bonus.render(renderer, texture);
+            state.bonuses.push_back({bonus.getSpritePosition(), texture, bonus.getTextureIndex()});
         }
 
         for (const LyingWeapon &weapon : weapons) {
-            weapon.render(renderer);
+            const Weapon &type = weapon.getWeapon();
+            state.bonuses.push_back({weapon.getSpritePosition(), type.getBonusTexture(), type.getBonusTextureIndex()});
         }
     }
 
     void BonusList::addRandomBonus() {
         const Level &level = world.getLevel();
-        bool weapon = (Math::random(2) == 1);
+        Random &random = world.getRandom();
+        bool weapon = (random.random(2) == 1);
         Int32 x, y, attempts = 0;
 
         do {
             attempts++;
-            x = Math::random(level.getWidth());
-            y = Math::random(level.getHeight());
+            x = random.random(level.getWidth());
+            y = random.random(level.getHeight());
         } while (!isValidPosition(x, y, weapon) && attempts <= MAX_BONUS_ATTEMPTS);
 
         if (attempts > MAX_BONUS_ATTEMPTS) {
@@ -61,14 +69,34 @@ namespace Duel6 {
         }
 
         if (weapon) {
-            Int32 bullets = Math::random(10) + 10;
-            weapons.push_back(LyingWeapon(Weapon::getRandomEnabled(settings), bullets, Vector(x, y)));
+            Int32 bullets = random.random(10) + 10;
+            addWeapon(LyingWeapon(Weapon::getRandomEnabled(settings, random), bullets, Vector(x, y)));
         } else {
-            BonusType type = BonusType::values()[Math::random(BonusType::values().size())];
-            bool random = Math::random(RANDOM_BONUS_FREQUENCY) == 0;
-            Int32 duration = type.isOneTime() ? 0 : 13 + Math::random(17);
-            bonuses.push_back(
-                    Bonus(type, duration, Vector(x + 0.2f, y + 0.2f), random ? 0 : type.getTextureIndex()));
+            BonusType type = BonusType::values()[random.random(Int32(BonusType::values().size()))];
+            bool hidden = random.random(RANDOM_BONUS_FREQUENCY) == 0;
+            Int32 duration = type.isOneTime() ? 0 : 13 + random.random(17);
+            addBonus(Bonus(type, duration, Vector(x + 0.2f, y + 0.2f), hidden ? 0 : type.getTextureIndex()));
+        }
+    }
+
+    void BonusList::addBonus(const Bonus &bonus) {
+        if (bonuses.empty()) {
+            nextBonusKey = 0;
+        }
+        bonuses.push_back(bonus);
+        bonusGrid.insert(nextBonusKey++, std::prev(bonuses.end()), bonus.getCollisionRect());
+    }
+
+    void BonusList::addWeapon(const LyingWeapon &weapon) {
+        weapons.push_back(weapon);
+        weaponGrid.insert(nextWeaponKey++, std::prev(weapons.end()), weapon.getCollisionRect());
+    }
+
+    void BonusList::rebuildWeaponGrid() {
+        weaponGrid.clear();
+        nextWeaponKey = 0;
+        for (auto weapon = weapons.begin(); weapon != weapons.end(); ++weapon) {
+            weaponGrid.insert(nextWeaponKey++, weapon, weapon->getCollisionRect());
         }
     }
 
@@ -79,38 +107,45 @@ namespace Duel6 {
             return false;
         }
 
+        bool valid = true;
         Rectangle candidate = Rectangle::fromCorners(Vector(x - 2, y - 2), Vector(x + 2, y + 2));
-        for (Player &player : world.getPlayers()) {
-            if (Collision::rectangles(candidate, player.getCollisionRect())) {
-                return false;
-            }
-        }
+        world.getPlayerGrid().forEach(candidate, [&candidate, &valid](SpatialGrid<Player *>::Key key, Player *player) {
+            valid = !Collision::rectangles(candidate, player->getCollisionRect());
+            return valid;
+        });
 
         candidate = Rectangle::fromCorners(Vector(x, y), Vector(x + 1, y + 1));
-        for (const Bonus &bonus : bonuses) {
-            if (Collision::rectangles(candidate, bonus.getCollisionRect())) {
-                return false;
-            }
+        if (valid) {
+            bonusGrid.forEach(candidate, [&candidate, &valid](BonusGrid::Key key, BonusIterator bonus) {
+                valid = !Collision::rectangles(candidate, bonus->getCollisionRect());
+                return valid;
+            });
         }
 
-        for (const LyingWeapon &lyingWeapon : weapons) {
-            if (Collision::rectangles(candidate, lyingWeapon.getCollisionRect())) {
-                return false;
-            }
+        if (valid) {
+            weaponGrid.forEach(candidate, [&candidate, &valid](WeaponGrid::Key key, WeaponIterator lyingWeapon) {
+                valid = !Collision::rectangles(candidate, lyingWeapon->getCollisionRect());
+                return valid;
+            });
         }
 
-        return true;
+        return valid;
     }
 
     void BonusList::addPlayerGun(Player &player, const CollidingEntity &playerCollider) {
-        weapons.push_back(LyingWeapon(player.getWeapon(), player.getAmmo(), player.getReloadTime(), playerCollider));
+        addWeapon(LyingWeapon(player.getWeapon(), player.getAmmo(), player.getReloadTime(), playerCollider));
     }
 
     void BonusList::checkBonus(Player &player) {
-        auto bonusIter = bonuses.begin();
-        while (bonusIter != bonuses.end()) {
-            Bonus &bonus = *bonusIter;
-            BonusType type = bonusIter->getType();
+        touchedBonuses.clear();
+        bonusGrid.forEach(player.getCollisionRect(), [this](BonusGrid::Key key, BonusIterator bonus) {
+            touchedBonuses.emplace_back(key, bonus);
+            return true;
+        });
+
+        for (auto &touched : touchedBonuses) {
+            Bonus &bonus = *touched.second;
+            BonusType type = bonus.getType();
 
             bool collides = Collision::rectangles(bonus.getCollisionRect(), player.getCollisionRect());
             if (collides && type.isApplicable(player, world)) {
@@ -121,9 +156,8 @@ namespace Duel6 {
                 }
 
                 player.playSound(PlayerSounds::Type::PickedBonus);
-                bonusIter = bonuses.erase(bonusIter);
-            } else {
-                ++bonusIter;
+                bonusGrid.remove(touched.first);
+                bonuses.erase(touched.second);
             }
         }
     }
@@ -136,29 +170,85 @@ namespace Duel6 {
                 weapon.pickTimeout -= elapsedTime;
             }
         }
+        rebuildWeaponGrid();
     }
 
     void BonusList::checkWeapon(Player &player) {
-        auto weaponIter = weapons.begin();
-        while (weaponIter != weapons.end()) {
-            LyingWeapon &weapon = *weaponIter;
-            Weapon type = weapon.getWeapon();
-
-            bool collides = Collision::rectangles(weapon.getCollisionRect(), player.getCollisionRect());
-            if (weapon.pickTimeout <= 0.0f && collides) {
-                if (player.hasGun() && player.getAmmo() > 0) {
-                    // Leave the current weapon at the same place
-                    addPlayerGun(player, player.getCollider());
-                }
+        const Rectangle playerRect = player.getCollisionRect();
+        bool found = false;
+        WeaponGrid::Key pickedKey = 0;
+        WeaponIterator picked;
+
+        weaponGrid.forEach(playerRect, [&](WeaponGrid::Key key, WeaponIterator weapon) {
+            if (weapon->pickTimeout <= 0.0f && Collision::rectangles(weapon->getCollisionRect(), playerRect)) {
+                found = true;
+                pickedKey = key;
+                picked = weapon;
+                return false;
+            }
+            return true;
+        });
 
-                player.pickWeapon(type, weapon.getBullets(), weapon.remainingReloadTime);
-                world.getMessageQueue().add(player, Format("You picked up gun {0}") << type.getName());
+        if (!found) {
+            return;
+        }
 
-                weapons.erase(weaponIter);
-                return;
-            } else {
-                ++weaponIter;
-            }
+        LyingWeapon &weapon = *picked;
+        Weapon type = weapon.getWeapon();
+        if (player.hasGun() && player.getAmmo() > 0) {
+            // Leave the current weapon at the same place
+            addPlayerGun(player, player.getCollider());
+        }
+
+        player.pickWeapon(type, weapon.getBullets(), weapon.remainingReloadTime);
+        world.getMessageQueue().add(player, Format("You picked up gun {0}") << type.getName());
+
+        weaponGrid.remove(pickedKey);
+        weapons.erase(picked);
+    }
+
+    void BonusList::saveState(BinaryWriter &writer) const {
+        writer.write(Uint32(bonuses.size()));
+        for (const Bonus &bonus : bonuses) {
+            writer.writeIndex(BonusType::values(), bonus.getType());
+            writer.write(bonus.getDuration());
+            writer.write(bonus.getPosition());
+            writer.write(bonus.getTextureIndex());
+        }
+
+        writer.write(Uint32(weapons.size()));
+        for (const LyingWeapon &weapon : weapons) {
+            writer.writeIndex(Weapon::values(), weapon.getWeapon());
+            writer.write(weapon.getBullets());
+            weapon.collider.saveState(writer, world.getElevatorList());
+            writer.write(weapon.pickTimeout);
+            writer.write(weapon.remainingReloadTime);
+        }
+    }
+
+    void BonusList::restoreState(BinaryReader &reader) {
+        // Grid keys only order the items, so they are simply renumbered
+        bonuses.clear();
+        bonusGrid.clear();
+        nextBonusKey = 0;
+        Size count = reader.read<Uint32>();
+        for (Size i = 0; i < count; i++) {
+            BonusType type = reader.readIndex(BonusType::values(), BonusType::NONE);
+            Int32 duration = reader.read<Int32>();
+            Vector position = reader.read<Vector>();
+            addBonus(Bonus(type, duration, position, reader.read<Int32>()));
+        }
+
+        weapons.clear();
+        count = reader.read<Uint32>();
+        for (Size i = 0; i < count; i++) {
+            Weapon type = reader.readIndex(Weapon::values(), Weapon());
+            LyingWeapon weapon(type, reader.read<Int32>(), Vector::ZERO);
+            weapon.collider.restoreState(reader, world.getElevatorList());
+            reader.read(weapon.pickTimeout);
+            reader.read(weapon.remainingReloadTime);
+            weapons.push_back(weapon);
         }
+        rebuildWeaponGrid();
     }
 }
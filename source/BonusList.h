@@ -29,6 +29,7 @@
 #define DUEL6_BONUSLIST_H
 
 #include <list>
+#include <vector>
 #include "Type.h"
 #include "Bonus.h"
 #include "Player.h"
@@ -37,15 +38,28 @@
 #include "Level.h"
 #include "GameSettings.h"
 #include "GameResources.h"
+#include "collision/SpatialGrid.h"
 
 namespace Duel6 {
+    class RenderState;
+
     class BonusList {
     private:
         const GameSettings &settings;
         Texture texture;
+        typedef std::list<Bonus>::iterator BonusIterator;
+        typedef std::list<LyingWeapon>::iterator WeaponIterator;
+        typedef SpatialGrid<BonusIterator> BonusGrid;
+        typedef SpatialGrid<WeaponIterator> WeaponGrid;
+
         World &world;
         std::list<Bonus> bonuses;
         std::list<LyingWeapon> weapons;
+        BonusGrid bonusGrid;
+        WeaponGrid weaponGrid;
+        BonusGrid::Key nextBonusKey;
+        WeaponGrid::Key nextWeaponKey;
+        std::vector<std::pair<BonusGrid::Key, BonusIterator>> touchedBonuses;
 
     private:
         static const Int32 RANDOM_BONUS_FREQUENCY = 6;
@@ -53,6 +67,12 @@ namespace Duel6 {
 
         bool isValidPosition(const Int32 x, const Int32 y, bool weapon);
 
+        void addBonus(const Bonus &bonus);
+
+        void addWeapon(const LyingWeapon &weapon);
+
+        void rebuildWeaponGrid();
+
     public:
         BonusList(const GameSettings &settings, const GameResources &resources, World &world);
 
@@ -60,13 +80,18 @@ namespace Duel6 {
 
         void addRandomBonus();
 
-        void render(Renderer &renderer) const;
+        // Bonuses and then lying weapons
+        void captureRenderState(RenderState &state) const;
 
         void addPlayerGun(Player &player, const CollidingEntity &playerColliders);
 
         void checkBonus(Player &player);
 
         void checkWeapon(Player &player);
+
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
     };
 
 }
@@ -0,0 +1,248 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstring>
+#include "CompiledLevel.h"
+#include "Level.h"
+#include "GameException.h"
+#include "IoException.h"
+#include "json/JsonParser.h"
+
+namespace Duel6 {
+    namespace {
+        const char magic[4] = {'D', '6', 'L', 'C'};
+
+        Uint32 append(std::vector<Uint8> &image, const void *data, Size length) {
+            // Keep every section 8 byte aligned so it can be used in place
+            Size offset = (image.size() + 7) & ~Size(7);
+            image.resize(offset + length);
+            if (length > 0) {
+                memcpy(&image[offset], data, length);
+            }
+            return Uint32(offset);
+        }
+
+        /**
+         * Streams a level file in one pass, block numbers go straight into the level data and elevators
+         * into the lists stored in the compiled level.
+         */
+        class LevelHandler : public Json::Parser::Handler {
+        private:
+            Int32 &width;
+            Int32 &height;
+            std::string &background;
+            std::vector<Uint16> &levelData;
+            std::vector<CompiledLevel::Elevator> &elevators;
+            std::vector<CompiledLevel::ControlPoint> &controlPoints;
+            std::string property;
+            std::string elevatorProperty;
+            std::string controlPointProperty;
+            Int32 depth;
+
+        public:
+            LevelHandler(Int32 &width, Int32 &height, std::string &background, std::vector<Uint16> &levelData,
+                         std::vector<CompiledLevel::Elevator> &elevators,
+                         std::vector<CompiledLevel::ControlPoint> &controlPoints)
+                    : width(width), height(height), background(background), levelData(levelData),
+                      elevators(elevators), controlPoints(controlPoints), depth(0) {}
+
+            void onBoolean(bool value) override {
+                if (isInElevator() && depth == 3 && elevatorProperty == "circular") {
+                    elevators.back().circular = value ? 1 : 0;
+                }
+            }
+
+            void onNumber(Float64 value) override {
+                if (depth == 1) {
+                    if (property == "width") {
+                        width = Int32(value);
+                    } else if (property == "height") {
+                        height = Int32(value);
+                    }
+                } else if (depth == 2 && property == "blocks") {
+                    levelData.push_back(Uint16(value));
+                } else if (isInControlPoint() && depth == 5) {
+                    CompiledLevel::ControlPoint &controlPoint = controlPoints.back();
+                    if (controlPointProperty == "x") {
+                        controlPoint.x = Int32(value);
+                    } else if (controlPointProperty == "y") {
+                        controlPoint.y = Int32(value);
+                    } else if (controlPointProperty == "wait") {
+                        controlPoint.wait = Int32(value);
+                    }
+                }
+            }
+
+            void onString(const std::string &value) override {
+                if (depth == 1 && property == "background") {
+                    background = value;
+                }
+            }
+
+            void onProperty(const std::string &name) override {
+                if (depth == 1) {
+                    property = name;
+                } else if (depth == 3) {
+                    elevatorProperty = name;
+                } else if (depth == 5) {
+                    controlPointProperty = name;
+                }
+            }
+
+            void onObjectStart() override {
+                depth++;
+                if (depth == 3 && property == "elevators") {
+                    elevators.push_back(CompiledLevel::Elevator{0, Uint32(controlPoints.size()), 0});
+                    elevatorProperty.clear();
+                } else if (depth == 5 && isInElevator() && elevatorProperty == "controlPoints") {
+                    controlPoints.push_back(CompiledLevel::ControlPoint{0, 0, 0});
+                    elevators.back().controlPoints++;
+                    controlPointProperty.clear();
+                }
+            }
+
+            void onObjectEnd() override {
+                depth--;
+            }
+
+            void onArrayStart() override {
+                depth++;
+            }
+
+            void onArrayEnd() override {
+                depth--;
+            }
+
+        private:
+            bool isInElevator() const {
+                return depth >= 3 && property == "elevators" && !elevators.empty();
+            }
+
+            bool isInControlPoint() const {
+                return isInElevator() && elevatorProperty == "controlPoints" && !controlPoints.empty();
+            }
+        };
+    }
+
+    CompiledLevel::CompiledLevel(std::unique_ptr<MappedFile> mapping)
+            : mapping(std::move(mapping)) {
+        data = this->mapping->getData();
+        validate(this->mapping->getSize());
+    }
+
+    CompiledLevel::CompiledLevel(std::vector<Uint8> &&memory)
+            : memory(std::move(memory)) {
+        data = this->memory.data();
+        validate(this->memory.size());
+    }
+
+    void CompiledLevel::validate(Size size) {
+        header = (const Header *) data;
+        if (size < sizeof(Header) || memcmp(header->magic, magic, sizeof(magic)) != 0) {
+            D6_THROW(IoException, "Not a compiled level");
+        }
+        if (header->version != VERSION || header->size != size) {
+            D6_THROW(IoException, "Compiled level has a different version or is truncated");
+        }
+
+        auto fits = [size](Uint32 offset, Size length) {
+            return offset <= size && length <= size - offset;
+        };
+        Size blockCount = Size(header->width) * Size(header->height);
+        bool valid = header->width >= 0 && header->height >= 0 &&
+                     fits(header->backgroundOffset, header->backgroundLength) &&
+                     fits(header->blocksOffset, blockCount * sizeof(Uint16)) &&
+                     fits(header->elevatorsOffset, header->elevatorCount * sizeof(Elevator)) &&
+                     fits(header->controlPointsOffset, header->controlPointCount * sizeof(ControlPoint));
+        for (Size i = 0; i < VARIANTS; i++) {
+            valid = valid && fits(header->wallFacesOffset[i], header->wallFaceCount[i] * sizeof(WallFace));
+        }
+        if (!valid) {
+            D6_THROW(IoException, "Compiled level is corrupted");
+        }
+    }
+
+    std::vector<Uint8> CompiledLevel::compile(const std::string &path, const Source &source,
+                                              const Block::Meta &blockMeta) {
+        Header header = {};
+        memcpy(header.magic, magic, sizeof(magic));
+        header.version = VERSION;
+        header.source = source;
+
+        // Blocks are in file order, top row first
+        std::string background;
+        std::vector<Uint16> blocks;
+        std::vector<Elevator> elevators;
+        std::vector<ControlPoint> controlPoints;
+        header.width = -1;
+        header.height = -1;
+        Json::Parser parser;
+        LevelHandler handler(header.width, header.height, background, blocks, elevators, controlPoints);
+        parser.parse(path, handler);
+
+        if (header.width < 0 || header.height < 0) {
+            D6_THROW(GameException, "Level " + path + " does not specify its dimensions");
+        }
+        blocks.resize(header.width * header.height);
+
+        std::vector<Uint8> image(sizeof(Header));
+        header.backgroundOffset = append(image, background.data(), background.size());
+        header.backgroundLength = Uint32(background.size());
+        header.blocksOffset = append(image, blocks.data(), blocks.size() * sizeof(Uint16));
+        header.elevatorsOffset = append(image, elevators.data(), elevators.size() * sizeof(Elevator));
+        header.elevatorCount = Uint32(elevators.size());
+        header.controlPointsOffset = append(image, controlPoints.data(), controlPoints.size() * sizeof(ControlPoint));
+        header.controlPointCount = Uint32(controlPoints.size());
+
+        for (bool mirror : {false, true}) {
+            std::vector<Uint16> variantBlocks = blocks;
+            if (mirror) {
+                Level::mirror(header.width, header.height, variantBlocks);
+            }
+            for (ScreenMode screenMode : {ScreenMode::FullScreen, ScreenMode::SplitScreen}) {
+                std::vector<WallFace> wallFaces;
+                LevelRenderData::findWallFaces(header.width, header.height, variantBlocks.data(), blockMeta,
+                                               screenMode, wallFaces);
+                Size variant = getVariant(mirror, screenMode);
+                header.wallFacesOffset[variant] = append(image, wallFaces.data(), wallFaces.size() * sizeof(WallFace));
+                header.wallFaceCount[variant] = Uint32(wallFaces.size());
+            }
+        }
+
+        header.size = Uint32(image.size());
+        memcpy(image.data(), &header, sizeof(Header));
+        return image;
+    }
+
+    std::vector<Uint8> CompiledLevel::withSource(const Source &source) const {
+        std::vector<Uint8> image(data, data + header->size);
+        Header changed = *header;
+        changed.source = source;
+        memcpy(image.data(), &changed, sizeof(Header));
+        return image;
+    }
+}
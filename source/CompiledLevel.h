@@ -0,0 +1,159 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_COMPILEDLEVEL_H
+#define DUEL6_COMPILEDLEVEL_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Type.h"
+#include "Block.h"
+#include "ScreenMode.h"
+#include "MappedFile.h"
+#include "LevelRenderData.h"
+
+namespace Duel6 {
+    /**
+     * Level in the binary cache format: block grid, elevators and visible wall faces for every
+     * combination of mirroring and screen mode. The image is used in place, typically straight
+     * from a memory mapped cache file, so nothing has to be parsed when a round starts.
+     */
+    class CompiledLevel {
+    public:
+        struct Source {
+            Uint64 size;
+            Int64 modificationTime;
+            Uint64 hash;
+            Uint64 blockMetaHash;
+        };
+
+        struct ControlPoint {
+            Int32 x;
+            Int32 y;
+            Int32 wait;
+        };
+
+        struct Elevator {
+            Uint32 circular;
+            Uint32 firstControlPoint;
+            Uint32 controlPoints;
+        };
+
+        typedef LevelRenderData::WallFace WallFace;
+
+        static const Uint32 VERSION = 1;
+
+    private:
+        static const Size VARIANTS = 4;
+
+        struct Header {
+            char magic[4];
+            Uint32 version;
+            Uint32 size;
+            Int32 width;
+            Int32 height;
+            Source source;
+            Uint32 backgroundOffset;
+            Uint32 backgroundLength;
+            Uint32 blocksOffset;
+            Uint32 elevatorsOffset;
+            Uint32 elevatorCount;
+            Uint32 controlPointsOffset;
+            Uint32 controlPointCount;
+            Uint32 wallFacesOffset[VARIANTS];
+            Uint32 wallFaceCount[VARIANTS];
+        };
+
+    private:
+        std::unique_ptr<MappedFile> mapping;
+        std::vector<Uint8> memory;
+        const Uint8 *data;
+        const Header *header;
+
+    public:
+        explicit CompiledLevel(std::unique_ptr<MappedFile> mapping);
+
+        explicit CompiledLevel(std::vector<Uint8> &&memory);
+
+        const Source &getSource() const {
+            return header->source;
+        }
+
+        Int32 getWidth() const {
+            return header->width;
+        }
+
+        Int32 getHeight() const {
+            return header->height;
+        }
+
+        std::string getBackground() const {
+            return std::string((const char *) data + header->backgroundOffset, header->backgroundLength);
+        }
+
+        /** Blocks in level file order (top row first), not mirrored. */
+        const Uint16 *getBlocks() const {
+            return (const Uint16 *) (data + header->blocksOffset);
+        }
+
+        Size getElevatorCount() const {
+            return header->elevatorCount;
+        }
+
+        const Elevator &getElevator(Size index) const {
+            return ((const Elevator *) (data + header->elevatorsOffset))[index];
+        }
+
+        /** Control points as written in the level file, not mirrored. */
+        const ControlPoint *getControlPoints() const {
+            return (const ControlPoint *) (data + header->controlPointsOffset);
+        }
+
+        const WallFace *getWallFaces(bool mirror, ScreenMode screenMode) const {
+            return (const WallFace *) (data + header->wallFacesOffset[getVariant(mirror, screenMode)]);
+        }
+
+        Size getWallFaceCount(bool mirror, ScreenMode screenMode) const {
+            return header->wallFaceCount[getVariant(mirror, screenMode)];
+        }
+
+        static std::vector<Uint8> compile(const std::string &path, const Source &source, const Block::Meta &blockMeta);
+
+        /** Copy of the image with another source description, the level itself stays the same. */
+        std::vector<Uint8> withSource(const Source &source) const;
+
+    private:
+        void validate(Size size);
+
+        static Size getVariant(bool mirror, ScreenMode screenMode) {
+            return (mirror ? 2 : 0) + (screenMode == ScreenMode::SplitScreen ? 1 : 0);
+        }
+    };
+}
+
+#endif
@@ -35,6 +35,28 @@
 #include "EnumClassHash.h"
 
 namespace Duel6 {
+    namespace {
+        std::string formatMilliseconds(Float64 milliseconds) {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%g", milliseconds);
+            return buffer;
+        }
+
+        void printHistogram(Console &console, const std::string &name, const TimeHistogram &histogram) {
+            console.printLine(Format("{0}: {1}, avg {2} ms, max {3} ms") << name << histogram.getCount()
+                                      << Profiler::formatTime(histogram.getAverage())
+                                      << Profiler::formatTime(histogram.getMax()));
+            Float64 lowerBound = 0;
+            for (Size i = 0; i < TimeHistogram::BUCKETS; i++) {
+                Float64 upperBound = TimeHistogram::getUpperBound(i);
+                std::string range = formatMilliseconds(lowerBound) + " - " +
+                                    (i + 1 < TimeHistogram::BUCKETS ? formatMilliseconds(upperBound) : "...");
+                console.printLine(Format("   {0,-14}{1,8}") << range << histogram.getCount(i));
+                lowerBound = upperBound;
+            }
+        }
+    }
+
     void ConsoleCommands::maxRounds(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
         if (args.length() == 2) {
             gameSettings.setMaxRounds(std::stoi(args.get(1)));
@@ -51,6 +73,45 @@ namespace Duel6 {
         }
     }
 
+    void ConsoleCommands::mergeWalls(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
+        if (args.length() == 2 && (args.get(1) == "on" || args.get(1) == "off")) {
+            gameSettings.setMergeWalls(args.get(1) == "on");
+            console.printLine("Wall merging takes effect from the next round");
+        } else {
+            console.printLine(Format("Merge walls [on/off]: {0}") << (gameSettings.isMergeWalls() ? "on" : "off"));
+        }
+    }
+
+    void ConsoleCommands::threadedUpdate(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
+        if (args.length() == 2 && (args.get(1) == "on" || args.get(1) == "off")) {
+            gameSettings.setThreadedUpdate(args.get(1) == "on");
+        } else {
+            console.printLine(Format("Threaded update [on/off]: {0}")
+                                      << (gameSettings.isThreadedUpdate() ? "on" : "off"));
+        }
+    }
+
+    void ConsoleCommands::seed(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
+        if (args.length() == 2 && args.get(1) == "random") {
+            gameSettings.setSeed(0);
+        } else if (args.length() == 2) {
+            gameSettings.setSeed(Uint32(std::stoul(args.get(1))));
+        } else {
+            std::string seed = gameSettings.getSeed() != 0 ? std::to_string(gameSettings.getSeed()) : "random";
+            console.printLine(Format("Seed [number/random]: {0}") << seed);
+        }
+    }
+
+    void ConsoleCommands::record(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
+        if (args.length() == 2) {
+            gameSettings.setRecordPath(args.get(1) == "off" ? "" : args.get(1));
+            console.printLine("Recording takes effect from the next game");
+        } else {
+            std::string path = gameSettings.getRecordPath().empty() ? "off" : gameSettings.getRecordPath();
+            console.printLine(Format("Record [file/off]: {0}") << path);
+        }
+    }
+
     void
     ConsoleCommands::levelSelectionMode(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
         if (args.length() == 2 && (args.get(1) == "random" || args.get(1) == "shuffle")) {
@@ -236,16 +297,118 @@ namespace Duel6 {
         console.printLine("");
     }
 
-    void ConsoleCommands::vsync(Console &console, const Console::Arguments &args) {
-        if (args.length() == 1) {
-            bool enabled = (SDL_GL_GetSwapInterval() == 1);
-            console.printLine(Format("Vertical synchronization: {0}") << (enabled ? "on" : "off"));
-        } else if (args.length() == 2) {
-            bool enable = (args.get(1) == "on");
-            SDL_GL_SetSwapInterval(enable ? 1 : 0);
+    void ConsoleCommands::vsync(Console &console, const Console::Arguments &args, Video &video) {
+        static const char *names[] = {"off", "on", "adaptive"};
+        if (args.length() == 2 && (args.get(1) == "on" || args.get(1) == "off" || args.get(1) == "adaptive")) {
+            Video::Vsync vsync = Video::Vsync::Off;
+            if (args.get(1) == "on") {
+                vsync = Video::Vsync::On;
+            } else if (args.get(1) == "adaptive") {
+                vsync = Video::Vsync::Adaptive;
+            }
+            if (video.setVsync(vsync) != vsync) {
+                console.printLine(Format("Vertical synchronization: {0} is not supported, using {1}")
+                                          << args.get(1) << names[Size(video.getVsync())]);
+            }
+        } else {
+            console.printLine(Format("Vertical synchronization [on/off/adaptive]: {0}")
+                                      << names[Size(video.getVsync())]);
         }
     }
 
+    void ConsoleCommands::fpsLimit(Console &console, const Console::Arguments &args, GameSettings &gameSettings) {
+        if (args.length() == 2) {
+            gameSettings.setMaxFps(std::max(0, std::stoi(args.get(1))));
+        } else if (args.length() == 3 && args.get(1) == "menu") {
+            gameSettings.setMenuMaxFps(std::max(0, std::stoi(args.get(2))));
+        } else {
+            console.printLine(Format("Frame rate limit [fps/menu fps, 0 for none]: {0}, menu: {1}")
+                                      << gameSettings.getMaxFps() << gameSettings.getMenuMaxFps());
+        }
+    }
+
+    void ConsoleCommands::frameTiming(Console &console, const Console::Arguments &args, FramePacer &framePacer) {
+        if (args.length() == 2 && args.get(1) == "reset") {
+            framePacer.reset();
+            return;
+        }
+
+        FramePacer::Stats stats = framePacer.getStats();
+        console.printLine(Format("Frame timing of the last {0} frames [reset]:") << framePacer.getFrameCount());
+        console.printLine(Format("   {0,-8}{1,8}{2,8}{3,8}{4,8}") << "ms" << "p50" << "p95" << "p99" << "max");
+        console.printLine(Format("   {0,-8}{1,8}{2,8}{3,8}{4,8}") << "cpu" << Profiler::formatTime(stats.p50.cpu)
+                                                                 << Profiler::formatTime(stats.p95.cpu)
+                                                                 << Profiler::formatTime(stats.p99.cpu)
+                                                                 << Profiler::formatTime(stats.max.cpu));
+        console.printLine(Format("   {0,-8}{1,8}{2,8}{3,8}{4,8}") << "present"
+                                                                 << Profiler::formatTime(stats.p50.present)
+                                                                 << Profiler::formatTime(stats.p95.present)
+                                                                 << Profiler::formatTime(stats.p99.present)
+                                                                 << Profiler::formatTime(stats.max.present));
+    }
+
+    void ConsoleCommands::profile(Console &console, const Console::Arguments &args, Profiler &profiler,
+                                  GameSettings &gameSettings) {
+        if (args.length() == 2 && (args.get(1) == "on" || args.get(1) == "off")) {
+            profiler.enable(args.get(1) == "on");
+            console.printLine(Format("Profiler: {0}") << args.get(1));
+        } else if (args.length() == 2 && args.get(1) == "overlay") {
+            gameSettings.setShowProfiler(!gameSettings.isShowProfiler());
+            if (gameSettings.isShowProfiler()) {
+                profiler.enable(true);
+            }
+            console.printLine(Format("Profiler overlay: {0}") << (gameSettings.isShowProfiler() ? "on" : "off"));
+        } else if (args.length() == 3 && args.get(1) == "dump") {
+            const std::string &path = args.get(2);
+            bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+            if (json) {
+                profiler.writeJson(path);
+            } else {
+                profiler.writeCsv(path);
+            }
+            console.printLine(Format("Profiler trace written to {0}") << path);
+        } else if (args.length() == 2 && args.get(1) == "frames") {
+            printHistogram(console, "Frames", profiler.getFrameTimes());
+            printHistogram(console, "Ticks", profiler.getTickTimes());
+        } else if (args.length() == 3 && args.get(1) == "frames" && args.get(2) == "reset") {
+            profiler.getFrameTimes().reset();
+            profiler.getTickTimes().reset();
+        } else if (args.length() == 1) {
+            console.printLine(Format("Profiler [on/off/overlay/dump file/frames]: {0}, ticks: {1}")
+                                      << (profiler.isEnabled() ? "on" : "off") << profiler.getTicks());
+            console.printLine(Format("   {0,-12}{1,8}{2,8}{3,8}") << "us" << "min" << "avg" << "p99");
+            for (Size i = 0; i < Profiler::SECTIONS; i++) {
+                Profiler::Section section = Profiler::Section(i);
+                Profiler::Stats stats = profiler.getStats(section);
+                console.printLine(Format("   {0,-12}{1,8}{2,8}{3,8}") << Profiler::getName(section)
+                                                                     << Profiler::formatTime(stats.min)
+                                                                     << Profiler::formatTime(stats.avg)
+                                                                     << Profiler::formatTime(stats.p99));
+            }
+        } else {
+            console.printLine(Format("{0}: {0} [on|off|overlay|dump file.csv|file.json|frames [reset]]")
+                                      << args.get(0));
+        }
+    }
+
+    void ConsoleCommands::uploads(Console &console, const Console::Arguments &args, Renderer &renderer) {
+        // Rate is measured between two consecutive invocations of the command
+        static Uint64 lastBytes = 0;
+        static Uint64 lastCounter = 0;
+
+        Uint64 bytes = renderer.getUploadedBytes();
+        Uint64 counter = SDL_GetPerformanceCounter();
+        if (lastCounter != 0 && counter > lastCounter) {
+            Float64 seconds = Float64(counter - lastCounter) / SDL_GetPerformanceFrequency();
+            console.printLine(Format("Face buffer uploads: {0} B/s over the last {1} ms")
+                                      << Int64((bytes - lastBytes) / seconds) << Int64(seconds * 1000));
+        }
+        console.printLine(Format("Face buffer uploads: {0} B total") << bytes);
+
+        lastBytes = bytes;
+        lastCounter = counter;
+    }
+
     void ConsoleCommands::registerCommands(Console &console, AppService &appService, Menu &menu,
                                            GameSettings &gameSettings) {
         // Set some console functions
@@ -262,7 +425,15 @@ namespace Duel6 {
         console.registerCommand("gl_extensions", [&appService](Console &con, const Console::Arguments &args) {
             openGLExtensions(con, args, appService.getVideo().getRenderer());
         });
-        console.registerCommand("vsync", vsync);
+        console.registerCommand("vsync", [&appService](Console &con, const Console::Arguments &args) {
+            vsync(con, args, appService.getVideo());
+        });
+        console.registerCommand("fps_limit", [&gameSettings](Console &con, const Console::Arguments &args) {
+            fpsLimit(con, args, gameSettings);
+        });
+        console.registerCommand("frame_timing", [&appService](Console &con, const Console::Arguments &args) {
+            frameTiming(con, args, appService.getVideo().getFramePacer());
+        });
         console.registerCommand("volume", [&appService](Console &con, const Console::Arguments &args) {
             volume(con, args, appService.getSound());
         });
@@ -272,6 +443,18 @@ namespace Duel6 {
         console.registerCommand("ghosts", [&gameSettings](Console &con, const Console::Arguments &args) {
             ghostMode(con, args, gameSettings);
         });
+        console.registerCommand("merge_walls", [&gameSettings](Console &con, const Console::Arguments &args) {
+            mergeWalls(con, args, gameSettings);
+        });
+        console.registerCommand("threaded_update", [&gameSettings](Console &con, const Console::Arguments &args) {
+            threadedUpdate(con, args, gameSettings);
+        });
+        console.registerCommand("seed", [&gameSettings](Console &con, const Console::Arguments &args) {
+            seed(con, args, gameSettings);
+        });
+        console.registerCommand("record", [&gameSettings](Console &con, const Console::Arguments &args) {
+            record(con, args, gameSettings);
+        });
         console.registerCommand("level_selection_mode", [&gameSettings](Console &con, const Console::Arguments &args) {
             levelSelectionMode(con, args, gameSettings);
         });
@@ -293,5 +476,11 @@ namespace Duel6 {
         console.registerCommand("start_ammo_range", [&gameSettings](Console &con, const Console::Arguments &args) {
             ammoRange(con, args, gameSettings);
         });
+        console.registerCommand("profile", [&appService, &gameSettings](Console &con, const Console::Arguments &args) {
+            profile(con, args, appService.getProfiler(), gameSettings);
+        });
+        console.registerCommand("uploads", [&appService](Console &con, const Console::Arguments &args) {
+            uploads(con, args, appService.getVideo().getRenderer());
+        });
     }
 }
\ No newline at end of file
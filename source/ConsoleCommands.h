@@ -58,14 +58,31 @@ namespace Duel6 {
 
         static void openGLExtensions(Console &console, const Console::Arguments &args, Renderer &renderer);
 
-        static void vsync(Console &console, const Console::Arguments &args);
+        static void vsync(Console &console, const Console::Arguments &args, Video &video);
+
+        static void fpsLimit(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
+
+        static void frameTiming(Console &console, const Console::Arguments &args, FramePacer &framePacer);
 
         static void ghostMode(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
 
+        static void mergeWalls(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
+
+        static void threadedUpdate(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
+
+        static void seed(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
+
+        static void record(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
+
         static void levelSelectionMode(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
 
         static void shotCollision(Console &console, const Console::Arguments &args, GameSettings &gameSettings);
 
+        static void profile(Console &console, const Console::Arguments &args, Profiler &profiler,
+                            GameSettings &gameSettings);
+
+        static void uploads(Console &console, const Console::Arguments &args, Renderer &renderer);
+
     public:
         static void registerCommands(Console &console, AppService &appService, Menu &menu, GameSettings &gameSettings);
     };
@@ -74,7 +74,19 @@ namespace Duel6 {
 
         virtual void update(Float32 elapsedTime) = 0;
 
-        virtual void render() const = 0;
+        /**
+         * Called under the world lock right before the frame is drawn outside of it, picks what the frame shows.
+         */
+        virtual void beforeRender() {}
+
+        virtual void render() = 0;
+
+        /**
+         * Whether the next update may run on the simulation thread, which must not use the renderer.
+         */
+        virtual bool canUpdateConcurrently() const {
+            return false;
+        }
 
         virtual bool isClosed() const final {
             return closed;
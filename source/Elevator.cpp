@@ -28,6 +28,7 @@
 #include "Elevator.h"
 #include "math/Math.h"
 #include "Video.h"
+#include "BinaryStream.h"
 
 #define D6_ELEV_SPEED 1.83f
 
@@ -37,6 +38,7 @@ namespace Duel6 {
 
     void Elevator::start() {
         position = controlPoints[0].getLocation();
+        previousPosition = position;
         section = 0;
         forward = true;
         remainingWait = 0;
@@ -68,8 +70,8 @@ namespace Duel6 {
         travelled += elapsedTime;
     }
 
-    void Elevator::render(Renderer &renderer, Texture texture) const {
-        Float32 X = position.x, Y = position.y - 0.3f;
+    void Elevator::render(Renderer &renderer, Texture texture, const Vector &drawPosition) {
+        Float32 X = drawPosition.x, Y = drawPosition.y - 0.3f;
         Material material = Material::makeTexture(texture);
 
         // Front
@@ -123,4 +125,25 @@ namespace Duel6 {
         velocity = dir / distance;
         remainingWait = startPoint.getWait() / 1000.0f;
     }
+
+    void Elevator::saveState(BinaryWriter &writer) const {
+        writer.write(Uint32(section));
+        writer.write(remainingWait);
+        writer.write(forward);
+        writer.write(distance);
+        writer.write(travelled);
+        writer.write(position);
+        writer.write(velocity);
+    }
+
+    void Elevator::restoreState(BinaryReader &reader) {
+        section = reader.read<Uint32>();
+        reader.read(remainingWait);
+        reader.read(forward);
+        reader.read(distance);
+        reader.read(travelled);
+        reader.read(position);
+        reader.read(velocity);
+        previousPosition = position;
+    }
 }
@@ -35,6 +35,10 @@
 #include "renderer/Renderer.h"
 
 namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class Elevator {
     public:
         class ControlPoint {
@@ -64,6 +68,7 @@ namespace Duel6 {
         Float32 distance;
         Float32 travelled;
         Vector position;
+        Vector previousPosition; // After the previous update, for interpolation
         Vector velocity;
 
     public:
@@ -78,16 +83,32 @@ namespace Duel6 {
 
         void update(Float32 elapsedTime);
 
-        void render(Renderer &renderer, Texture texture) const;
+        // Elevators look all the same, they are drawn from the render state of the world
+        static void render(Renderer &renderer, Texture texture, const Vector &drawPosition);
 
         const Vector &getPosition() const {
             return position;
         }
 
+        /**
+         * Position between the last two updates, see Video::getInterpolation.
+         */
+        Vector getPosition(Float32 interpolation) const {
+            return previousPosition + (position - previousPosition) * interpolation;
+        }
+
+        void storePreviousPosition() {
+            previousPosition = position;
+        }
+
         const Vector &getVelocity() const {
             return remainingWait > 0 ? Vector::ZERO : velocity;
         }
 
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
+
     private:
         void nextSection();
 
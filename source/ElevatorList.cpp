@@ -27,35 +27,28 @@
 
 #include "Player.h"
 #include "ElevatorList.h"
-#include "json/JsonParser.h"
+#include "CompiledLevel.h"
+#include "RenderState.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    ElevatorList::ElevatorList(Texture texture)
-            : texture(texture) {}
-
     void ElevatorList::add(Elevator &elevator) {
         elevators.push_back(elevator);
         elevators.back().start();
     }
 
-    void ElevatorList::load(const std::string &path, bool mirror) {
-        Json::Parser parser;
-        Json::Value root = parser.parse(path);
-
-        Int32 width = root.get("width").asInt();
-        Int32 height = root.get("height").asInt();
+    void ElevatorList::load(const CompiledLevel &compiledLevel, bool mirror) {
+        Int32 width = compiledLevel.getWidth();
+        Int32 height = compiledLevel.getHeight();
+        const CompiledLevel::ControlPoint *controlPoints = compiledLevel.getControlPoints();
 
-        Size elevators = root.get("elevators").getLength();
-        for (Size i = 0; i < elevators; i++) {
-            Json::Value definition = root.get("elevators").get(i);
-            bool circular = definition.getOrDefault("circular", Json::Value::makeBoolean(false)).asBoolean();
-            Elevator elevator(circular);
-            Json::Value points = definition.get("controlPoints");
-            for (Size j = 0; j < points.getLength(); j++) {
-                Int32 x = points.get(j).get("x").asInt();
-                Int32 y = points.get(j).get("y").asInt();
-                Int32 wait = points.get(j).getOrDefault("wait", Json::Value::makeNumber(0)).asInt();
-                elevator.addControlPoint(Elevator::ControlPoint(mirror ? width - 1 - x : x, height - y, wait));
+        for (Size i = 0; i < compiledLevel.getElevatorCount(); i++) {
+            const CompiledLevel::Elevator &definition = compiledLevel.getElevator(i);
+            Elevator elevator(definition.circular != 0);
+            for (Size j = 0; j < definition.controlPoints; j++) {
+                const CompiledLevel::ControlPoint &point = controlPoints[definition.firstControlPoint + j];
+                Int32 x = point.x;
+                elevator.addControlPoint(Elevator::ControlPoint(mirror ? width - 1 - x : x, height - point.y, point.wait));
             }
             add(elevator);
         }
@@ -67,9 +60,17 @@ namespace Duel6 {
         }
     }
 
-    void ElevatorList::render(Renderer &renderer) const {
-        for (const Elevator &elevator : elevators) {
-            elevator.render(renderer, texture);
+    void ElevatorList::storePreviousPositions() {
+        for (Elevator &elevator : elevators) {
+            elevator.storePreviousPosition();
+        }
+    }
+
+    void ElevatorList::captureRenderState(RenderState &state) const {
+        state.elevators.resize(elevators.size());
+        for (Size i = 0; i < elevators.size(); i++) {
+            state.elevators[i].previousPosition = elevators[i].getPosition(0.0f);
+            state.elevators[i].position = elevators[i].getPosition();
         }
     }
 
@@ -111,4 +112,16 @@ namespace Duel6 {
         }
         return nullptr;
     }
+
+    void ElevatorList::saveState(BinaryWriter &writer) const {
+        for (const Elevator &elevator : elevators) {
+            elevator.saveState(writer);
+        }
+    }
+
+    void ElevatorList::restoreState(BinaryReader &reader) {
+        for (Elevator &elevator : elevators) {
+            elevator.restoreState(reader);
+        }
+    }
 }
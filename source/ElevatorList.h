@@ -31,29 +31,42 @@
 #include <vector>
 #include "Type.h"
 #include "Elevator.h"
-#include "TextureManager.h"
 #include "collision/WorldCollision.h"
 namespace Duel6 {
     class Player; // Forward declaration
     class CollidingEntity; // Forward declaration
+    class CompiledLevel; // Forward declaration
+    class RenderState; // Forward declaration
 
     class ElevatorList {
     private:
-        Texture texture;
         std::vector<Elevator> elevators;
 
     public:
-        ElevatorList(Texture texture);
-
-        void load(const std::string &path, bool mirror);
+        void load(const CompiledLevel &compiledLevel, bool mirror);
 
         void add(Elevator &elevator);
 
         void update(Float32 elapsedTime);
 
-        void render(Renderer &renderer) const;
+        void storePreviousPositions();
+
+        void captureRenderState(RenderState &state) const;
 
         const Elevator *checkCollider(CollidingEntity & collider, Float32 speedFactor);
+
+        // Index of the elevator in the list or -1 for none, stable for the whole round
+        Int32 indexOf(const Elevator *elevator) const {
+            return elevator != nullptr ? Int32(elevator - elevators.data()) : -1;
+        }
+
+        const Elevator *get(Int32 index) const {
+            return index >= 0 ? &elevators[index] : nullptr;
+        }
+
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
     };
 }
 
@@ -26,10 +26,12 @@
 */
 
 #include "Explosion.h"
+#include "RenderState.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    ExplosionList::ExplosionList(const GameResources &resources, Float32 speed)
-            : textures(resources.getExplosionTextures()), speed(speed) {
+    ExplosionList::ExplosionList(Float32 speed)
+            : speed(speed) {
     }
 
     void ExplosionList::update(Float32 elapsedTime) {
@@ -44,18 +46,8 @@ namespace Duel6 {
         }
     }
 
-    void ExplosionList::render(Renderer &renderer) const {
-        renderer.enableDepthTest(false);
-
-        for (const Explosion &explosion : explosions) {
-            Material material = Material::makeMaskedColoredTexture(textures, explosion.color);
-            Vector position = explosion.centre - Vector(explosion.now, explosion.now);
-            position.z = 0.6f;
-            Vector size = Vector(2 * explosion.now, 2 * explosion.now);
-            renderer.quadXY(position, size, Vector::ZERO, Vector(1, 1), material);
-        }
-
-        renderer.enableDepthTest(true);
+    void ExplosionList::captureRenderState(RenderState &state) const {
+        state.explosions.assign(explosions.begin(), explosions.end());
     }
 
     void ExplosionList::add(const Vector &centre, Float32 startSize, Float32 maxSize, const Color &color) {
@@ -66,4 +58,18 @@ namespace Duel6 {
         explosion.color = color;
         explosions.push_back(explosion);
     }
+
+    void ExplosionList::saveState(BinaryWriter &writer) const {
+        writer.write(Uint32(explosions.size()));
+        for (const Explosion &explosion : explosions) {
+            writer.write(explosion);
+        }
+    }
+
+    void ExplosionList::restoreState(BinaryReader &reader) {
+        explosions.resize(reader.read<Uint32>());
+        for (Explosion &explosion : explosions) {
+            reader.read(explosion);
+        }
+    }
 }
\ No newline at end of file
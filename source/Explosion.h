@@ -31,11 +31,15 @@
 #include <list>
 #include "Type.h"
 #include "Color.h"
-#include "TextureManager.h"
 #include "math/Vector.h"
-#include "GameResources.h"
 
 namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
+    class RenderState;
+
     struct Explosion {
         Vector centre;
         Float32 now;
@@ -45,18 +49,21 @@ namespace Duel6 {
 
     class ExplosionList {
     private:
-        Texture textures;
         std::list<Explosion> explosions;
         Float32 speed;
 
     public:
-        ExplosionList(const GameResources &resources, Float32 speed);
+        explicit ExplosionList(Float32 speed);
 
         void update(Float32 elapsedTime);
 
-        void render(Renderer &renderer) const;
+        void captureRenderState(RenderState &state) const;
 
         void add(const Vector &centre, Float32 startSize, Float32 maxSize, const Color &color);
+
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
     };
 }
 
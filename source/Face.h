@@ -51,6 +51,12 @@ namespace Duel6 {
             return hidden ? 0 : block->getTextures()[currentAnimationFrame];
         }
 
+        /** Sets animation frame, wrapped to the number of frames of the block. */
+        Face &setAnimationFrame(Size frame) {
+            currentAnimationFrame = frame % block->getAnimationFrames();
+            return *this;
+        }
+
         /** Next animation frame. */
         Face &nextFrame() {
             if (++currentAnimationFrame >= block->getAnimationFrames()) {
@@ -25,6 +25,7 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
 #include "FaceList.h"
 #include "Video.h"
 
@@ -33,6 +34,12 @@ namespace Duel6 {
     }
 
     void FaceList::build(Renderer &renderer) {
+        animatedRanges.clear();
+        findAnimatedRanges(0, faces.size(), animatedRanges);
+        pendingBuild = nullptr;
+        pendingReplace = NO_FACE;
+        pendingOverwrites.clear();
+        pendingAnimation = false;
         if (!faces.empty()) {
             buffer = renderer.makeBuffer(*this);
         } else {
@@ -40,23 +47,142 @@ namespace Duel6 {
         }
     }
 
+    void FaceList::replace(Size first, Size count, const FaceList &faceList, Renderer &renderer) {
+        faces.erase(faces.begin() + first, faces.begin() + first + count);
+        faces.insert(faces.begin() + first, faceList.faces.begin(), faceList.faces.end());
+        vertexes.erase(vertexes.begin() + first * 4, vertexes.begin() + (first + count) * 4);
+        vertexes.insert(vertexes.begin() + first * 4, faceList.vertexes.begin(), faceList.vertexes.end());
+
+        for (Size i = first; i < first + faceList.faces.size(); i++) {
+            faces[i].setAnimationFrame(animationFrame);
+        }
+        updateAnimatedRanges(first, count, faceList.faces.size());
+
+        if (buffer && !faces.empty()) {
+            pendingReplace = std::min(pendingReplace, first);
+        } else {
+            pendingBuild = &renderer;
+        }
+    }
+
+    void FaceList::overwrite(Size first, const FaceList &faceList, Renderer &renderer) {
+        std::copy(faceList.faces.begin(), faceList.faces.end(), faces.begin() + first);
+        std::copy(faceList.vertexes.begin(), faceList.vertexes.end(), vertexes.begin() + first * 4);
+
+        for (Size i = first; i < first + faceList.faces.size(); i++) {
+            faces[i].setAnimationFrame(animationFrame);
+        }
+        updateAnimatedRanges(first, faceList.faces.size(), faceList.faces.size());
+
+        if (buffer) {
+            pendingOverwrites.push_back({first, faceList.faces.size()});
+        } else {
+            pendingBuild = &renderer;
+        }
+    }
+
     void FaceList::render(Texture texture, bool masked) const {
+        uploadPending();
         if (faces.empty()) {
             return;
         }
 
         Material material(texture, Color::WHITE, masked);
-        buffer->render(material);
+        buffer->render(material, 0, faces.size());
     }
 
-    void FaceList::nextFrame() {
+    void FaceList::render(Texture texture, bool masked, const std::vector<Range> &ranges) const {
+        uploadPending();
         if (faces.empty()) {
             return;
         }
 
-        for (Face &face : faces) {
-            face.nextFrame();
+        Material material(texture, Color::WHITE, masked);
+        for (const Range &range : ranges) {
+            buffer->render(material, range.first, range.count);
         }
-        buffer->update(*this);
+    }
+
+    void FaceList::nextFrame() {
+        animationFrame++;
+        if (animatedRanges.empty()) {
+            return;
+        }
+
+        for (const Range &range : animatedRanges) {
+            for (Size i = range.first; i < range.first + range.count; i++) {
+                faces[i].nextFrame();
+            }
+        }
+        pendingAnimation = true;
+    }
+
+    void FaceList::uploadPending() const {
+        if (pendingBuild != nullptr) {
+            buffer = faces.empty() ? nullptr : pendingBuild->makeBuffer(*this);
+            pendingBuild = nullptr;
+        } else if (buffer) {
+            if (pendingReplace != NO_FACE) {
+                buffer->replace(*this, pendingReplace);
+            }
+            // Faces from the replaced one on have been uploaded already
+            for (const Range &range : pendingOverwrites) {
+                if (range.first < pendingReplace) {
+                    buffer->overwrite(*this, range.first, std::min(range.count, pendingReplace - range.first));
+                }
+            }
+            if (pendingAnimation) {
+                buffer->update(*this);
+            }
+        }
+        pendingReplace = NO_FACE;
+        pendingOverwrites.clear();
+        pendingAnimation = false;
+    }
+
+    void FaceList::findAnimatedRanges(Size first, Size last, std::vector<Range> &ranges) const {
+        Size begin = ranges.size();
+        for (Size i = first; i < last; i++) {
+            if (faces[i].getBlock().getAnimationFrames() <= 1) {
+                continue;
+            }
+
+            if (ranges.size() > begin) {
+                Range &lastRange = ranges.back();
+                if (i - (lastRange.first + lastRange.count) <= MAX_RANGE_GAP) {
+                    lastRange.count = i + 1 - lastRange.first;
+                    continue;
+                }
+            }
+            ranges.push_back({i, 1});
+        }
+    }
+
+    void FaceList::updateAnimatedRanges(Size first, Size removed, Size added) {
+        // Ranges close enough to the changed faces to merge with them are found again, so the result is the same
+        // as scanning the whole list. The ones behind only move with the faces.
+        auto begin = std::find_if(animatedRanges.begin(), animatedRanges.end(), [first](const Range &range) {
+            return range.first + range.count + MAX_RANGE_GAP >= first;
+        });
+        auto end = std::find_if(begin, animatedRanges.end(), [first, removed](const Range &range) {
+            return range.first > first + removed + MAX_RANGE_GAP;
+        });
+
+        Size scanFirst = first;
+        Size scanLast = first + removed;
+        if (begin != end) {
+            scanFirst = std::min(scanFirst, begin->first);
+            scanLast = std::max(scanLast, (end - 1)->first + (end - 1)->count);
+        }
+        scanLast = scanLast - removed + added;
+
+        for (auto range = end; range != animatedRanges.end(); ++range) {
+            range->first = range->first - removed + added;
+        }
+
+        std::vector<Range> ranges;
+        findAnimatedRanges(scanFirst, scanLast, ranges);
+        auto position = animatedRanges.erase(begin, end);
+        animatedRanges.insert(position, ranges.begin(), ranges.end());
     }
 }
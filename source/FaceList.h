@@ -36,19 +36,42 @@
 
 namespace Duel6 {
     class FaceList {
+    public:
+        /** Run of consecutive faces that contains animated ones. */
+        struct Range {
+            Size first;
+            Size count;
+        };
+
     private:
+        // Static faces separated by at most this many faces are merged into one animated range
+        // so that a list with scattered animations does not end up with one upload per face.
+        static constexpr Size MAX_RANGE_GAP = 16;
+        static constexpr Size NO_FACE = Size(-1);
+
         std::vector<Vertex> vertexes;
         std::vector<Face> faces;
-        std::unique_ptr<RendererBuffer> buffer;
+        std::vector<Range> animatedRanges;
+        Size animationFrame;
+        mutable std::unique_ptr<RendererBuffer> buffer;
+
+        // Changes are uploaded to the buffer when the list is rendered next, so updates never touch the renderer
+        mutable Renderer *pendingBuild;
+        mutable Size pendingReplace; // First face of the replaced tail
+        mutable std::vector<Range> pendingOverwrites;
+        mutable bool pendingAnimation;
 
     public:
-        FaceList() {}
+        FaceList()
+                : animationFrame(0), pendingBuild(nullptr), pendingReplace(NO_FACE), pendingAnimation(false) {}
 
         ~FaceList();
 
         FaceList &clear() {
             vertexes.clear();
             faces.clear();
+            animatedRanges.clear();
+            animationFrame = 0;
             return *this;
         }
 
@@ -78,11 +101,42 @@ namespace Duel6 {
             return faces;
         }
 
+        /** Ranges of faces that change on nextFrame(), valid after build(). */
+        const std::vector<Range> &getAnimatedRanges() const {
+            return animatedRanges;
+        }
+
         void build(Renderer &renderer);
 
+        /**
+         * Replaces faces [first, first + count) with faces of another list, the renderer buffer is updated in place
+         * before the next render. New faces continue the animation of the list instead of starting over.
+         */
+        void replace(Size first, Size count, const FaceList &faceList, Renderer &renderer);
+
+        /**
+         * Overwrites faces [first, first + faceList size) with faces of another list. The list keeps its size,
+         * so only the overwritten run is uploaded to the renderer buffer before the next render.
+         */
+        void overwrite(Size first, const FaceList &faceList, Renderer &renderer);
+
         void render(Texture texture, bool masked) const;
 
+        /**
+         * Draws only the given runs of faces, one draw call per run.
+         */
+        void render(Texture texture, bool masked, const std::vector<Range> &ranges) const;
+
         void nextFrame();
+
+    private:
+        // Appends the animated ranges of faces [first, last)
+        void findAnimatedRanges(Size first, Size last, std::vector<Range> &ranges) const;
+
+        // Faces [first, first + removed) were replaced by [first, first + added), only ranges near them are redone
+        void updateAnimatedRanges(Size first, Size removed, Size added);
+
+        void uploadPending() const;
     };
 }
 
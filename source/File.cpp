@@ -25,7 +25,12 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <errno.h>
 #include <string.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
 #include "msdir.h"
 #include "IoException.h"
 #include "File.h"
@@ -148,6 +153,39 @@ namespace Duel6 {
         file.close();
     }
 
+    Int64 File::getModificationTime(const std::string &path) {
+        struct stat fileStat;
+        if (stat(path.c_str(), &fileStat) != 0) {
+            return 0;
+        }
+        return Int64(fileStat.st_mtime);
+    }
+
+    void File::createDirectory(const std::string &path) {
+#ifdef _WIN32
+        int result = _mkdir(path.c_str());
+#else
+        int result = mkdir(path.c_str(), 0755);
+#endif
+        if (result != 0 && errno != EEXIST) {
+            D6_THROW(IoException, "Unable to create directory: " + path);
+        }
+    }
+
+    Uint64 File::hash(const std::string &path) {
+        std::vector<Uint8> data = load(path);
+        return hash(data.data(), data.size());
+    }
+
+    Uint64 File::hash(const void *data, Size length, Uint64 seed) {
+        const Uint8 *bytes = static_cast<const Uint8 *>(data);
+        Uint64 hash = seed;
+        for (Size i = 0; i < length; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
     std::vector<Uint8> File::load(const std::string &path, long offset) {
         Size length = getSize(path) - offset;
         std::vector<Uint8> data(length);
@@ -36,6 +36,8 @@
 namespace Duel6 {
     class File {
     public:
+        static constexpr Uint64 HASH_SEED = 14695981039346656037ULL;
+
         enum class Seek {
             Set,
             Cur,
@@ -79,6 +81,26 @@ namespace Duel6 {
 
         static bool exists(const std::string &path);
 
+        /**
+         * @return last modification time of the file in seconds, 0 if it cannot be determined
+         */
+        static Int64 getModificationTime(const std::string &path);
+
+        /**
+         * Creates a directory unless it already exists.
+         */
+        static void createDirectory(const std::string &path);
+
+        /**
+         * @return FNV-1a hash of the file content
+         */
+        static Uint64 hash(const std::string &path);
+
+        /**
+         * @return FNV-1a hash of a memory block, hashes can be chained through the seed
+         */
+        static Uint64 hash(const void *data, Size length, Uint64 seed = HASH_SEED);
+
         static void load(const std::string &path, void *ptr, long offset = 0);
 
         static std::vector<Uint8> load(const std::string &path, long offset = 0);
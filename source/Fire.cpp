@@ -27,6 +27,7 @@
 
 #include "math/Math.h"
 #include "Fire.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
     const FireType FireType::CONIFEROUS_TREE(0, 7);
@@ -39,7 +40,7 @@ namespace Duel6 {
         std::vector<AnimationEntry> burningAnimation;
     }
 
-    Fire::Fire(const FireType &type, SpriteList::Iterator sprite, const Vector &position)
+    Fire::Fire(const FireType &type, SpriteList::Handle sprite, const Vector &position)
             : type(type), sprite(sprite), position(position), burned(false) {}
 
     FireList::FireList(const GameResources &resources, SpriteList &spriteList)
@@ -84,10 +85,34 @@ namespace Duel6 {
             sprite->setPosition(fire.getPosition() - Vector(0.3f, 0.2f), 0.78f)
                     .setSize(Vector(1.6f, 1.6f))
                     .setLooping(AnimationLooping::OnceAndRemove)
-                    .setBlendFunc(BlendFunc::SrcColor)
-                    .setOnFinished([&fire]() {
-                        fire.getSprite()->setAnimation(burnedAnimation);
-                    });
+                    .setBlendFunc(BlendFunc::SrcColor);
+            fire.setFlameSprite(sprite);
+            burnOut(fire);
+        }
+    }
+
+    void FireList::burnOut(Fire &fire) {
+        fire.getFlameSprite()->setOnFinished([&fire]() {
+            fire.getSprite()->setAnimation(burnedAnimation);
+        });
+    }
+
+    void FireList::saveState(BinaryWriter &writer) const {
+        for (const Fire &fire : fires) {
+            writer.write(fire.isBurned());
+            if (fire.isBurned()) {
+                spriteList.saveHandle(writer, fire.getFlameSprite());
+            }
+        }
+    }
+
+    void FireList::restoreState(BinaryReader &reader) {
+        for (Fire &fire : fires) {
+            fire.setBurned(reader.read<bool>());
+            fire.setFlameSprite(fire.isBurned() ? spriteList.restoreHandle(reader) : SpriteList::Handle());
+            if (fire.getFlameSprite().isValid()) {
+                burnOut(fire);
+            }
         }
     }
 
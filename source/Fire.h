@@ -38,6 +38,10 @@
 #include "Level.h"
 
 namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class FireType {
     public:
         static const FireType CONIFEROUS_TREE;
@@ -69,12 +73,13 @@ namespace Duel6 {
     class Fire {
     private:
         const FireType &type;
-        SpriteList::Iterator sprite;
+        SpriteList::Handle sprite;
+        SpriteList::Handle flameSprite;
         Vector position;
         bool burned;
 
     public:
-        Fire(const FireType &type, SpriteList::Iterator sprite, const Vector &position);
+        Fire(const FireType &type, SpriteList::Handle sprite, const Vector &position);
 
         const FireType &getType() const {
             return type;
@@ -88,10 +93,18 @@ namespace Duel6 {
             return position + Vector(0.5f, 0.5f);
         }
 
-        SpriteList::Iterator getSprite() const {
+        SpriteList::Handle getSprite() const {
             return sprite;
         }
 
+        SpriteList::Handle getFlameSprite() const {
+            return flameSprite;
+        }
+
+        void setFlameSprite(SpriteList::Handle flameSprite) {
+            this->flameSprite = flameSprite;
+        }
+
         bool isBurned() const {
             return burned;
         }
@@ -115,7 +128,15 @@ namespace Duel6 {
 
         void check(const Vector &explCentre, Float32 d);
 
+        void saveState(BinaryWriter &writer) const;
+
+        // Sprites have to be restored first, flames get their finish callbacks back here
+        void restoreState(BinaryReader &reader);
+
         static void initialize();
+
+    private:
+        static void burnOut(Fire &fire);
     };
 }
 
@@ -25,8 +25,7 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include <list>
-#include <unordered_map>
+#include <algorithm>
 #include "console/Console.h"
 #include "Font.h"
 #include "FontException.h"
@@ -34,9 +33,15 @@
 
 namespace Duel6 {
     Font::Font(Renderer &renderer)
-            : font(nullptr), renderer(renderer), fontCache(renderer, 100) {}
+            : font(nullptr), renderer(renderer), glyphTexture(0), glyphWidth(0), glyphHeight(0) {
+        // Until a font is loaded, text is measured as before glyph metrics existed
+        advances.fill(0.5f);
+    }
 
     Font::~Font() {
+        if (glyphTexture != 0) {
+            renderer.freeTexture(glyphTexture);
+        }
         if (font != nullptr) {
             TTF_CloseFont(font);
             font = nullptr;
@@ -49,51 +54,112 @@ namespace Duel6 {
         if (font == nullptr) {
             D6_THROW(FontException, Format("Unable to load font {0} due to error: {1}") << fontFile << TTF_GetError());
         }
+        buildGlyphs();
+    }
+
+    void Font::buildGlyphs() {
+        std::array<Image, GLYPHS> images;
+        glyphHeight = TTF_FontHeight(font);
+        glyphWidth = 1;
+        std::fill(advances.begin(), advances.begin() + FIRST_GLYPH, 0.0f);
+        for (Size i = 0; i < GLYPHS; i++) {
+            Uint16 character = Uint16(FIRST_GLYPH + i);
+            int minX, maxX, minY, maxY, advance;
+            if (!TTF_GlyphIsProvided(font, character) ||
+                TTF_GlyphMetrics(font, character, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+                advances[FIRST_GLYPH + i] = 0;
+                continue;
+            }
+
+            advances[FIRST_GLYPH + i] = Float32(advance) / glyphHeight;
+            SDL_Surface *surface = TTF_RenderGlyph_Blended(font, character, SDL_Color{255, 255, 255, 255});
+            if (surface != nullptr) {
+                images[i] = Image::fromSurface(surface);
+                SDL_FreeSurface(surface);
+                glyphWidth = std::max(glyphWidth, Int32(images[i].getWidth()));
+            }
+        }
+
+        // All layers of the array have the size of the widest glyph, each glyph is in the top left corner of its layer
+        Image glyphs(Size(glyphWidth), Size(glyphHeight), GLYPHS);
+        std::fill(&glyphs.at(0), &glyphs.at(0) + glyphWidth * glyphHeight * GLYPHS, Color(255, 255, 255, 0));
+        for (Size i = 0; i < GLYPHS; i++) {
+            const Image &image = images[i];
+            Size width = std::min(image.getWidth(), Size(glyphWidth));
+            Size height = std::min(image.getHeight(), Size(glyphHeight));
+            for (Size y = 0; y < height; y++) {
+                for (Size x = 0; x < width; x++) {
+                    glyphs.at((i * glyphHeight + y) * glyphWidth + x) = image.at(y * image.getWidth() + x);
+                }
+            }
+        }
+
+        glyphTexture = renderer.createTexture(glyphs, TextureFilter::Linear, true);
     }
 
     Float32 Font::getTextWidth(const std::string &str, Float32 height) const {
-        return str.size() * (height / 2.0f);
+        return getTextWidth(str.c_str(), str.size(), height);
     }
 
     Int32 Font::getTextWidth(const std::string &str, Int32 height) const {
-        return Int32(str.size() * height) / 2;
+        return getTextWidth(str.c_str(), str.size(), height);
+    }
+
+    Float32 Font::getTextWidth(const char *str, Size length, Float32 height) const {
+        Float32 width = 0;
+        for (Size i = 0; i < length; i++) {
+            width += advances[Uint8(str[i])];
+        }
+        return width * height;
+    }
+
+    Int32 Font::getTextWidth(const char *str, Size length, Int32 height) const {
+        return Int32(getTextWidth(str, length, Float32(height)) + 0.5f);
+    }
+
+    Float32 Font::getCharWidth(Float32 height) const {
+        return *std::max_element(advances.begin() + FIRST_GLYPH, advances.end()) * height;
     }
 
     void Font::print(Int32 x, Int32 y, const Color &color, const std::string &str) const {
-        print(Float32(x), Float32(y), 0.0f, color, str, Float32(getCharHeight()));
+        print(Float32(x), Float32(y), 0.0f, color, str.c_str(), str.size(), Float32(getCharHeight()));
     }
 
     void
     Font::print(Float32 x, Float32 y, Float32 z, const Color &color, const std::string &str, Float32 height) const {
-        if (str.length() < 1) {
+        print(x, y, z, color, str.c_str(), str.size(), height);
+    }
+
+    void Font::print(Int32 x, Int32 y, const Color &color, const char *str, Size length) const {
+        print(Float32(x), Float32(y), 0.0f, color, str, length, Float32(getCharHeight()));
+    }
+
+    void Font::print(Float32 x, Float32 y, Float32 z, const Color &color, const char *str, Size length,
+                     Float32 height) const {
+        if (length < 1 || glyphTexture == 0) {
             return;
         }
 
-        Texture texture = getTexture(str);
-        Material material = Material::makeColoredTexture(texture, color);
-        Float32 width = getTextWidth(str, height);
+        Material material = Material::makeColoredTexture(glyphTexture, color);
+        Vector size(glyphWidth * height / glyphHeight, height);
 
+        // Quads of one string always go to the graphics card together
+        bool batching = renderer.isBatching();
+        if (!batching) {
+            renderer.beginBatch();
+        }
         renderer.setBlendFunc(BlendFunc::SrcAlpha);
-        renderer.quadXY(Vector(x, y, z), Vector(width, height), Vector(0, 1), Vector(1, -1), material);
+        for (Size i = 0; i < length; i++) {
+            Size glyph = Uint8(str[i]);
+            if (glyph >= FIRST_GLYPH && advances[glyph] > 0) {
+                renderer.quadXY(Vector(x, y, z), size, Vector(0.0f, 1.0f, Float32(glyph - FIRST_GLYPH)), Vector(1, -1),
+                                material);
+            }
+            x += advances[glyph] * height;
+        }
         renderer.setBlendFunc(BlendFunc::None);
-    }
-
-    Texture Font::getTexture(const std::string &text) const {
-        if (fontCache.has(text)) {
-            return fontCache.get(text);
+        if (!batching) {
+            renderer.endBatch();
         }
-        Texture texture = renderText(text);
-        fontCache.add(text, texture);
-        return texture;
-    }
-
-    Texture Font::renderText(const std::string &text) const {
-        SDL_Surface *surface = TTF_RenderText_Blended(font, text.c_str(), SDL_Color{255, 255, 255, 255});
-        Image image = Image::fromSurface(surface);
-        SDL_FreeSurface(surface);
-
-        Texture texture = renderer.createTexture(image, TextureFilter::Linear, true);
-
-        return texture;
     }
 }
\ No newline at end of file
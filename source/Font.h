@@ -28,7 +28,8 @@
 #ifndef DUEL6_FONT_H
 #define DUEL6_FONT_H
 
-#include <vector>
+#include <array>
+#include <string>
 
 #if defined(__APPLE__)
 #include <SDL2_ttf/SDL_ttf.h>
@@ -41,16 +42,26 @@
 #include "Format.h"
 #include "renderer/RendererTypes.h"
 #include "renderer/Renderer.h"
-#include "FontCache.h"
 
 namespace Duel6 {
     class Console;
 
+    /**
+     * Every character of the font is rasterized once into a layer of a texture array,
+     * strings are drawn as quads of their characters spaced by the advances of the font.
+     */
     class Font {
+    private:
+        static const Size FIRST_GLYPH = 32;
+        static const Size GLYPHS = 256 - FIRST_GLYPH;
+
     private:
         TTF_Font *font;
         Renderer &renderer;
-        FontCache fontCache;
+        Texture glyphTexture;
+        Int32 glyphWidth;
+        Int32 glyphHeight;
+        std::array<Float32, 256> advances; // Advance of each character relative to the font height
 
     public:
         Font(Renderer &renderer);
@@ -63,12 +74,25 @@ namespace Duel6 {
 
         void print(Float32 x, Float32 y, Float32 z, const Color &color, const std::string &str, Float32 height) const;
 
+        // Texts formatted into fixed buffers are drawn without making a string of them
+        void print(Int32 x, Int32 y, const Color &color, const char *str, Size length) const;
+
+        void print(Float32 x, Float32 y, Float32 z, const Color &color, const char *str, Size length,
+                   Float32 height) const;
+
         Float32 getTextWidth(const std::string &str, Float32 height) const;
 
         Int32 getTextWidth(const std::string &str, Int32 height) const;
 
+        Float32 getTextWidth(const char *str, Size length, Float32 height) const;
+
+        Int32 getTextWidth(const char *str, Size length, Int32 height) const;
+
+        /** Width of the widest character at the given height. */
+        Float32 getCharWidth(Float32 height) const;
+
         Int32 getCharWidth() const {
-            return 8;
+            return Int32(getCharWidth(Float32(getCharHeight())) + 0.5f);
         }
 
         Int32 getCharHeight() const {
@@ -76,9 +100,7 @@ namespace Duel6 {
         }
 
     private:
-        Texture getTexture(const std::string &text) const;
-
-        Texture renderText(const std::string &text) const;
+        void buildGlyphs();
     };
 }
 
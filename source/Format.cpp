@@ -26,64 +26,37 @@
 */
 
 #include "Format.h"
-#include "FormatException.h"
 
 namespace Duel6 {
-    void Format::insertParam(Size index, const std::string &value) {
-        Placeholder placeholder;
-        while (getPlaceholder(index, placeholder)) {
-            if (!placeholder.hasWidth || value.length() >= (size_t) std::abs(placeholder.width)) // No padding
-            {
-                format.replace(placeholder.offset, placeholder.length, value);
-            } else if (placeholder.width > 0) // Right align
-            {
-                std::string paddedValue =
-                        std::string(placeholder.width - value.length(), placeholder.paddingCharacter) + value;
-                format.replace(placeholder.offset, placeholder.length, paddedValue);
-            } else // Left align
-            {
-                std::string paddedValue =
-                        value + std::string(-placeholder.width - value.length(), placeholder.paddingCharacter);
-                format.replace(placeholder.offset, placeholder.length, paddedValue);
-            }
-        }
-    }
+    namespace {
+        class StringOutput : public FormatOutput {
+        private:
+            std::string &text;
 
-    bool Format::getPlaceholder(Size index, Placeholder &placeholder) {
-        std::string prefix = '{' + std::to_string(index);
-        size_t start = format.find(prefix + '}');
+        public:
+            explicit StringOutput(std::string &text)
+                    : text(text) {}
 
-        if (start != std::string::npos) {
-            placeholder.offset = start;
-            placeholder.length = prefix.size() + 1;
-            placeholder.hasWidth = false;
-            return true;
-        }
+            void append(const char *value, Size length) override {
+                text.append(value, length);
+            }
 
-        start = format.find(prefix + ',');
-        if (start == std::string::npos) {
-            return false;
-        }
+            void append(char character, Size count) override {
+                text.append(count, character);
+            }
+        };
+    }
 
-        size_t end = format.find('}', start + prefix.length());
-        if (end == std::string::npos) {
-            D6_THROW(FormatException, "Unclosed parameter placeholder in: " + format);
+    Format::operator std::string() const {
+        if (values.empty()) {
+            return format;
         }
 
-        placeholder.offset = start;
-        placeholder.length = end - start + 1;
-        placeholder.hasWidth = true;
-
-        size_t widthStart = start + prefix.length() + 1;
-        std::string widthSpec = format.substr(widthStart, end - widthStart);
-        size_t padDelimitPos = widthSpec.find('|');
-        if (padDelimitPos != std::string::npos && padDelimitPos + 2 == widthSpec.length()) {
-            placeholder.paddingCharacter = format[end - 1];
-            widthSpec = widthSpec.substr(0, padDelimitPos);
-        } else {
-            placeholder.paddingCharacter = ' ';
-        }
-        placeholder.width = std::stoi(widthSpec);
-        return true;
+        std::vector<FormatArgument> arguments(values.begin(), values.end());
+        std::string text;
+        text.reserve(format.size());
+        StringOutput output(text);
+        FormatPattern::write(output, format.c_str(), arguments.data(), arguments.size());
+        return text;
     }
 }
\ No newline at end of file
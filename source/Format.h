@@ -28,44 +28,33 @@
 #ifndef DUEL6_FORMAT_H
 #define DUEL6_FORMAT_H
 
+#include <vector>
 #include "Formatter.h"
+#include "FormatPattern.h"
 
 namespace Duel6 {
-    /** Type-safe string formatting. */
+    /**
+     * Type-safe string formatting. Values are collected as strings and put into the format in one pass
+     * when the text is taken, a format without values is taken as it is. Use FormatPattern directly where
+     * allocations matter.
+     */
     class Format {
     private:
-        struct Placeholder {
-            Size offset;
-            Size length;
-            bool hasWidth;
-            Int32 width;
-            char paddingCharacter;
-        };
-
-    private:
-        Size paramIndex;
         std::string format;
+        std::vector<std::string> values;
 
     public:
         explicit Format(const std::string &format)
-                : paramIndex(0), format(format) {}
+                : format(format) {}
 
         template<class T>
         Format &operator<<(const T &val) {
             Formatter<T> formatter;
-            std::string value = formatter.format(val);
-            insertParam(paramIndex++, value);
+            values.push_back(formatter.format(val));
             return *this;
         }
 
-        operator std::string() const {
-            return format;
-        }
-
-    private:
-        void insertParam(Size index, const std::string &value);
-
-        bool getPlaceholder(Size index, Placeholder &placeholder);
+        operator std::string() const;
     };
 }
 
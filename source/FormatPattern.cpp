@@ -0,0 +1,111 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <charconv>
+#include <cstdlib>
+#include "FormatPattern.h"
+
+namespace Duel6 {
+    Size FormatArgument::getText(char *buffer, const char *&valueText) const {
+        valueText = buffer;
+        switch (type) {
+            case Type::Signed:
+                return std::to_chars(buffer, buffer + NUMBER_LENGTH, signedValue).ptr - buffer;
+            case Type::Unsigned:
+                return std::to_chars(buffer, buffer + NUMBER_LENGTH, unsignedValue).ptr - buffer;
+            case Type::Floating: {
+                // Same as std::to_string, huge values are cut off
+                Int32 written = snprintf(buffer, NUMBER_LENGTH, "%f", floatingValue);
+                return Size(std::min(written, Int32(NUMBER_LENGTH) - 1));
+            }
+            case Type::Character:
+                buffer[0] = char(signedValue);
+                return 1;
+            case Type::Text:
+                valueText = text;
+                return length;
+        }
+        return 0;
+    }
+
+    void FormatPattern::write(FormatOutput &output, const FormatArgument *arguments, Size argumentCount) const {
+        char buffer[FormatArgument::NUMBER_LENGTH];
+        for (Size i = 0; i < segmentCount; i++) {
+            const Segment &segment = segments[i];
+            if (segment.index < 0 || Size(segment.index) >= argumentCount) {
+                output.append(text + segment.offset, segment.length);
+            } else {
+                writeArgument(output, segment, arguments[segment.index], buffer);
+            }
+        }
+    }
+
+    void FormatPattern::write(FormatOutput &output, const char *text, const FormatArgument *arguments,
+                              Size argumentCount) {
+        char buffer[FormatArgument::NUMBER_LENGTH];
+        Size literalStart = 0;
+        Size pos = 0;
+        while (text[pos] != '\0') {
+            Segment placeholder;
+            Size end = pos;
+            try {
+                end = parsePlaceholder(text, pos, placeholder);
+            } catch (const FormatException &) {
+                if (Size(placeholder.index) < argumentCount) {
+                    throw;
+                }
+            }
+            if (end == pos || Size(placeholder.index) >= argumentCount) {
+                pos = std::max(end, pos + 1);
+                continue;
+            }
+
+            output.append(text + literalStart, pos - literalStart);
+            writeArgument(output, placeholder, arguments[placeholder.index], buffer);
+            pos = end;
+            literalStart = end;
+        }
+        output.append(text + literalStart, pos - literalStart);
+    }
+
+    void FormatPattern::writeArgument(FormatOutput &output, const Segment &placeholder,
+                                      const FormatArgument &argument, char *buffer) {
+        const char *valueText;
+        Size length = argument.getText(buffer, valueText);
+        Size width = Size(std::abs(placeholder.width));
+        if (length >= width) {
+            output.append(valueText, length);
+        } else if (placeholder.width > 0) {
+            output.append(placeholder.padding, width - length);
+            output.append(valueText, length);
+        } else {
+            output.append(valueText, length);
+            output.append(placeholder.padding, width - length);
+        }
+    }
+}
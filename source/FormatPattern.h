@@ -0,0 +1,293 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_FORMATPATTERN_H
+#define DUEL6_FORMATPATTERN_H
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <type_traits>
+#include "Type.h"
+#include "FormatException.h"
+
+namespace Duel6 {
+    /** Destination of formatted text. */
+    class FormatOutput {
+    public:
+        virtual ~FormatOutput() {}
+
+        virtual void append(const char *text, Size length) = 0;
+
+        virtual void append(char character, Size count) = 0;
+    };
+
+    /** Formatted text in a fixed buffer, text that doesn't fit is cut off. */
+    template<Size Capacity>
+    class FormatBuffer : public FormatOutput {
+    private:
+        char text[Capacity + 1];
+        Size length;
+
+    public:
+        FormatBuffer()
+                : length(0) {
+            text[0] = '\0';
+        }
+
+        void clear() {
+            length = 0;
+            text[0] = '\0';
+        }
+
+        void append(const char *value, Size valueLength) override {
+            Size count = std::min(valueLength, Capacity - length);
+            for (Size i = 0; i < count; i++) {
+                text[length++] = value[i];
+            }
+            text[length] = '\0';
+        }
+
+        void append(char character, Size count) override {
+            count = std::min(count, Capacity - length);
+            for (Size i = 0; i < count; i++) {
+                text[length++] = character;
+            }
+            text[length] = '\0';
+        }
+
+        const char *c_str() const {
+            return text;
+        }
+
+        Size size() const {
+            return length;
+        }
+
+        std::string str() const {
+            return std::string(text, length);
+        }
+    };
+
+    /** Value of a placeholder, refers to strings without copying them. */
+    class FormatArgument {
+    private:
+        enum class Type {
+            Signed,
+            Unsigned,
+            Floating,
+            Character,
+            Text
+        };
+
+    private:
+        Type type;
+        Int64 signedValue = 0;
+        Uint64 unsignedValue = 0;
+        Float64 floatingValue = 0;
+        const char *text = nullptr;
+        Size length = 0;
+
+    public:
+        // Longest text of a number
+        static constexpr Size NUMBER_LENGTH = 64;
+
+    public:
+        template<class T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+        FormatArgument(T value)
+                : type(Type::Signed), signedValue(value) {}
+
+        template<class T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, int>::type = 0>
+        FormatArgument(T value)
+                : type(Type::Unsigned), unsignedValue(value) {}
+
+        template<class T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+        FormatArgument(T value)
+                : type(Type::Floating), floatingValue(value) {}
+
+        FormatArgument(char value)
+                : type(Type::Character), signedValue(value) {}
+
+        FormatArgument(bool value)
+                : type(Type::Text), text(value ? "true" : "false"), length(value ? 4 : 5) {}
+
+        FormatArgument(const char *value)
+                : type(Type::Text), text(value), length(std::char_traits<char>::length(value)) {}
+
+        FormatArgument(const std::string &value)
+                : type(Type::Text), text(value.c_str()), length(value.size()) {}
+
+        /**
+         * Gets the text of the value the same way as Formatter does.
+         * @param buffer space of NUMBER_LENGTH characters for numbers
+         * @param valueText set to the text, which doesn't have to be in the buffer
+         * @return length of the text
+         */
+        Size getText(char *buffer, const char *&valueText) const;
+    };
+
+    /**
+     * Format string with "{index}" or "{index,width|padding}" placeholders parsed in advance.
+     * A negative width aligns the value to the left. Patterns of literals can be parsed at compile time:
+     *
+     *     static constexpr FormatPattern pattern("FPS - {0}");
+     *     FormatBuffer<32> buffer;
+     *     pattern.format(buffer, fps);
+     *
+     * Formatting into a FormatBuffer doesn't allocate. Placeholders without an argument are kept as they are.
+     * A pattern parsed in advance holds at most MAX_SEGMENTS placeholders and literals, longer format strings
+     * are formatted by the static write() instead.
+     */
+    class FormatPattern {
+    public:
+        static constexpr Size MAX_SEGMENTS = 64;
+
+    private:
+        struct Segment {
+            Size offset = 0;
+            Size length = 0;
+            Int32 index = -1; // Literal text when negative
+            Int32 width = 0; // No padding when zero
+            char padding = ' ';
+        };
+
+    private:
+        const char *text;
+        Size segmentCount = 0;
+        Segment segments[MAX_SEGMENTS] = {};
+
+    public:
+        /**
+         * @param text format string, it has to outlive the pattern
+         */
+        constexpr explicit FormatPattern(const char *text)
+                : text(text) {
+            Size literalStart = 0;
+            Size pos = 0;
+            while (text[pos] != '\0') {
+                Segment placeholder;
+                Size end = parsePlaceholder(text, pos, placeholder);
+                if (end == pos) {
+                    pos++;
+                    continue;
+                }
+
+                addLiteral(literalStart, pos);
+                placeholder.offset = pos;
+                placeholder.length = end - pos;
+                addSegment(placeholder);
+                pos = end;
+                literalStart = end;
+            }
+            addLiteral(literalStart, pos);
+        }
+
+        template<class... Args>
+        void format(FormatOutput &output, const Args &... args) const {
+            const std::array<FormatArgument, sizeof...(Args)> arguments = {{FormatArgument(args)...}};
+            write(output, arguments.data(), arguments.size());
+        }
+
+        void write(FormatOutput &output, const FormatArgument *arguments, Size argumentCount) const;
+
+        /**
+         * Formats the text without parsing it in advance, so it has no limit on placeholders. A malformed
+         * placeholder is an error only when there is an argument for it, otherwise it is kept as it is.
+         */
+        static void write(FormatOutput &output, const char *text, const FormatArgument *arguments,
+                          Size argumentCount);
+
+    private:
+        static constexpr bool isDigit(char character) {
+            return character >= '0' && character <= '9';
+        }
+
+        // Returns the position after the placeholder at pos, pos itself when there is no placeholder
+        static constexpr Size parsePlaceholder(const char *text, Size pos, Segment &placeholder) {
+            if (text[pos] != '{' || !isDigit(text[pos + 1])) {
+                return pos;
+            }
+
+            Size end = pos + 1;
+            Int32 index = 0;
+            while (isDigit(text[end])) {
+                index = index * 10 + (text[end++] - '0');
+            }
+            placeholder.index = index;
+            if (text[end] == '}') {
+                return end + 1;
+            }
+            if (text[end] != ',') {
+                return pos;
+            }
+
+            end++;
+            bool alignLeft = text[end] == '-';
+            if (alignLeft) {
+                end++;
+            }
+            if (!isDigit(text[end])) {
+                D6_THROW(FormatException, std::string("Invalid parameter placeholder in: ") + text);
+            }
+            Int32 width = 0;
+            while (isDigit(text[end])) {
+                width = width * 10 + (text[end++] - '0');
+            }
+            placeholder.width = alignLeft ? -width : width;
+
+            if (text[end] == '|' && text[end + 1] != '\0' && text[end + 2] == '}') {
+                placeholder.padding = text[end + 1];
+                end += 2;
+            }
+            if (text[end] != '}') {
+                D6_THROW(FormatException, std::string("Unclosed parameter placeholder in: ") + text);
+            }
+            return end + 1;
+        }
+
+        constexpr void addLiteral(Size start, Size end) {
+            if (end > start) {
+                Segment literal;
+                literal.offset = start;
+                literal.length = end - start;
+                addSegment(literal);
+            }
+        }
+
+        constexpr void addSegment(const Segment &segment) {
+            if (segmentCount == MAX_SEGMENTS) {
+                D6_THROW(FormatException, std::string("Too many parameter placeholders in: ") + text);
+            }
+            segments[segmentCount++] = segment;
+        }
+
+        static void writeArgument(FormatOutput &output, const Segment &placeholder, const FormatArgument &argument,
+                                  char *buffer);
+    };
+}
+
+#endif
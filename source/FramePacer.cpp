@@ -0,0 +1,122 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <SDL2/SDL.h>
+#include "FramePacer.h"
+
+namespace Duel6 {
+    namespace {
+        // The sleep ends this early and the rest of the wait is spun
+        const Float64 spinMilliseconds = 2.0;
+
+        Float32 getPercentile(std::vector<Float32> &values, Size percent) {
+            Size index = std::min(values.size() - 1, (values.size() * percent) / 100);
+            std::nth_element(values.begin(), values.begin() + index, values.end());
+            return values[index];
+        }
+    }
+
+    FramePacer::FramePacer()
+            : counterToMilliseconds(1000.0 / SDL_GetPerformanceFrequency()), frameStart(0), presentStart(0),
+              nextFrame(0) {
+        reset();
+    }
+
+    void FramePacer::startFrame() {
+        frameStart = SDL_GetPerformanceCounter();
+    }
+
+    void FramePacer::startPresent() {
+        presentStart = SDL_GetPerformanceCounter();
+    }
+
+    void FramePacer::endPresent() {
+        Uint64 presentEnd = SDL_GetPerformanceCounter();
+        Timing timing = {Float32((presentStart - frameStart) * counterToMilliseconds),
+                         Float32((presentEnd - presentStart) * counterToMilliseconds)};
+
+        if (timings.size() < WINDOW) {
+            timings.push_back(timing);
+        } else {
+            timings[nextTiming] = timing;
+        }
+        nextTiming = (nextTiming + 1) % WINDOW;
+    }
+
+    void FramePacer::wait(Int32 maxFps) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (maxFps <= 0) {
+            nextFrame = now;
+            return;
+        }
+
+        Uint64 period = SDL_GetPerformanceFrequency() / maxFps;
+        // Frames that came late start a new schedule instead of being followed by shorter ones
+        nextFrame = (nextFrame + period < now) ? now : nextFrame + period;
+        if (now >= nextFrame) {
+            return;
+        }
+
+        Float64 sleepMilliseconds = (nextFrame - now) * counterToMilliseconds - spinMilliseconds;
+        if (sleepMilliseconds > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(Int64(sleepMilliseconds * 1000)));
+        }
+        while (SDL_GetPerformanceCounter() < nextFrame) {
+            std::this_thread::yield();
+        }
+    }
+
+    void FramePacer::reset() {
+        timings.clear();
+        timings.reserve(WINDOW);
+        nextTiming = 0;
+    }
+
+    FramePacer::Stats FramePacer::getStats() const {
+        Stats stats;
+        if (timings.empty()) {
+            return stats;
+        }
+
+        std::vector<Float32> cpu, present;
+        cpu.reserve(timings.size());
+        present.reserve(timings.size());
+        for (const Timing &timing : timings) {
+            cpu.push_back(timing.cpu);
+            present.push_back(timing.present);
+        }
+
+        stats.p50 = {getPercentile(cpu, 50), getPercentile(present, 50)};
+        stats.p95 = {getPercentile(cpu, 95), getPercentile(present, 95)};
+        stats.p99 = {getPercentile(cpu, 99), getPercentile(present, 99)};
+        stats.max = {*std::max_element(cpu.begin(), cpu.end()), *std::max_element(present.begin(), present.end())};
+        return stats;
+    }
+}
@@ -0,0 +1,89 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_FRAMEPACER_H
+#define DUEL6_FRAMEPACER_H
+
+#include <vector>
+#include "Type.h"
+
+namespace Duel6 {
+    /**
+     * Limits the frame rate and keeps the CPU and present times of the recent frames. A frame is the time
+     * from startFrame() to endPresent(), the wait for the next frame is not part of it.
+     */
+    class FramePacer {
+    public:
+        static constexpr Size WINDOW = 1024;
+
+        struct Timing {
+            Float32 cpu; // Milliseconds from the start of the frame to the swap
+            Float32 present; // Milliseconds spent in the swap
+        };
+
+        struct Stats {
+            Timing p50 = {0, 0};
+            Timing p95 = {0, 0};
+            Timing p99 = {0, 0};
+            Timing max = {0, 0};
+        };
+
+    private:
+        Float64 counterToMilliseconds;
+        std::vector<Timing> timings;
+        Size nextTiming;
+        Uint64 frameStart;
+        Uint64 presentStart;
+        Uint64 nextFrame;
+
+    public:
+        FramePacer();
+
+        void startFrame();
+
+        void startPresent();
+
+        void endPresent();
+
+        /**
+         * Sleeps until the next frame of the given rate is due and spins for the last part of the wait,
+         * as the sleep may oversleep by a millisecond or more. Returns at once for a zero rate.
+         */
+        void wait(Int32 maxFps);
+
+        void reset();
+
+        Size getFrameCount() const {
+            return timings.size();
+        }
+
+        // Percentiles of the recent frames
+        Stats getStats() const;
+    };
+}
+
+#endif
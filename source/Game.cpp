@@ -32,32 +32,58 @@
 #include "GameMode.h"
 
 namespace Duel6 {
+    namespace {
+        struct GeneratedSkin {
+            Image image;
+            bool cached;
+        };
+    }
+
     Game::Game(AppService &appService, GameResources &resources, GameSettings &settings)
             : appService(appService), resources(resources), settings(settings), worldRenderer(appService, *this),
-              playedRounds(0) {}
+              renderState(nullptr), menu(nullptr), playedRounds(0), seed(0), random(0), startedRounds(0), replay(nullptr),
+              replayDiverged(false) {}
 
     void Game::beforeStart(Context *prevContext) {
         SDL_ShowCursor(SDL_DISABLE);
     }
 
     void Game::beforeClose(Context *nextContext) {
+        levelPreloader.cancel();
         endRound();
     }
 
-    void Game::render() const {
-        worldRenderer.render();
+    void Game::render() {
+        getRound().getWorld().updateRenderData(renderState->time, renderState->waterLevel);
+        worldRenderer.render(*renderState);
     }
 
     void Game::update(Float32 elapsedTime) {
-        if (getRound().isOver()) {
+        if (getRound().isReplayOver()) {
+            // Rounds of a replay end exactly where the recorded ones did, whatever ended them
+            if (!isReplayFinished()) {
+                nextRound();
+            }
+        } else if (getRound().isOver()) {
             if (!getRound().isLast()) {
                 nextRound();
             }
         } else {
+            Profiler::Tick tick(appService.getProfiler());
             getRound().update(elapsedTime);
+            if (getRound().hasWinner() && !getRound().isLast() &&
+                levelPreloader.getState() == LevelPreloader::State::Idle) {
+                preloadNextRound();
+            }
+            publishRenderState();
         }
     }
 
+    bool Game::canUpdateConcurrently() const {
+        // Starting the next round builds the level buffers, only the rounds themselves run without the renderer
+        return !getRound().isReplayOver() && !getRound().isOver();
+    }
+
     void Game::keyEvent(const KeyPressEvent &event) {
         if (event.getCode() == SDLK_ESCAPE && (isOver() || event.withShift())) {
             close();
@@ -79,6 +105,7 @@ namespace Duel6 {
         }
 
         getRound().keyEvent(event);
+        publishRenderState();
     }
 
     void Game::textInputEvent(const TextInputEvent &event) {}
@@ -99,6 +126,20 @@ namespace Duel6 {
         Console &console = appService.getConsole();
         console.printLine("\n=== Starting new game ===");
         console.printLine(Format("...Rounds: {0}") << settings.getMaxRounds());
+        if (replay != nullptr) {
+            seed = replay->getSeed();
+        } else {
+            seed = settings.getSeed() != 0 ? settings.getSeed() : Random::makeSeed();
+        }
+        console.printLine(Format("...Seed: {0}") << seed);
+        random = Random(seed);
+        startedRounds = 0;
+        replayDiverged = false;
+        recording.reset();
+        if (replay == nullptr && !settings.getRecordPath().empty()) {
+            console.printLine(Format("...Recording to: {0}") << settings.getRecordPath());
+            recording = std::make_unique<InputLog>(seed, playerDefinitions.size());
+        }
         TextureManager &textureManager = appService.getTextureManager();
         players.clear();
 
@@ -110,16 +151,48 @@ namespace Duel6 {
         Size playerIndex = 0;
         players.reserve(playerDefinitions.size());
         playerAnimations = std::make_unique<PlayerAnimations>(resources.getPlayerAnimation());
+
+        // Skins are composited on the thread pool, only texture creation has to stay on this thread
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        const SkinCache &skinCache = resources.getSkinCache();
+        const PlayerAnimations &animations = *playerAnimations;
+        std::vector<std::future<GeneratedSkin>> generatedSkins;
+        for (const PlayerDefinition &playerDef : playerDefinitions) {
+            PlayerSkinColors colors = playerDef.getColors();
+            generatedSkins.push_back(textureManager.getThreadPool().submit(
+                    [&skinCache, &animations, &textureManager, colors]() {
+                        GeneratedSkin skin;
+                        skin.cached = skinCache.load(colors, skin.image);
+                        if (!skin.cached) {
+                            skin.image = animations.generateAnimationImage(textureManager, colors);
+                            skinCache.save(colors, skin.image);
+                        }
+                        return skin;
+                    }));
+        }
+        for (auto &generatedSkin : generatedSkins) {
+            generatedSkin.wait();
+        }
+
+        Size cachedSkins = 0;
         for (const PlayerDefinition &playerDef : playerDefinitions) {
-            console.printLine(Format("...Generating player for person: {0}") << playerDef.getPerson().getName());
-            skins.push_back(PlayerSkin(playerDef.getColors(), textureManager, *playerAnimations));
+            console.printLine(Format("...Generating player for person: {0}") << playerDef.getPerson().getName(),
+                              LogLevel::Verbose);
+            GeneratedSkin skin = generatedSkins[playerIndex].get();
+            cachedSkins += skin.cached ? 1 : 0;
+            skins.push_back(PlayerSkin(textureManager.createTexture(skin.image, TextureFilter::Nearest, true),
+                                       *playerAnimations));
             players.emplace_back(
                     playerDef.getPerson(), skins.back(), playerDef.getSounds(), playerDef.getControls());
             playerIndex++;
         }
+        Float64 skinTime = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+        console.printLine(Format("...Skins ready in {0} ms, {1} of {2} from cache")
+                                  << Int32(skinTime * 1000) << cachedSkins << skins.size());
 
+        levelPreloader.cancel();
         this->levels = levels;
-        std::shuffle(this->levels.begin(), this->levels.end(), Math::randomEngine);
+        random.shuffle(this->levels.begin(), this->levels.end());
 
         this->backgrounds = backgrounds;
         this->gameMode = &gameMode;
@@ -133,23 +206,67 @@ namespace Duel6 {
         currentRound = playedRounds;
         displayScoreTab = false;
 
-        bool shuffle = settings.getLevelSelectionMode() == LevelSelectionMode::Shuffle;
-        Int32 level = shuffle ? playedRounds % Int32(levels.size()) : Math::random(Int32(levels.size()));
-        const std::string levelPath = levels[level];
-        bool mirror = Math::random(2) == 0;
+        std::unique_ptr<PreparedLevel> preparedLevel;
+        if (levelPreloader.getState() != LevelPreloader::State::Idle) {
+            preparedLevel = takePreloadedLevel();
+        }
+
+        if (!preparedLevel) {
+            std::string levelPath;
+            bool mirror;
+            Uint16 waterBlock;
+            chooseLevel(levelPath, mirror, waterBlock);
+            preparedLevel = std::make_unique<PreparedLevel>(resources.getLevelCache(), resources.getBlockMeta(),
+                                                            appService.getVideo().getRenderer(),
+                                                            settings.getScreenMode(), settings.isMergeWalls(),
+                                                            levelPath, mirror, waterBlock);
+        }
 
         Console &console = appService.getConsole();
-        console.printLine(Format("\n===Loading level {0}===") << levelPath);
-        console.printLine(Format("...Parameters: mirror: {0}") << mirror);
+        console.printLine(Format("\n===Loading level {0}===") << preparedLevel->path);
+        console.printLine(Format("...Parameters: mirror: {0}") << preparedLevel->mirror, LogLevel::Verbose);
 
-        round = std::make_unique<Round>(*this, playedRounds, levelPath, mirror);
+        // Each round draws from its own stream so that level preloading and skipped rounds do not shift it
+        round = std::make_unique<Round>(*this, playedRounds, *preparedLevel, Random(seed, Uint32(startedRounds)).next());
         round->setOnRoundEnd([this]() {
             onRoundEnd();
         });
+        if (recording) {
+            recording->startRound(preparedLevel->path, preparedLevel->mirror, preparedLevel->defaultWaterBlock);
+            round->record(recording.get());
+        }
+        if (replay != nullptr && startedRounds < replay->getRounds().size()) {
+            round->replay(replay->getRounds()[startedRounds]);
+        }
+        startedRounds++;
         round->start();
+        publishRenderState();
+    }
+
+    void Game::publishRenderState() {
+        Profiler::Timer timer(appService.getProfiler(), Profiler::Section::RenderState);
+        renderStates.getBack().capture(*this);
+        renderStates.publish();
     }
 
     void Game::endRound() {
+        if (recording) {
+            recording->endRound(round->getTicks(), round->getChecksum());
+            try {
+                recording->save(settings.getRecordPath());
+            } catch (const Exception &e) {
+                appService.getConsole().printLine(Format("...Saving recording failed: {0}") << e.getMessage(),
+                                                  LogLevel::Error);
+            }
+        }
+        if (replay != nullptr && startedRounds <= replay->getRounds().size()) {
+            const InputLog::Round &recordedRound = replay->getRounds()[startedRounds - 1];
+            if (round->getTicks() != recordedRound.ticks || round->getChecksum() != recordedRound.checksum) {
+                replayDiverged = true;
+                appService.getConsole().printLine(Format("Replay diverged in round {0}") << startedRounds,
+                                                  LogLevel::Error);
+            }
+        }
         round->end();
     }
 
@@ -158,7 +275,9 @@ namespace Duel6 {
         if (round->isLast()) {
             getMode().updateElo(players);
         }
-        menu->savePersonData();
+        if (menu != nullptr) {
+            menu->savePersonData();
+        }
     }
 
     void Game::nextRound() {
@@ -166,6 +285,66 @@ namespace Duel6 {
         startRound();
     }
 
+    void Game::chooseLevel(std::string &levelPath, bool &mirror, Uint16 &waterBlock) {
+        // Rounds started so far is the index of the chosen round, also when preloading during the running one
+        if (replay != nullptr && startedRounds < replay->getRounds().size()) {
+            const InputLog::Round &recordedRound = replay->getRounds()[startedRounds];
+            levelPath = recordedRound.level;
+            mirror = recordedRound.mirror;
+            waterBlock = recordedRound.waterBlock;
+            return;
+        }
+
+        bool shuffle = settings.getLevelSelectionMode() == LevelSelectionMode::Shuffle;
+        Int32 level = shuffle ? playedRounds % Int32(levels.size()) : random.random(Int32(levels.size()));
+        levelPath = levels[level];
+        mirror = random.random(2) == 0;
+        waterBlock = Level::randomWaterBlock(random);
+    }
+
+    void Game::preloadNextRound() {
+        std::string levelPath;
+        bool mirror;
+        Uint16 waterBlock;
+        chooseLevel(levelPath, mirror, waterBlock);
+
+        appService.getConsole().printLine(Format("...Preloading next level {0}") << levelPath);
+        levelPreloader.start(resources.getLevelCache(), resources.getBlockMeta(), appService.getVideo().getRenderer(),
+                             settings.getScreenMode(), settings.isMergeWalls(), levelPath, mirror, waterBlock);
+    }
+
+    std::unique_ptr<PreparedLevel> Game::takePreloadedLevel() {
+        Console &console = appService.getConsole();
+        bool ready = levelPreloader.getState() == LevelPreloader::State::Ready;
+
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        std::unique_ptr<PreparedLevel> preparedLevel = levelPreloader.take();
+        Float64 waitTime = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+        Float64 preparationTime = levelPreloader.getPreparationTime();
+
+        console.printLine(Format("...Preload {0}: prepared in {1} ms, waited {2} ms, saved {3} ms")
+                                  << (ready ? "ready" : "still loading") << Int32(preparationTime * 1000)
+                                  << Int32(waitTime * 1000) << Int32((preparationTime - waitTime) * 1000),
+                          LogLevel::Verbose);
+
+        // Wall faces depend on the screen mode and wall merging, which may have been switched on the score screen
+        if (preparedLevel->screenMode != settings.getScreenMode() ||
+            preparedLevel->mergeWalls != settings.isMergeWalls()) {
+            console.printLine("...Wall settings changed, preparing preloaded level again");
+            preparedLevel = std::make_unique<PreparedLevel>(resources.getLevelCache(), resources.getBlockMeta(),
+                                                            appService.getVideo().getRenderer(),
+                                                            settings.getScreenMode(), settings.isMergeWalls(),
+                                                            preparedLevel->path,
+                                                            preparedLevel->mirror, preparedLevel->defaultWaterBlock);
+        }
+
+        return preparedLevel;
+    }
+
+    bool Game::isReplayFinished() const {
+        return replay != nullptr && startedRounds >= replay->getRounds().size() && getRound().isReplayOver();
+    }
+
     Int32 Game::getCurrentRound() const {
         return currentRound;
     }
@@ -44,6 +44,11 @@
 #include "GameSettings.h"
 #include "GameResources.h"
 #include "Round.h"
+#include "LevelPreloader.h"
+#include "InputLog.h"
+#include "RenderState.h"
+#include "TripleBuffer.h"
+#include "math/Random.h"
 
 namespace Duel6 {
     class GameMode;
@@ -91,7 +96,10 @@ namespace Duel6 {
         GameSettings &settings;
         GameMode *gameMode;
         std::unique_ptr<Round> round;
+        LevelPreloader levelPreloader;
         WorldRenderer worldRenderer;
+        TripleBuffer<RenderState> renderStates; // Published at the end of each update
+        const RenderState *renderState; // Drawn by the next frame
         const Menu *menu;
 
         std::vector<std::string> levels;
@@ -100,6 +108,13 @@ namespace Duel6 {
         Int32 currentRound;
         Int32 playedRounds;
 
+        Uint32 seed;
+        Random random;
+        Size startedRounds;
+        std::unique_ptr<InputLog> recording;
+        const InputLog *replay;
+        bool replayDiverged;
+
         std::vector<Player> players;
         std::vector<PlayerSkin> skins;
         std::unique_ptr<PlayerAnimations> playerAnimations;
@@ -127,7 +142,13 @@ namespace Duel6 {
 
         void update(Float32 elapsedTime) override;
 
-        void render() const override;
+        void beforeRender() override {
+            renderState = &renderStates.read();
+        }
+
+        void render() override;
+
+        bool canUpdateConcurrently() const override;
 
         AppService &getAppService() const {
             return appService;
@@ -207,6 +228,28 @@ namespace Duel6 {
             this->menu = &menu;
         }
 
+        Uint32 getSeed() const {
+            return seed;
+        }
+
+        /**
+         * Plays the next started game from a recorded input log instead of player controls.
+         * The game has to be started with the same players and settings as the recorded one.
+         * @param replay log to play, must outlive the game, nullptr to play normally
+         */
+        void setReplay(const InputLog *replay) {
+            this->replay = replay;
+        }
+
+        bool isReplayFinished() const;
+
+        bool isReplayDiverged() const {
+            return replayDiverged;
+        }
+
+        /** Ends the running round, for drivers that stop a game without closing it. */
+        void endRound();
+
     private:
         void beforeStart(Context *prevContext) override;
 
@@ -214,9 +257,15 @@ namespace Duel6 {
 
         void startRound();
 
+        void publishRenderState();
+
         void nextRound();
 
-        void endRound();
+        void chooseLevel(std::string &levelPath, bool &mirror, Uint16 &waterBlock);
+
+        void preloadNextRound();
+
+        std::unique_ptr<PreparedLevel> takePreloadedLevel();
 
         void onRoundEnd();
     };
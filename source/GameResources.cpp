@@ -30,10 +30,14 @@
 #include "Fire.h"
 #include "Weapon.h"
 #include "Bonus.h"
+#include "File.h"
 
 namespace Duel6 {
     void GameResources::load(Console &console, Sound &sound, TextureManager &textureManager) {
         console.printLine("\n===Initializing game resources===");
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        prefetchTextures(textureManager);
+
         console.printLine("\n...Weapon initialization");
         Weapon::initialize(sound, textureManager);
         console.printLine("...Building water-list");
@@ -43,6 +47,7 @@ namespace Duel6 {
         gameOverSound = sound.loadSample("sound/game/game-over.wav");
         console.printLine(Format("...Loading block meta data: {0}") << D6_FILE_BLOCK_META);
         blockMeta = Block::loadMeta(D6_FILE_BLOCK_META);
+        levelCache = std::make_unique<LevelCache>(blockMeta, D6_FILE_BLOCK_META);
         console.printLine(Format("...Loading block textures: {0}") << D6_TEXTURE_BLOCK_PATH);
         blockTextures = textureManager.loadStack(D6_TEXTURE_BLOCK_PATH, TextureFilter::Linear, true);
         console.printLine(Format("...Loading explosion textures: {0}") << D6_TEXTURE_EXPL_PATH);
@@ -57,6 +62,7 @@ namespace Duel6 {
         std::string animationPath(D6_TEXTURE_MAN_PATH);
         animationPath += "man.ase";
         playerAnimation = textureManager.loadAnimation(animationPath);
+        skinCache = std::make_unique<SkinCache>(std::string(D6_TEXTURE_MAN_PATH) + "cache/", animationPath);
         console.printLine(Format("...Loading fire textures: {0}") << D6_TEXTURE_FIRE_PATH);
         for (const FireType &fireType : FireType::values()) {
             Texture texture = textureManager.loadStack(Format("{0}{1,3|0}/") << D6_TEXTURE_FIRE_PATH << fireType.getId(),
@@ -69,5 +75,27 @@ namespace Duel6 {
 
         console.printLine("\n...Bonus initialization");
         BonusType::initialize();
+
+        textureManager.clearPrefetched();
+        Float64 loadTime = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+        console.printLine(Format("...Resources loaded in {0} ms using {1} loader threads")
+                                  << Int32(loadTime * 1000) << textureManager.getThreadPool().getThreadCount());
+    }
+
+    void GameResources::prefetchTextures(TextureManager &textureManager) {
+        textureManager.prefetchStack(D6_TEXTURE_WATER_PATH);
+        for (const std::string &weapon : File::listDirectory(D6_TEXTURE_WPN_PATH)) {
+            for (const char *part : {"boom", "gun", "shot"}) {
+                textureManager.prefetchStack(Format("{0}{1}/{2}/") << D6_TEXTURE_WPN_PATH << weapon << part);
+            }
+        }
+        textureManager.prefetchStack(D6_TEXTURE_BLOCK_PATH);
+        textureManager.prefetchStack(D6_TEXTURE_EXPL_PATH);
+        textureManager.prefetchStack(D6_TEXTURE_BONUS_PATH);
+        textureManager.prefetchStack(D6_TEXTURE_ELEVATOR_PATH);
+        for (const FireType &fireType : FireType::values()) {
+            textureManager.prefetchStack(Format("{0}{1,3|0}/") << D6_TEXTURE_FIRE_PATH << fireType.getId());
+        }
+        textureManager.prefetchStack("textures/fire/burn/");
     }
 }
@@ -28,9 +28,12 @@
 #ifndef DUEL6_GAMERESOURCES_H
 #define DUEL6_GAMERESOURCES_H
 
+#include <memory>
 #include <unordered_map>
 #include "Water.h"
 #include "Block.h"
+#include "LevelCache.h"
+#include "SkinCache.h"
 #include "AppService.h"
 #include "aseprite/animation.h"
 namespace Duel6 {
@@ -40,6 +43,7 @@ namespace Duel6 {
 
     private:
         Block::Meta blockMeta;
+        std::unique_ptr<LevelCache> levelCache;
         Sound::Sample gameOverSound;
         Sound::Sample roundStartSound;
         Texture blockTextures;
@@ -50,6 +54,7 @@ namespace Duel6 {
         std::unordered_map<Size, Texture> fireTextures;
         Texture burningTexture;
         animation::Animation playerAnimation;
+        std::unique_ptr<SkinCache> skinCache;
 
     public:
         void load(Console &console, Sound &sound, TextureManager &textureManager);
@@ -58,6 +63,10 @@ namespace Duel6 {
             return blockMeta;
         }
 
+        LevelCache &getLevelCache() {
+            return *levelCache;
+        }
+
         const Sound::Sample &getGameOverSound() const {
             return gameOverSound;
         }
@@ -97,6 +106,16 @@ namespace Duel6 {
         animation::Animation & getPlayerAnimation() {
         	return playerAnimation;
         }
+
+        const SkinCache &getSkinCache() const {
+            return *skinCache;
+        }
+
+    private:
+        /**
+         * Starts decoding the texture stacks used by load() on the texture manager's thread pool.
+         */
+        void prefetchTextures(TextureManager &textureManager);
     };
 }
 
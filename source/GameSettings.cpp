@@ -30,10 +30,10 @@
 namespace Duel6 {
     GameSettings::GameSettings()
             : ammoRange(15, 15), maxRounds(0), screenMode(ScreenMode::FullScreen),
-              screenZoom(13), wireframe(false), showFps(false), showRanking(true),
-              ghostMode(false), quickLiquid(true), globalAssistances(true),
-              shotCollision(ShotCollisionSetting::Large),
-              levelSelectionMode(LevelSelectionMode::Random) {}
+              screenZoom(13), wireframe(false), mergeWalls(false), batchedShotUpdate(true), threadedUpdate(false),
+              maxFps(0), menuMaxFps(60), showFps(false), showProfiler(false), showRanking(true), ghostMode(false),
+              quickLiquid(true), globalAssistances(true), shotCollision(ShotCollisionSetting::Large),
+              levelSelectionMode(LevelSelectionMode::Random), seed(0) {}
 
     GameSettings &GameSettings::enableWeapon(const Weapon &weapon, bool enable) {
         if (enable) {
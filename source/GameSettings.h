@@ -28,6 +28,7 @@
 #ifndef DUEL6_GAMESETTINGS_H
 #define DUEL6_GAMESETTINGS_H
 
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include "Type.h"
@@ -56,7 +57,13 @@ namespace Duel6 {
         ScreenMode screenMode;
         Int32 screenZoom;
         bool wireframe;
+        bool mergeWalls;
+        bool batchedShotUpdate;
+        bool threadedUpdate;
+        Int32 maxFps;
+        Int32 menuMaxFps;
         bool showFps;
+        bool showProfiler;
         bool showRanking;
         bool ghostMode;
         bool quickLiquid;
@@ -64,6 +71,8 @@ namespace Duel6 {
         ShotCollisionSetting shotCollision;
         EnabledWeapons enabledWeapons;
         LevelSelectionMode levelSelectionMode;
+        Uint32 seed;
+        std::string recordPath;
 
     public:
         GameSettings();
@@ -144,6 +153,84 @@ namespace Duel6 {
             return *this;
         }
 
+        /** Seed of all gameplay randomness in the next game, 0 for a random one. */
+        Uint32 getSeed() const {
+            return seed;
+        }
+
+        GameSettings &setSeed(Uint32 seed) {
+            this->seed = seed;
+            return *this;
+        }
+
+        /** File the controls of the next game are recorded to, empty when not recording. */
+        const std::string &getRecordPath() const {
+            return recordPath;
+        }
+
+        GameSettings &setRecordPath(const std::string &recordPath) {
+            this->recordPath = recordPath;
+            return *this;
+        }
+
+        bool isMergeWalls() const {
+            return mergeWalls;
+        }
+
+        GameSettings &setMergeWalls(bool mergeWalls) {
+            this->mergeWalls = mergeWalls;
+            return *this;
+        }
+
+        bool isBatchedShotUpdate() const {
+            return batchedShotUpdate;
+        }
+
+        /** Shots are moved and tested against walls all at once, off only to check that it plays the same. */
+        GameSettings &setBatchedShotUpdate(bool batched) {
+            batchedShotUpdate = batched;
+            return *this;
+        }
+
+        bool isThreadedUpdate() const {
+            return threadedUpdate;
+        }
+
+        /** Rounds are updated on their own thread while the main thread keeps rendering. */
+        GameSettings &setThreadedUpdate(bool threaded) {
+            threadedUpdate = threaded;
+            return *this;
+        }
+
+        Int32 getMaxFps() const {
+            return maxFps;
+        }
+
+        /** Frame rate limit, 0 for none. */
+        GameSettings &setMaxFps(Int32 maxFps) {
+            this->maxFps = maxFps;
+            return *this;
+        }
+
+        Int32 getMenuMaxFps() const {
+            return menuMaxFps;
+        }
+
+        /** Frame rate limit in the menu, which has nothing to gain from more frames. 0 for none. */
+        GameSettings &setMenuMaxFps(Int32 menuMaxFps) {
+            this->menuMaxFps = menuMaxFps;
+            return *this;
+        }
+
+        bool isShowProfiler() const {
+            return showProfiler;
+        }
+
+        GameSettings &setShowProfiler(bool showProfiler) {
+            this->showProfiler = showProfiler;
+            return *this;
+        }
+
         bool isShowRanking() const {
             return showRanking;
         }
@@ -27,8 +27,13 @@
 
 #include "Font.h"
 #include "InfoMessageQueue.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
+    namespace {
+        constexpr FormatPattern messagePattern("{0}: {1}");
+    }
+
     InfoMessageQueue &InfoMessageQueue::add(const Player &player, const std::string &msg) {
         messages.push_back(InfoMessage(player, msg, duration));
         return *this;
@@ -53,7 +58,7 @@ namespace Duel6 {
 
         for (const InfoMessage &msg : messages) {
             if (player.is(msg.getPlayer())) {
-                renderMessage(renderer, posX, posY, msg.getText(), font);
+                renderMessage(renderer, posX, posY, msg.getText().c_str(), msg.getText().size(), font);
                 posY -= 16;
             }
         }
@@ -64,19 +69,42 @@ namespace Duel6 {
         Int32 posY = view.getY() + view.getHeight() - offsetY;
 
         for (const InfoMessage &msg : messages) {
-            renderMessage(renderer, posX, posY, msg.getPlayer().getPerson().getName() + ": " + msg.getText(), font);
+            FormatBuffer<256> text;
+            messagePattern.format(text, msg.getPlayer().getPerson().getName(), msg.getText());
+            renderMessage(renderer, posX, posY, text.c_str(), text.size(), font);
             posY -= 16;
         }
     }
 
-    void InfoMessageQueue::renderMessage(Renderer &renderer, Int32 x, Int32 y, const std::string &msg, const Font &font) {
+    void InfoMessageQueue::renderMessage(Renderer &renderer, Int32 x, Int32 y, const char *msg, Size length,
+                                         const Font &font) {
         renderer.setBlendFunc(BlendFunc::SrcAlpha);
-        renderer.quadXY(Vector(x, y + 1), Vector(8 * Uint32(msg.length()), 14), Color(0, 0, 255, 178));
+        renderer.quadXY(Vector(x, y + 1), Vector(font.getTextWidth(msg, length, font.getCharHeight()), 14),
+                        Color(0, 0, 255, 178));
         renderer.setBlendFunc(BlendFunc::None);
-        font.print(x, y, Color::YELLOW, msg);
+        font.print(x, y, Color::YELLOW, msg, length);
     }
 
     void InfoMessageQueue::clear() {
         messages.clear();
     }
+
+    void InfoMessageQueue::saveState(BinaryWriter &writer, const std::vector<Player> &players) const {
+        writer.write(Uint32(messages.size()));
+        for (const InfoMessage &msg : messages) {
+            writer.write(Uint8(&msg.getPlayer() - players.data()));
+            writer.write(msg.getText());
+            writer.write(msg.getRemainingTime());
+        }
+    }
+
+    void InfoMessageQueue::restoreState(BinaryReader &reader, const std::vector<Player> &players) {
+        messages.clear();
+        Size count = reader.read<Uint32>();
+        for (Size i = 0; i < count; i++) {
+            const Player &player = players.at(reader.read<Uint8>());
+            std::string text = reader.readString();
+            messages.push_back(InfoMessage(player, text, reader.read<Float32>()));
+        }
+    }
 }
\ No newline at end of file
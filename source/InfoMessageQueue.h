@@ -33,6 +33,10 @@
 #include "InfoMessage.h"
 
 namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class InfoMessageQueue {
     private:
         /** How long each message stays on the screen (in seconds). */
@@ -53,8 +57,13 @@ namespace Duel6 {
 
         void clear();
 
+        // Messages refer to their players by index
+        void saveState(BinaryWriter &writer, const std::vector<Player> &players) const;
+
+        void restoreState(BinaryReader &reader, const std::vector<Player> &players);
+
     private:
-        static void renderMessage(Renderer &renderer, Int32 x, Int32 y, const std::string &msg, const Font &font);
+        static void renderMessage(Renderer &renderer, Int32 x, Int32 y, const char *msg, Size length, const Font &font);
     };
 }
 
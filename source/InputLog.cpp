@@ -0,0 +1,136 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "InputLog.h"
+#include "BinaryStream.h"
+#include "File.h"
+
+namespace Duel6 {
+    InputLog::InputLog(Uint32 seed, Size players)
+            : seed(seed), players(players) {}
+
+    void InputLog::startRound(const std::string &level, bool mirror, Uint16 waterBlock) {
+        rounds.push_back(Round{level, mirror, waterBlock, 0, 0, {}});
+    }
+
+    void InputLog::endRound(Uint32 ticks, Uint64 checksum) {
+        rounds.back().ticks = ticks;
+        rounds.back().checksum = checksum;
+    }
+
+    void InputLog::save(const std::string &path) const {
+        BinaryWriter writer;
+        for (char c : MAGIC) {
+            writer.write(c);
+        }
+        writer.write(VERSION);
+        writer.write(seed);
+        writer.write(Uint32(players));
+        writer.write(Uint32(rounds.size()));
+
+        for (const Round &round : rounds) {
+            writer.write(round.level);
+            writer.write(Uint8(round.mirror ? 1 : 0));
+            writer.write(round.waterBlock);
+            writer.write(round.ticks);
+            writer.write(round.checksum);
+
+            // Controls change rarely compared to the tick rate, so runs of each player compress well
+            Size ticks = players > 0 ? round.states.size() / players : 0;
+            writer.write(Uint32(ticks));
+            for (Size player = 0; player < players; player++) {
+                std::vector<std::pair<Uint16, Uint8>> runs;
+                for (Size tick = 0; tick < ticks; tick++) {
+                    Uint8 state = round.states[tick * players + player];
+                    if (!runs.empty() && runs.back().second == state && runs.back().first < 0xffff) {
+                        runs.back().first++;
+                    } else {
+                        runs.emplace_back(1, state);
+                    }
+                }
+
+                writer.write(Uint32(runs.size()));
+                for (const auto &run : runs) {
+                    writer.write(run.first);
+                    writer.write(run.second);
+                }
+            }
+        }
+
+        const std::vector<Uint8> &data = writer.getData();
+        File file(path, File::Mode::Binary, File::Access::Write);
+        file.write(data.data(), 1, data.size());
+    }
+
+    InputLog InputLog::load(const std::string &path) {
+        std::vector<Uint8> data = File::load(path);
+        BinaryReader reader(data);
+
+        for (char c : MAGIC) {
+            if (reader.read<char>() != c) {
+                D6_THROW(IoException, "Not an input log: " + path);
+            }
+        }
+        if (reader.read<Uint32>() != VERSION) {
+            D6_THROW(IoException, "Input log has a different version: " + path);
+        }
+
+        Uint32 seed = reader.read<Uint32>();
+        InputLog log(seed, reader.read<Uint32>());
+        Uint32 roundCount = reader.read<Uint32>();
+
+        for (Uint32 i = 0; i < roundCount; i++) {
+            std::string level = reader.readString();
+            bool mirror = reader.read<Uint8>() != 0;
+            Uint16 waterBlock = reader.read<Uint16>();
+            log.startRound(level, mirror, waterBlock);
+
+            Round &round = log.rounds.back();
+            round.ticks = reader.read<Uint32>();
+            round.checksum = reader.read<Uint64>();
+
+            Size ticks = reader.read<Uint32>();
+            round.states.resize(ticks * log.players);
+            for (Size player = 0; player < log.players; player++) {
+                Uint32 runCount = reader.read<Uint32>();
+                Size tick = 0;
+                for (Uint32 run = 0; run < runCount; run++) {
+                    Uint16 length = reader.read<Uint16>();
+                    Uint8 state = reader.read<Uint8>();
+                    if (tick + length > ticks) {
+                        D6_THROW(IoException, "Input log is corrupted: " + path);
+                    }
+                    for (Uint16 j = 0; j < length; j++, tick++) {
+                        round.states[tick * log.players + player] = state;
+                    }
+                }
+            }
+        }
+
+        return log;
+    }
+}
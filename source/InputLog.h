@@ -0,0 +1,94 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_INPUTLOG_H
+#define DUEL6_INPUTLOG_H
+
+#include <string>
+#include <vector>
+#include "Type.h"
+
+namespace Duel6 {
+    /**
+     * Controller states of all players for every tick of a match. Together with the game seed it is
+     * enough to play the match again tick by tick, provided the players and game settings are the same.
+     * Stored in a compact binary file with the states of each player run-length encoded.
+     */
+    class InputLog {
+    public:
+        struct Round {
+            std::string level;
+            bool mirror;
+            Uint16 waterBlock;
+            Uint32 ticks;
+            Uint64 checksum;
+            std::vector<Uint8> states; // States of all players for one tick after another
+        };
+
+    private:
+        static constexpr char MAGIC[4] = {'D', '6', 'I', 'L'};
+        static constexpr Uint32 VERSION = 1;
+
+        Uint32 seed;
+        Size players;
+        std::vector<Round> rounds;
+
+    public:
+        InputLog(Uint32 seed, Size players);
+
+        Uint32 getSeed() const {
+            return seed;
+        }
+
+        Size getPlayers() const {
+            return players;
+        }
+
+        const std::vector<Round> &getRounds() const {
+            return rounds;
+        }
+
+        void startRound(const std::string &level, bool mirror, Uint16 waterBlock);
+
+        void addState(Uint32 controllerState) {
+            rounds.back().states.push_back(Uint8(controllerState));
+        }
+
+        /**
+         * Closes the current round.
+         * @param ticks number of updates the round ran for
+         * @param checksum of the final game state, used to detect replays that went different
+         */
+        void endRound(Uint32 ticks, Uint64 checksum);
+
+        void save(const std::string &path) const;
+
+        static InputLog load(const std::string &path);
+    };
+}
+
+#endif
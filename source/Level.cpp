@@ -25,45 +25,33 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
 #include <queue>
 #include "Game.h"
 #include "Level.h"
-#include "json/JsonParser.h"
+#include "CompiledLevel.h"
 #include "GameException.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    Level::Level(const std::string &path, bool mirror, const Block::Meta &blockMeta)
-            : blockMeta(blockMeta), raisingWater(false) {
-        load(path, mirror);
-    }
-
-    void Level::load(const std::string &path, bool mirror) {
-        levelData.clear();
-        Json::Parser parser;
-        Json::Value root = parser.parse(path);
-
-        width = root.get("width").asInt();
-        height = root.get("height").asInt();
-        background = root.getOrDefault("background", Json::Value::makeString("")).asString();
-
-        Int32 blockCount = width * height;
-        Json::Value blocks = root.get("blocks");
-        levelData.resize(blockCount);
-        for (Size i = 0; i < blocks.getLength(); i++) {
-            levelData[i] = Uint16(blocks.get(i).asInt());
-        }
+    Level::Level(const CompiledLevel &compiledLevel, bool mirror, Uint16 defaultWaterBlock,
+                 const Block::Meta &blockMeta)
+            : blockMeta(blockMeta), width(compiledLevel.getWidth()), height(compiledLevel.getHeight()),
+              background(compiledLevel.getBackground()), raisingWater(false) {
+        const Uint16 *blocks = compiledLevel.getBlocks();
+        levelData.assign(blocks, blocks + width * height);
 
         if (mirror) {
-            mirrorLevelData();
+            Level::mirror(width, height, levelData);
         }
-        waterBlock = findWaterType();
+        waterBlock = findWaterType(defaultWaterBlock);
         waterLevel = findWaterLevel(waterBlock);
     }
 
-    void Level::mirrorLevelData() {
+    void Level::mirror(Int32 width, Int32 height, std::vector<Uint16> &blocks) {
         for (Int32 y = 0; y < height; y++) {
             for (Int32 x = 0; x < width / 2; x++) {
-                std::swap(levelData[y * width + x], levelData[y * width + width - 1 - x]);
+                std::swap(blocks[y * width + x], blocks[y * width + width - 1 - x]);
             }
         }
     }
@@ -72,6 +60,8 @@ namespace Duel6 {
         raisingWater = true;
         if (waterLevel < getHeight() - 1) {
             waterLevel++;
+            auto row = levelData.begin() + (height - waterLevel - 1) * width;
+            floodedRows.insert(floodedRows.end(), row, row + width);
             for (Int32 x = 0; x < getWidth(); x++) {
                 if (!isWall(x, waterLevel, false)) {
                     setBlock(waterBlock, x, waterLevel);
@@ -80,7 +70,12 @@ namespace Duel6 {
         }
     }
 
-    Uint16 Level::findWaterType() const {
+    Uint16 Level::randomWaterBlock(Random &random) {
+        static Uint16 waterBlocks[] = {4, 16, 33};
+        return waterBlocks[random.random(3)];
+    }
+
+    Uint16 Level::findWaterType(Uint16 defaultWaterBlock) const {
         for (Int32 y = 0; y < getHeight(); y++) {
             for (Int32 x = 0; x < getWidth(); x++) {
                 if (isWater(x, y)) {
@@ -89,8 +84,7 @@ namespace Duel6 {
             }
         }
 
-        static Uint16 waterBlocks[] = {4, 16, 33};
-        return waterBlocks[Math::random(3)];
+        return defaultWaterBlock;
     }
 
     Int32 Level::findWaterLevel(Uint16 waterBlock) const {
@@ -147,4 +141,29 @@ namespace Duel6 {
     bool Level::isRaisingWater() const {
         return raisingWater;
     }
+
+    void Level::setWaterLevel(Int32 waterLevel) {
+        bool raising = raisingWater;
+        while (this->waterLevel < waterLevel && this->waterLevel < getHeight() - 1) {
+            raiseWater();
+        }
+        raisingWater = raising;
+
+        while (this->waterLevel > waterLevel && !floodedRows.empty()) {
+            auto row = floodedRows.end() - width;
+            std::copy(row, floodedRows.end(), levelData.begin() + (height - this->waterLevel - 1) * width);
+            floodedRows.erase(row, floodedRows.end());
+            this->waterLevel--;
+        }
+    }
+
+    void Level::saveState(BinaryWriter &writer) const {
+        writer.write(waterLevel);
+        writer.write(raisingWater);
+    }
+
+    void Level::restoreState(BinaryReader &reader) {
+        setWaterLevel(reader.read<Int32>());
+        reader.read(raisingWater);
+    }
 }
@@ -33,9 +33,13 @@
 #include <vector>
 #include "Block.h"
 #include "Water.h"
+#include "math/Random.h"
 
 namespace Duel6 {
     class Game;
+    class CompiledLevel;
+    class BinaryWriter;
+    class BinaryReader;
 
     class Level {
     public:
@@ -51,9 +55,21 @@ namespace Duel6 {
         Uint16 waterBlock;
         Int32 waterLevel;
         bool raisingWater;
+        std::vector<Uint16> floodedRows; // Original blocks of rows flooded by rising water, lowest row first
 
     public:
-        Level(const std::string &path, bool mirror, const Block::Meta &blockMeta);
+        /**
+         * The default water block is used when the level contains no water, see randomWaterBlock().
+         */
+        Level(const CompiledLevel &compiledLevel, bool mirror, Uint16 defaultWaterBlock, const Block::Meta &blockMeta);
+
+        static Uint16 randomWaterBlock(Random &random);
+
+        static void mirror(Int32 width, Int32 height, std::vector<Uint16> &blocks);
+
+        const Block::Meta &getBlockMeta() const {
+            return blockMeta;
+        }
 
         Int32 getWidth() const {
             return width;
@@ -105,11 +121,17 @@ namespace Duel6 {
 
         bool isRaisingWater() const;
 
-    private:
-        void load(const std::string &path, bool mirror);
+        /**
+         * Floods or drains rows up to the given water level, drained rows get their original blocks back.
+         */
+        void setWaterLevel(Int32 waterLevel);
+
+        // Rising water is the only change of blocks during a round, so the water level is the whole state
+        void saveState(BinaryWriter &writer) const;
 
-        void mirrorLevelData();
+        void restoreState(BinaryReader &reader);
 
+    private:
         bool isPossibleStartingPosition(Int32 x, Int32 y);
 
         Uint16 getBlock(Int32 x, Int32 y) const {
@@ -120,7 +142,7 @@ namespace Duel6 {
             levelData[(height - y - 1) * width + x] = block;
         }
 
-        Uint16 findWaterType() const;
+        Uint16 findWaterType(Uint16 defaultWaterBlock) const;
 
         Int32 findWaterLevel(Uint16 waterBlock) const;
     };
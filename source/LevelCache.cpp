@@ -0,0 +1,142 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdio>
+#include "LevelCache.h"
+#include "File.h"
+#include "IoException.h"
+
+namespace Duel6 {
+    namespace {
+        bool isSameFile(const CompiledLevel::Source &first, const CompiledLevel::Source &second) {
+            return first.size == second.size && first.modificationTime == second.modificationTime &&
+                   first.blockMetaHash == second.blockMetaHash;
+        }
+    }
+
+    LevelCache::LevelCache(const Block::Meta &blockMeta, const std::string &blockMetaPath)
+            : blockMeta(blockMeta), blockMetaHash(File::hash(blockMetaPath)) {}
+
+    std::shared_ptr<const CompiledLevel> LevelCache::get(const std::string &path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        CompiledLevel::Source source = {File::getSize(path), File::getModificationTime(path), 0, blockMetaHash};
+
+        auto entry = levels.find(path);
+        if (entry != levels.end()) {
+            if (isSameFile(entry->second.source, source)) {
+                return entry->second.level;
+            }
+            levels.erase(entry);
+        }
+
+        std::string cachePath = getCachePath(path);
+        std::shared_ptr<const CompiledLevel> level = loadCacheFile(path, cachePath, source);
+        if (!level) {
+            level = compile(path, cachePath, source);
+        }
+
+        levels[path] = Entry{source, level};
+        return level;
+    }
+
+    void LevelCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        levels.clear();
+    }
+
+    std::string LevelCache::getCachePath(const std::string &path) {
+        std::string::size_type extension = path.rfind('.');
+        std::string::size_type directory = path.find_last_of("/\\");
+        if (extension == std::string::npos || (directory != std::string::npos && extension < directory)) {
+            return path + ".cache";
+        }
+        return path.substr(0, extension) + ".cache";
+    }
+
+    std::shared_ptr<const CompiledLevel> LevelCache::loadCacheFile(const std::string &path, const std::string &cachePath,
+                                                                   CompiledLevel::Source &source) const {
+        if (!File::exists(cachePath)) {
+            return nullptr;
+        }
+
+        std::shared_ptr<const CompiledLevel> level;
+        try {
+            level = std::make_shared<CompiledLevel>(std::make_unique<MappedFile>(cachePath));
+        } catch (const IoException &) {
+            return nullptr;
+        }
+
+        const CompiledLevel::Source &cached = level->getSource();
+        if (cached.blockMetaHash != source.blockMetaHash) {
+            return nullptr;
+        }
+        if (cached.size != source.size) {
+            return nullptr;
+        }
+        if (cached.modificationTime == source.modificationTime) {
+            source.hash = cached.hash;
+            return level;
+        }
+        if (cached.hash == File::hash(path)) {
+            // Same content with a new time, e.g. after a checkout. The time is stored so that the next runs
+            // don't have to hash the source again.
+            source.hash = cached.hash;
+            std::vector<Uint8> image = level->withSource(source);
+            level.reset();
+            return store(cachePath, std::move(image));
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<const CompiledLevel> LevelCache::compile(const std::string &path, const std::string &cachePath,
+                                                             const CompiledLevel::Source &source) const {
+        CompiledLevel::Source compiledSource = source;
+        compiledSource.hash = File::hash(path);
+        return store(cachePath, CompiledLevel::compile(path, compiledSource, blockMeta));
+    }
+
+    std::shared_ptr<const CompiledLevel> LevelCache::store(const std::string &cachePath,
+                                                           std::vector<Uint8> &&image) const {
+        // Write aside and rename so that levels mapped from the previous file stay intact
+        std::string temporaryPath = cachePath + ".tmp";
+        try {
+            {
+                File file(temporaryPath, File::Mode::Binary, File::Access::Write);
+                file.write(image.data(), 1, image.size());
+            }
+            std::remove(cachePath.c_str());
+            if (std::rename(temporaryPath.c_str(), cachePath.c_str()) == 0) {
+                return std::make_shared<CompiledLevel>(std::make_unique<MappedFile>(cachePath));
+            }
+        } catch (const IoException &) {
+        }
+
+        std::remove(temporaryPath.c_str());
+        return std::make_shared<CompiledLevel>(std::move(image));
+    }
+}
@@ -0,0 +1,82 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_LEVELCACHE_H
+#define DUEL6_LEVELCACHE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Type.h"
+#include "Block.h"
+#include "CompiledLevel.h"
+
+namespace Duel6 {
+    /**
+     * Compiles levels on first use into a binary file next to the level source and memory maps it afterwards.
+     * A cache file is reused while the size and modification time of the source match, or while its content
+     * hash does (the new time is then written to the cache file), and as long as the block meta data it was
+     * compiled against is unchanged. When the cache file cannot be written, the compiled level is kept in memory
+     * only. Levels may be requested from several threads.
+     */
+    class LevelCache {
+    private:
+        struct Entry {
+            CompiledLevel::Source source;
+            std::shared_ptr<const CompiledLevel> level;
+        };
+
+    private:
+        const Block::Meta &blockMeta;
+        Uint64 blockMetaHash;
+        std::unordered_map<std::string, Entry> levels;
+        std::mutex mutex;
+
+    public:
+        LevelCache(const Block::Meta &blockMeta, const std::string &blockMetaPath);
+
+        std::shared_ptr<const CompiledLevel> get(const std::string &path);
+
+        /** Forgets all loaded levels, cache files are kept. */
+        void clear();
+
+        static std::string getCachePath(const std::string &path);
+
+    private:
+        std::shared_ptr<const CompiledLevel> loadCacheFile(const std::string &path, const std::string &cachePath,
+                                                           CompiledLevel::Source &source) const;
+
+        std::shared_ptr<const CompiledLevel> compile(const std::string &path, const std::string &cachePath,
+                                                     const CompiledLevel::Source &source) const;
+
+        // Writes the cache file, the level is kept in memory when it cannot be written
+        std::shared_ptr<const CompiledLevel> store(const std::string &cachePath, std::vector<Uint8> &&image) const;
+    };
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <SDL2/SDL.h>
+#include "LevelPreloader.h"
+#include "Defines.h"
+
+namespace Duel6 {
+    PreparedLevel::PreparedLevel(LevelCache &levelCache, const Block::Meta &blockMeta, Renderer &renderer,
+                                 ScreenMode screenMode, bool mergeWalls, const std::string &path, bool mirror,
+                                 Uint16 defaultWaterBlock)
+            : path(path), mirror(mirror), defaultWaterBlock(defaultWaterBlock), screenMode(screenMode),
+              mergeWalls(mergeWalls) {
+        compiledLevel = levelCache.get(path);
+        level = std::make_unique<Level>(*compiledLevel, mirror, defaultWaterBlock, blockMeta);
+        renderLevel = std::make_unique<Level>(*level);
+        renderData = std::make_unique<LevelRenderData>(*renderLevel, renderer, screenMode, D6_ANM_SPEED, D6_WAVE_HEIGHT);
+        renderData->prepareFaces(compiledLevel->getWallFaces(mirror, screenMode),
+                                 compiledLevel->getWallFaceCount(mirror, screenMode), mergeWalls);
+    }
+
+    LevelPreloader::LevelPreloader()
+            : finished(false), preparationTime(0) {}
+
+    LevelPreloader::~LevelPreloader() {
+        cancel();
+    }
+
+    void LevelPreloader::start(LevelCache &levelCache, const Block::Meta &blockMeta, Renderer &renderer,
+                               ScreenMode screenMode, bool mergeWalls, const std::string &path, bool mirror,
+                               Uint16 defaultWaterBlock) {
+        cancel();
+        finished = false;
+        worker = std::thread([this, &levelCache, &blockMeta, &renderer, screenMode, mergeWalls, path, mirror,
+                                     defaultWaterBlock]() {
+            Uint64 startCounter = SDL_GetPerformanceCounter();
+            try {
+                preparedLevel = std::make_unique<PreparedLevel>(levelCache, blockMeta, renderer, screenMode,
+                                                                mergeWalls, path, mirror, defaultWaterBlock);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            preparationTime = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+            finished = true;
+        });
+    }
+
+    LevelPreloader::State LevelPreloader::getState() const {
+        if (!worker.joinable()) {
+            return State::Idle;
+        }
+        return finished ? State::Ready : State::Loading;
+    }
+
+    std::unique_ptr<PreparedLevel> LevelPreloader::take() {
+        if (worker.joinable()) {
+            worker.join();
+        }
+        if (error) {
+            std::exception_ptr workerError = error;
+            error = nullptr;
+            std::rethrow_exception(workerError);
+        }
+        return std::move(preparedLevel);
+    }
+
+    void LevelPreloader::cancel() {
+        if (worker.joinable()) {
+            worker.join();
+        }
+        preparedLevel.reset();
+        error = nullptr;
+    }
+}
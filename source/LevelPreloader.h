@@ -0,0 +1,107 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_LEVELPRELOADER_H
+#define DUEL6_LEVELPRELOADER_H
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include "Type.h"
+#include "ScreenMode.h"
+#include "CompiledLevel.h"
+#include "Level.h"
+#include "LevelCache.h"
+#include "LevelRenderData.h"
+
+namespace Duel6 {
+    class Renderer;
+
+    /**
+     * Everything a round needs from its level except the renderer buffers. Building it does not touch
+     * the renderer or the global random generator, so it can be done off the main thread.
+     */
+    struct PreparedLevel {
+        std::string path;
+        bool mirror;
+        Uint16 defaultWaterBlock;
+        ScreenMode screenMode;
+        bool mergeWalls;
+        std::shared_ptr<const CompiledLevel> compiledLevel;
+        std::unique_ptr<Level> level;
+        std::unique_ptr<Level> renderLevel; // Copy for the main thread while the updates change the other one
+        std::unique_ptr<LevelRenderData> renderData; // Of the render level
+
+        PreparedLevel(LevelCache &levelCache, const Block::Meta &blockMeta, Renderer &renderer, ScreenMode screenMode,
+                      bool mergeWalls, const std::string &path, bool mirror, Uint16 defaultWaterBlock);
+    };
+
+    /**
+     * Prepares the level of the next round on a worker thread while the current round is winding down.
+     */
+    class LevelPreloader {
+    public:
+        enum class State {
+            Idle,
+            Loading,
+            Ready
+        };
+
+    private:
+        std::thread worker;
+        std::atomic<bool> finished;
+        std::unique_ptr<PreparedLevel> preparedLevel;
+        std::exception_ptr error;
+        Float64 preparationTime;
+
+    public:
+        LevelPreloader();
+
+        ~LevelPreloader();
+
+        void start(LevelCache &levelCache, const Block::Meta &blockMeta, Renderer &renderer, ScreenMode screenMode,
+                   bool mergeWalls, const std::string &path, bool mirror, Uint16 defaultWaterBlock);
+
+        State getState() const;
+
+        /**
+         * Waits for the worker and hands over the prepared level. Errors of the worker are rethrown here.
+         */
+        std::unique_ptr<PreparedLevel> take();
+
+        void cancel();
+
+        /** Seconds the worker spent preparing the last taken level. */
+        Float64 getPreparationTime() const {
+            return preparationTime;
+        }
+    };
+}
+
+#endif
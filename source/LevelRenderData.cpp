@@ -33,16 +33,87 @@ namespace Duel6 {
     LevelRenderData::LevelRenderData(const Level &level, Renderer &renderer, ScreenMode screenMode,
                                      Float32 animationSpeed, Float32 waveHeight)
             : level(level), renderer(renderer), screenMode(screenMode), animationSpeed(animationSpeed), animWait(0),
-              waveHeight(waveHeight) {}
+              waveHeight(waveHeight), chunkSize(CHUNK_SIZE), chunksX(0) {}
 
-    void LevelRenderData::generateFaces() {
-        addWallFaces();
+    void LevelRenderData::prepareFaces(const WallFace *wallFaces, Size wallFaceCount, bool mergeWalls,
+                                       bool chunked) {
+        makeChunks(chunked ? CHUNK_SIZE : std::max(level.getWidth(), level.getHeight()));
+        if (mergeWalls) {
+            addMergedWallFaces(wallFaces, wallFaceCount);
+        } else {
+            addWallFaces(wallFaces, wallFaceCount);
+        }
         addSpriteFaces();
-        generateWater();
+        groupFacesByChunk(walls, &Chunk::walls);
+        groupFacesByChunk(sprites, &Chunk::sprites);
+        addWaterFaces(water);
     }
 
-    void LevelRenderData::generateWater() {
-        addWaterFaces();
+    void LevelRenderData::build() {
+        walls.build(renderer);
+        sprites.build(renderer);
+        water.build(renderer);
+    }
+
+    void LevelRenderData::updateWaterRows(Int32 fromY, Int32 toY) {
+        fromY = std::max(fromY, 0);
+        toY = std::min(toY, level.getHeight() - 1);
+        if (fromY > toY) {
+            return;
+        }
+
+        FaceList chunkFaces;
+        for (Int32 chunkY = fromY / chunkSize; chunkY <= toY / chunkSize; chunkY++) {
+            for (Int32 chunkX = 0; chunkX < chunksX; chunkX++) {
+                Size index = Size(chunkY * chunksX + chunkX);
+                Chunk &chunk = chunks[index];
+
+                chunkFaces.clear();
+                addWaterChunk(chunkFaces, index);
+                Size count = chunkFaces.getFaces().size();
+
+                if (count > chunk.waterCapacity) {
+                    // Lay out all water again, every chunk gets new spare faces
+                    FaceList allFaces;
+                    addWaterFaces(allFaces);
+                    water.replace(0, water.getFaces().size(), allFaces, renderer);
+                    return;
+                }
+
+                addWaterPadding(chunkFaces, chunk.waterCapacity - count);
+                water.overwrite(chunk.water.first, chunkFaces, renderer);
+                chunk.water.count = count;
+            }
+        }
+    }
+
+    void LevelRenderData::findVisibleFaces(ViewCulling &culling, std::vector<FaceList::Range> &wallRanges,
+                                           std::vector<FaceList::Range> &spriteRanges,
+                                           std::vector<FaceList::Range> &waterRanges) const {
+        auto addRange = [](std::vector<FaceList::Range> &ranges, const FaceList::Range &range) {
+            if (range.count == 0) {
+                return;
+            }
+            if (!ranges.empty() && ranges.back().first + ranges.back().count == range.first) {
+                ranges.back().count += range.count;
+            } else {
+                ranges.push_back(range);
+            }
+        };
+
+        wallRanges.clear();
+        spriteRanges.clear();
+        waterRanges.clear();
+        for (const Chunk &chunk : chunks) {
+            if (chunk.walls.count + chunk.sprites.count + chunk.water.count == 0) {
+                continue;
+            }
+            if (culling.isVisible(chunk.bounds)) {
+                addRange(wallRanges, chunk.walls);
+                addRange(spriteRanges, chunk.sprites);
+                addRange(waterRanges, chunk.water);
+            }
+        }
     }
 
     void LevelRenderData::update(Float32 elapsedTime) {
@@ -55,20 +126,104 @@ namespace Duel6 {
         }
     }
 
-    void LevelRenderData::addWallFaces() {
+    void LevelRenderData::addWallFaces(const WallFace *wallFaces, Size wallFaceCount) {
         walls.clear();
 
-        for (Int32 y = 0; y < level.getHeight(); y++) {
-            for (Int32 x = 0; x < level.getWidth(); x++) {
-                const Block &block = level.getBlockMeta(x, y);
+        const Block::Meta &blockMeta = level.getBlockMeta();
+        for (Size i = 0; i < wallFaceCount; i++) {
+            const WallFace &wallFace = wallFaces[i];
+            addWall(blockMeta[wallFace.block], wallFace.side, wallFace.x, wallFace.y, 1, 1);
+        }
+    }
+
+    void LevelRenderData::addMergedWallFaces(const WallFace *wallFaces, Size wallFaceCount) {
+        walls.clear();
 
-                if (block.is(Block::Type::Wall)) {
-                    addWall(block, x, y);
+        const Block::Meta &blockMeta = level.getBlockMeta();
+        const Int32 width = level.getWidth();
+        const Int32 height = level.getHeight();
+        const Uint16 empty = 0xffff;
+        std::vector<Uint16> grid(Size(width) * height);
+
+        for (Uint8 side = WallFace::Front; side <= WallFace::Bottom; side++) {
+            std::fill(grid.begin(), grid.end(), empty);
+            for (Size i = 0; i < wallFaceCount; i++) {
+                if (wallFaces[i].side == side) {
+                    grid[wallFaces[i].y * width + wallFaces[i].x] = wallFaces[i].block;
+                }
+            }
+
+            // Side faces of neighbouring blocks only share a plane along the side itself
+            bool alongX = side == WallFace::Front || side == WallFace::Top || side == WallFace::Bottom;
+            bool alongY = side == WallFace::Front || side == WallFace::Left || side == WallFace::Right;
+
+            for (Int32 y = 0; y < height; y++) {
+                for (Int32 x = 0; x < width; x++) {
+                    Uint16 block = grid[y * width + x];
+                    if (block == empty) {
+                        continue;
+                    }
+
+                    Int32 faceWidth = 1;
+                    while (alongX && x + faceWidth < width && grid[y * width + x + faceWidth] == block) {
+                        faceWidth++;
+                    }
+
+                    Int32 faceHeight = 1;
+                    while (alongY && y + faceHeight < height &&
+                           std::all_of(&grid[(y + faceHeight) * width + x],
+                                       &grid[(y + faceHeight) * width + x + faceWidth],
+                                       [block](Uint16 cell) { return cell == block; })) {
+                        faceHeight++;
+                    }
+
+                    for (Int32 row = y; row < y + faceHeight; row++) {
+                        std::fill_n(&grid[row * width + x], faceWidth, empty);
+                    }
+                    addWall(blockMeta[block], side, x, y, faceWidth, faceHeight);
                 }
             }
         }
+    }
 
-        walls.build(renderer);
+    void LevelRenderData::findWallFaces(Int32 width, Int32 height, const Uint16 *blocks,
+                                        const Block::Meta &blockMeta, ScreenMode screenMode,
+                                        std::vector<WallFace> &wallFaces) {
+        auto isWall = [width, height, blocks, &blockMeta](Int32 x, Int32 y) {
+            if (x < 0 || x >= width || y < 0 || y >= height) {
+                return false;
+            }
+            return blockMeta[blocks[(height - y - 1) * width + x]].is(Block::Type::Wall);
+        };
+
+        bool splitScreen = screenMode == ScreenMode::SplitScreen;
+        for (Int32 y = 0; y < height; y++) {
+            for (Int32 x = 0; x < width; x++) {
+                if (!isWall(x, y)) {
+                    continue;
+                }
+
+                Uint16 block = blocks[(height - y - 1) * width + x];
+                bool left = splitScreen || x > width / 2;
+                bool right = splitScreen || x < width / 2;
+                bool top = splitScreen || y < height / 2;
+                bool bottom = splitScreen || y > height / 2;
+
+                wallFaces.push_back(WallFace{Uint16(x), Uint16(y), block, WallFace::Front, 0});
+                if (left && !isWall(x - 1, y)) {
+                    wallFaces.push_back(WallFace{Uint16(x), Uint16(y), block, WallFace::Left, 0});
+                }
+                if (right && !isWall(x + 1, y)) {
+                    wallFaces.push_back(WallFace{Uint16(x), Uint16(y), block, WallFace::Right, 0});
+                }
+                if (top && !isWall(x, y + 1)) {
+                    wallFaces.push_back(WallFace{Uint16(x), Uint16(y), block, WallFace::Top, 0});
+                }
+                if (bottom && !isWall(x, y - 1)) {
+                    wallFaces.push_back(WallFace{Uint16(x), Uint16(y), block, WallFace::Bottom, 0});
+                }
+            }
+        }
     }
 
     void LevelRenderData::addSpriteFaces() {
@@ -96,100 +251,206 @@ namespace Duel6 {
                 }
             }
         }
+    }
 
-        sprites.build(renderer);
+    void LevelRenderData::addWaterFaces(FaceList &faceList) {
+        faceList.clear();
+
+        // Unlike walls, water is generated chunk by chunk and each chunk gets spare faces for the water to rise
+        for (Size i = 0; i < chunks.size(); i++) {
+            Chunk &chunk = chunks[i];
+            chunk.water.first = faceList.getFaces().size();
+            addWaterChunk(faceList, i);
+            chunk.water.count = faceList.getFaces().size() - chunk.water.first;
+            chunk.waterCapacity = chunk.water.count + WATER_HEADROOM;
+            addWaterPadding(faceList, WATER_HEADROOM);
+        }
     }
 
-    void LevelRenderData::addWaterFaces() {
-        water.clear();
+    void LevelRenderData::addWaterChunk(FaceList &faceList, Size chunk) {
+        Int32 fromX = Int32(chunk % chunksX) * chunkSize;
+        Int32 fromY = Int32(chunk / chunksX) * chunkSize;
+        Int32 toX = std::min(fromX + chunkSize, level.getWidth());
+        Int32 toY = std::min(fromY + chunkSize, level.getHeight());
 
-        for (Int32 y = 0; y < level.getHeight(); y++) {
-            for (Int32 x = 0; x < level.getWidth(); x++) {
+        for (Int32 y = fromY; y < toY; y++) {
+            for (Int32 x = fromX; x < toX; x++) {
                 const Block &block = level.getBlockMeta(x, y);
 
                 if (block.is(Block::Type::Waterfall)) {
-                    addSprite(water, block, x, y, 0.75);
+                    addSprite(faceList, block, x, y, 0.75);
                 } else if (block.is(Block::Type::Water)) {
-                    addWater(block, x, y);
+                    addWater(faceList, block, x, y);
                 }
             }
         }
+    }
 
-        water.build(renderer);
+    void LevelRenderData::addWaterPadding(FaceList &faceList, Size count) {
+        // Hidden faces without any area, they only hold the place for water faces to come
+        const Block &block = level.getBlockMeta().front();
+        for (Size i = 0; i < count; i++) {
+            faceList.addFace(Face(block).hide())
+                    .addVertex(Vertex(0, 0, 0, 0))
+                    .addVertex(Vertex(1, 0, 0, 0))
+                    .addVertex(Vertex(2, 0, 0, 0))
+                    .addVertex(Vertex(3, 0, 0, 0));
+        }
     }
 
-    void LevelRenderData::addWall(const Block &block, Int32 x, Int32 y) {
-        Int32 width = level.getWidth();
-        Int32 height = level.getHeight();
-        bool splitScreen = screenMode == ScreenMode::SplitScreen;
-        bool left = splitScreen || x > width / 2;
-        bool right = splitScreen || x < width / 2;
-        bool top = splitScreen || y < height / 2;
-        bool bottom = splitScreen || y > height / 2;
-
-        walls.addFace(Face(block))
-                .addVertex(Vertex(0, x, y + 1, 1))
-                .addVertex(Vertex(1, x + 1, y + 1, 1))
-                .addVertex(Vertex(2, x + 1, y, 1))
-                .addVertex(Vertex(3, x, y, 1));
+    void LevelRenderData::makeChunks(Int32 size) {
+        chunkSize = size;
+        chunksX = (level.getWidth() + chunkSize - 1) / chunkSize;
+        Int32 chunksY = (level.getHeight() + chunkSize - 1) / chunkSize;
+
+        chunks.clear();
+        for (Int32 y = 0; y < chunksY; y++) {
+            for (Int32 x = 0; x < chunksX; x++) {
+                Vector corner(Float32(x * chunkSize), Float32(y * chunkSize));
+                Rectangle bounds = Rectangle::fromCornerAndSize(corner, Vector(chunkSize, chunkSize));
+                chunks.push_back(Chunk{bounds, {0, 0}, {0, 0}, {0, 0}, 0});
+            }
+        }
+    }
+
+    void LevelRenderData::groupFacesByChunk(FaceList &faceList, FaceList::Range Chunk::*range) {
+        Int32 chunksY = Int32(chunks.size()) / chunksX;
+        std::vector<Face> &faces = faceList.getFaces();
+        std::vector<Vertex> &vertexes = faceList.getVertexes();
 
+        std::vector<Size> faceChunks(faces.size());
+        for (Size i = 0; i < faces.size(); i++) {
+            const Vertex *vertex = &vertexes[4 * i];
+            Vector min(vertex->x, vertex->y);
+            Vector max = min;
+            for (Size j = 1; j < 4; j++) {
+                min = Vector::min(min, Vector(vertex[j].x, vertex[j].y));
+                max = Vector::max(max, Vector(vertex[j].x, vertex[j].y));
+            }
+
+            Int32 x = std::min(std::max(Int32(min.x) / chunkSize, 0), chunksX - 1);
+            Int32 y = std::min(std::max(Int32(min.y) / chunkSize, 0), chunksY - 1);
+            Size index = Size(y * chunksX + x);
+            faceChunks[i] = index;
+
+            Chunk &chunk = chunks[index];
+            chunk.bounds = Rectangle::fromCorners(Vector::min(chunk.bounds.left, min),
+                                                  Vector::max(chunk.bounds.right, max));
+            (chunk.*range).count++;
+        }
+
+        // Counting sort keeps the original order of faces within a chunk
+        std::vector<Size> next(chunks.size());
+        Size first = 0;
+        for (Size i = 0; i < chunks.size(); i++) {
+            (chunks[i].*range).first = first;
+            next[i] = first;
+            first += (chunks[i].*range).count;
+        }
+
+        std::vector<Size> order(faces.size());
+        for (Size i = 0; i < faces.size(); i++) {
+            order[next[faceChunks[i]]++] = i;
+        }
+
+        std::vector<Face> sortedFaces;
+        std::vector<Vertex> sortedVertexes;
+        sortedFaces.reserve(faces.size());
+        sortedVertexes.reserve(vertexes.size());
+        for (Size i : order) {
+            sortedFaces.push_back(faces[i]);
+            sortedVertexes.insert(sortedVertexes.end(), vertexes.begin() + 4 * i, vertexes.begin() + 4 * (i + 1));
+        }
+        faces.swap(sortedFaces);
+        vertexes.swap(sortedVertexes);
+    }
+
+    void LevelRenderData::addWall(const Block &block, Uint8 side, Int32 x, Int32 y, Int32 width, Int32 height) {
+        Int32 x2 = x + width;
+        Int32 y2 = y + height;
+
+        switch (side) {
+            case WallFace::Front:
+                walls.addFace(Face(block))
+                        .addVertex(Vertex(0, x, y2, 1))
+                        .addVertex(Vertex(1, x2, y2, 1))
+                        .addVertex(Vertex(2, x2, y, 1))
+                        .addVertex(Vertex(3, x, y, 1));
+                tileLastWall(width, height);
 
 #ifdef D6_RENDER_BACKS
-        faceList.addFace(Face(block))
-            .addVertex(Vertex(0, x + 1, y + 1, 0))
-            .addVertex(Vertex(1, x, y + 1, 0))
-            .addVertex(Vertex(2, x, y, 0))
-            .addVertex(Vertex(3, x + 1, y, 0));
+                walls.addFace(Face(block))
+                        .addVertex(Vertex(0, x2, y2, 0))
+                        .addVertex(Vertex(1, x, y2, 0))
+                        .addVertex(Vertex(2, x, y, 0))
+                        .addVertex(Vertex(3, x2, y, 0));
+                tileLastWall(width, height);
 #endif
+                break;
+            case WallFace::Left:
+                walls.addFace(Face(block))
+                        .addVertex(Vertex(0, x, y2, 0))
+                        .addVertex(Vertex(1, x, y2, 1))
+                        .addVertex(Vertex(2, x, y, 1))
+                        .addVertex(Vertex(3, x, y, 0));
+                tileLastWall(1, height);
+                break;
+            case WallFace::Right:
+                walls.addFace(Face(block))
+                        .addVertex(Vertex(0, x2, y2, 1))
+                        .addVertex(Vertex(1, x2, y2, 0))
+                        .addVertex(Vertex(2, x2, y, 0))
+                        .addVertex(Vertex(3, x2, y, 1));
+                tileLastWall(1, height);
+                break;
+            case WallFace::Top:
+                walls.addFace(Face(block))
+                        .addVertex(Vertex(0, x, y2, 1))
+                        .addVertex(Vertex(1, x, y2, 0))
+                        .addVertex(Vertex(2, x2, y2, 0))
+                        .addVertex(Vertex(3, x2, y2, 1));
+                tileLastWall(1, width);
+                break;
+            case WallFace::Bottom:
+                walls.addFace(Face(block))
+                        .addVertex(Vertex(0, x, y, 1))
+                        .addVertex(Vertex(1, x2, y, 1))
+                        .addVertex(Vertex(2, x2, y, 0))
+                        .addVertex(Vertex(3, x, y, 0));
+                tileLastWall(width, 1);
+                break;
+        }
+    }
+
+    void LevelRenderData::tileLastWall(Int32 uBlocks, Int32 vBlocks) {
+        if (uBlocks == 1 && vBlocks == 1) {
+            return;
+        }
 
-        if (left && !level.isWall(x - 1, y, false)) {
-            walls.addFace(Face(block))
-                    .addVertex(Vertex(0, x, y + 1, 0))
-                    .addVertex(Vertex(1, x, y + 1, 1))
-                    .addVertex(Vertex(2, x, y, 1))
-                    .addVertex(Vertex(3, x, y, 0));
-        }
-        if (right && !level.isWall(x + 1, y, false)) {
-            walls.addFace(Face(block))
-                    .addVertex(Vertex(0, x + 1, y + 1, 1))
-                    .addVertex(Vertex(1, x + 1, y + 1, 0))
-                    .addVertex(Vertex(2, x + 1, y, 0))
-                    .addVertex(Vertex(3, x + 1, y, 1));
-        }
-        if (top && !level.isWall(x, y + 1, false)) {
-            walls.addFace(Face(block))
-                    .addVertex(Vertex(0, x, y + 1, 1))
-                    .addVertex(Vertex(1, x, y + 1, 0))
-                    .addVertex(Vertex(2, x + 1, y + 1, 0))
-                    .addVertex(Vertex(3, x + 1, y + 1, 1));
-        }
-        if (bottom && !level.isWall(x, y - 1, false)) {
-            walls.addFace(Face(block))
-                    .addVertex(Vertex(0, x, y, 1))
-                    .addVertex(Vertex(1, x + 1, y, 1))
-                    .addVertex(Vertex(2, x + 1, y, 0))
-                    .addVertex(Vertex(3, x, y, 0));
-        }
-    }
-
-    void LevelRenderData::addWater(const Block &block, Int32 x, Int32 y) {
+        auto &vertexes = walls.getVertexes();
+        for (auto vertex = vertexes.end() - 4; vertex != vertexes.end(); ++vertex) {
+            vertex->tile(Float32(uBlocks), Float32(vBlocks));
+        }
+    }
+
+    void LevelRenderData::addWater(FaceList &faceList, const Block &block, Int32 x, Int32 y) {
         bool topWater = !level.isWater(x, y + 1);
         Vertex::Flag flowFlag = topWater ? Vertex::Flag::Flow : Vertex::Flag::None;
 
-        water.addFace(Face(block))
+        faceList.addFace(Face(block))
                 .addVertex(Vertex(0, x, y + 1, 1, flowFlag))
                 .addVertex(Vertex(1, x + 1, y + 1, 1, flowFlag))
                 .addVertex(Vertex(2, x + 1, y, 1))
                 .addVertex(Vertex(3, x, y, 1));
 
-        water.addFace(Face(block))
+        faceList.addFace(Face(block))
                 .addVertex(Vertex(0, x + 1, y + 1, 0, flowFlag))
                 .addVertex(Vertex(1, x, y + 1, 0, flowFlag))
                 .addVertex(Vertex(2, x, y, 0))
                 .addVertex(Vertex(3, x + 1, y, 0));
 
         if (topWater) {
-            water.addFace(Face(block))
+            faceList.addFace(Face(block))
                     .addVertex(Vertex(0, x, y + 1, 1, Vertex::Flag::Flow))
                     .addVertex(Vertex(1, x, y + 1, 0, Vertex::Flag::Flow))
                     .addVertex(Vertex(2, x + 1, y + 1, 0, Vertex::Flag::Flow))
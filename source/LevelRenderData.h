@@ -28,34 +28,97 @@
 #ifndef DUEL6_LEVELRENDERDATA_H
 #define DUEL6_LEVELRENDERDATA_H
 
+#include <vector>
 #include "Type.h"
 #include "FaceList.h"
 #include "Level.h"
 #include "ScreenMode.h"
+#include "Rectangle.h"
+#include "ViewCulling.h"
 
 namespace Duel6 {
     class LevelRenderData {
+    public:
+        /**
+         * Visible side of a wall block, stored as plain data so it can be precomputed and cached.
+         */
+        struct WallFace {
+            enum Side : Uint8 {
+                Front,
+                Left,
+                Right,
+                Top,
+                Bottom
+            };
+
+            Uint16 x;
+            Uint16 y;
+            Uint16 block;
+            Uint8 side;
+            Uint8 reserved;
+        };
+
+        static const Int32 CHUNK_SIZE = 16;
+
+        /**
+         * Square of CHUNK_SIZE x CHUNK_SIZE blocks. Faces are grouped by the chunk their bottom left corner lies in,
+         * so the faces of a chunk are one run in each list and are drawn, skipped or rebuilt together.
+         */
+        struct Chunk {
+            Rectangle bounds; // Of all faces of the chunk, merged walls may reach into the next chunks
+            FaceList::Range walls;
+            FaceList::Range sprites;
+            FaceList::Range water;
+            Size waterCapacity; // Faces reserved for water of the chunk, the ones past the water range are not drawn
+        };
+
     private:
+        // Spare water faces reserved in each chunk, room for about two more flooded rows
+        static const Size WATER_HEADROOM = 4 * CHUNK_SIZE;
+
         const Level &level;
         Renderer &renderer;
         ScreenMode screenMode;
         FaceList walls;
         FaceList sprites;
         FaceList water;
+        std::vector<Chunk> chunks; // Row by row from the bottom left one
         Float32 animationSpeed;
         Float32 animWait;
         Float32 waveHeight;
+        Int32 chunkSize;
+        Int32 chunksX;
 
     public:
         LevelRenderData(const Level &level, Renderer &renderer, ScreenMode screenMode, Float32 animationSpeed,
                         Float32 waveHeight);
 
-        void generateFaces();
+        /**
+         * Generates all faces without touching the renderer, safe to call off the main thread.
+         * With mergeWalls, coplanar neighbouring wall faces of the same block are joined into larger quads.
+         * Without chunked, the whole level is a single chunk and each list one monolithic mesh.
+         */
+        void prepareFaces(const WallFace *wallFaces, Size wallFaceCount, bool mergeWalls, bool chunked = true);
+
+        /**
+         * Uploads the prepared faces to renderer buffers.
+         */
+        void build();
 
-        void generateWater();
+        /**
+         * Regenerates water faces of the chunks containing the given rows, e.g. after the water level has risen.
+         * Only the slots of these chunks are uploaded unless some of them runs out of spare faces.
+         */
+        void updateWaterRows(Int32 fromY, Int32 toY);
 
         void update(Float32 elapsedTime);
 
+        /**
+         * Finds the visible wall sides of a block grid stored in level file order (top row first).
+         */
+        static void findWallFaces(Int32 width, Int32 height, const Uint16 *blocks, const Block::Meta &blockMeta,
+                                  ScreenMode screenMode, std::vector<WallFace> &wallFaces);
+
         FaceList &getWalls() {
             return walls;
         }
@@ -80,16 +143,39 @@ namespace Duel6 {
             return water;
         }
 
+        const std::vector<Chunk> &getChunks() const {
+            return chunks;
+        }
+
+        /**
+         * Collects runs of faces of the chunks the view can see, runs of neighbouring chunks are joined.
+         */
+        void findVisibleFaces(ViewCulling &culling, std::vector<FaceList::Range> &wallRanges,
+                              std::vector<FaceList::Range> &spriteRanges,
+                              std::vector<FaceList::Range> &waterRanges) const;
+
     private:
-        void addWallFaces();
+        void addWallFaces(const WallFace *wallFaces, Size wallFaceCount);
+
+        void addMergedWallFaces(const WallFace *wallFaces, Size wallFaceCount);
 
         void addSpriteFaces();
 
-        void addWaterFaces();
+        void addWaterFaces(FaceList &faceList);
+
+        void makeChunks(Int32 size);
+
+        void groupFacesByChunk(FaceList &faceList, FaceList::Range Chunk::*range);
+
+        void addWall(const Block &block, Uint8 side, Int32 x, Int32 y, Int32 width, Int32 height);
+
+        void tileLastWall(Int32 uBlocks, Int32 vBlocks);
+
+        void addWaterChunk(FaceList &faceList, Size chunk);
 
-        void addWall(const Block &block, Int32 x, Int32 y);
+        void addWaterPadding(FaceList &faceList, Size count);
 
-        void addWater(const Block &block, Int32 x, Int32 y);
+        void addWater(FaceList &faceList, const Block &block, Int32 x, Int32 y);
 
         void addSprite(FaceList &faceList, const Block &block, Int32 x, Int32 y, Float32 z);
     };
@@ -0,0 +1,114 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "MappedFile.h"
+#include "IoException.h"
+
+namespace Duel6 {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &path)
+            : data(nullptr), size(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            D6_THROW(IoException, "Unable to open file: " + path);
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            CloseHandle(fileHandle);
+            D6_THROW(IoException, "Unable to determine size of file: " + path);
+        }
+        size = Size(fileSize.QuadPart);
+        if (size == 0) {
+            return;
+        }
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle != nullptr) {
+            data = (const Uint8 *) MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        }
+        if (data == nullptr) {
+            if (mappingHandle != nullptr) {
+                CloseHandle(mappingHandle);
+            }
+            CloseHandle(fileHandle);
+            D6_THROW(IoException, "Unable to map file: " + path);
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (mappingHandle != nullptr) {
+            CloseHandle(mappingHandle);
+        }
+        CloseHandle(fileHandle);
+    }
+#else
+    MappedFile::MappedFile(const std::string &path)
+            : data(nullptr), size(0), fileHandle(-1) {
+        fileHandle = open(path.c_str(), O_RDONLY);
+        if (fileHandle < 0) {
+            D6_THROW(IoException, "Unable to open file: " + path);
+        }
+
+        struct stat fileStat;
+        if (fstat(fileHandle, &fileStat) != 0) {
+            close(fileHandle);
+            D6_THROW(IoException, "Unable to determine size of file: " + path);
+        }
+        size = Size(fileStat.st_size);
+        if (size == 0) {
+            return;
+        }
+
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileHandle, 0);
+        if (mapping == MAP_FAILED) {
+            close(fileHandle);
+            D6_THROW(IoException, "Unable to map file: " + path);
+        }
+        data = (const Uint8 *) mapping;
+    }
+
+    MappedFile::~MappedFile() {
+        if (data != nullptr) {
+            munmap((void *) data, size);
+        }
+        close(fileHandle);
+    }
+#endif
+}
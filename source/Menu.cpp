@@ -349,7 +349,7 @@ namespace Duel6 {
     }
 
     void Menu::showMessage(const std::string &message) {
-        Int32 width = Int32(message.size()) * 8 + 60;
+        Int32 width = font.getTextWidth(message, font.getCharHeight()) + 60;
         Int32 x = video.getScreen().getClientWidth() / 2 - width / 2,
                 y = video.getScreen().getClientHeight() / 2 - 10;
 
@@ -565,7 +565,7 @@ namespace Duel6 {
         gui.update(elapsedTime);
     }
 
-    void Menu::render() const {
+    void Menu::render() {
         Int32 trX = (video.getScreen().getClientWidth() - 800) / 2;
         Int32 trY = (video.getScreen().getClientHeight() - 700) / 2;
 
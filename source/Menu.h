@@ -114,7 +114,7 @@ namespace Duel6 {
 
         void update(Float32 elapsedTime) override;
 
-        void render() const override;
+        void render() override;
 
         void enableMusic(bool enable);
 
@@ -28,6 +28,7 @@
 #include <cmath>
 #include "Person.h"
 #include "Format.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
     Person &Person::reset() {
@@ -94,4 +95,18 @@ namespace Duel6 {
         auto kd_float = (Int32)((kd - kd_int) * 100);
         return Format("{0,2}.{1,2|0}") << kd_int << kd_float;
     }
+
+    void Person::saveState(BinaryWriter &writer) const {
+        for (Int32 value : {shots, hits, kills, deaths, assistances, wins, penalties, games, timeAlive, totalGameTime,
+                            totalDamage, assistedDamage, elo, eloTrend, eloGames}) {
+            writer.write(value);
+        }
+    }
+
+    void Person::restoreState(BinaryReader &reader) {
+        for (Int32 *value : {&shots, &hits, &kills, &deaths, &assistances, &wins, &penalties, &games, &timeAlive,
+                             &totalGameTime, &totalDamage, &assistedDamage, &elo, &eloTrend, &eloGames}) {
+            reader.read(*value);
+        }
+    }
 }
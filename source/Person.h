@@ -37,6 +37,10 @@
 namespace Duel6 {
     class PersonProfile;
 
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class Person {
     public:
         static constexpr Int32 defaultElo = 1000;
@@ -250,6 +254,11 @@ namespace Duel6 {
 
         Person &reset();
 
+        // Statistics only, the name and profile do not change during a game
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
+
         Json::Value toJson() const;
 
         static Person fromJson(const Json::Value &json);
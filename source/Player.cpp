@@ -39,6 +39,7 @@
 #include "math/Math.h"
 #include "Video.h"
 #include "PlayerEventListener.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
     //TODO: This still needs further fine-tuning for good jumping experience
@@ -65,6 +66,7 @@ namespace Duel6 {
     void Player::startRound(World &world, Int32 startBlockX, Int32 startBlockY, Int32 ammo, const Weapon &weapon) {
         this->world = &world;
         collider.initPosition(Float32(startBlockX), Float32(startBlockY) + 0.0001f);
+        previousPosition = getPosition();
 
         sprite = world.getSpriteList().add(animations.getStand().get(), skin.getTexture());
         sprite->setPosition(getSpritePosition(), 0.5f);
@@ -73,7 +75,7 @@ namespace Duel6 {
         gunSprite = weapon.makeSprite(world.getSpriteList());
 
         flags = FlagHasGun;
-        orientation = Math::random(2) == 0 ? Orientation::Left : Orientation::Right;
+        orientation = world.getRandom().random(2) == 0 ? Orientation::Left : Orientation::Right;
         timeToReload = weapon.isChargeable() ? getReloadInterval() : 0;
         life = D6_MAX_LIFE;
         air = D6_MAX_AIR;
@@ -567,6 +569,20 @@ namespace Duel6 {
         if (screenMode == ScreenMode::SplitScreen) {
             updateCam(levelSizeX, levelSizeY);
         }
+        previousCameraPosition = camera.getPosition();
+    }
+
+    Vector Player::getCameraPosition(Float32 interpolation) const {
+        return previousCameraPosition + (camera.getPosition() - previousCameraPosition) * interpolation;
+    }
+
+    Rectangle Player::getVisibleArea(Float32 interpolation) const {
+        // The field of view is set up for the front of the blocks at z = 1
+        Vector position = getCameraPosition(interpolation);
+        Float32 scale = position.z / (position.z - 1.0f);
+        Vector halfSize(cameraFov.x * scale, cameraFov.y * scale);
+        return Rectangle::fromCorners(Vector(position.x, position.y) - halfSize,
+                                      Vector(position.x, position.y) + halfSize);
     }
 
     void Player::updateCam(Int32 levelSizeX, Int32 levelSizeY) {
@@ -741,8 +757,8 @@ namespace Duel6 {
         }
     }
 
-    void Player::useTemporarySkin(PlayerSkin &tempSkin) {
-        tempSkinDuration = Float32(10 + Math::random(5));
+    void Player::useTemporarySkin(PlayerSkin &tempSkin, Random &random) {
+        tempSkinDuration = Float32(10 + random.random(5));
         sprite->setTexture(tempSkin.getTexture());
     }
 
@@ -812,4 +828,62 @@ namespace Duel6 {
     const CollidingEntity &Player::getCollider() const {
         return collider;
     }
+
+    void Player::saveState(BinaryWriter &writer) const {
+        person.saveState(writer);
+        writer.writeIndex(Water::values(), water.headUnderWater);
+        writer.writeIndex(Water::values(), water.feetInWater);
+        world->getSpriteList().saveHandle(writer, sprite);
+        world->getSpriteList().saveHandle(writer, gunSprite);
+        writer.write(flags);
+        writer.write(orientation);
+        writer.write(life);
+        writer.write(air);
+        writer.write(ammo);
+        writer.writeIndex(BonusType::values(), bonus);
+        writer.write(roundKills);
+        writer.write(timeToReload);
+        writer.write(bonusRemainingTime);
+        writer.write(bonusDuration);
+        writer.write(timeSinceHit);
+        writer.write(timeStuckInWall);
+        writer.write(tempSkinDuration);
+        writer.write(alpha);
+        writer.writeIndex(Weapon::values(), weapon);
+        writer.write(bodyAlpha);
+        writer.write(indicators);
+        writer.write(controllerState);
+        collider.saveState(writer, world->getElevatorList());
+        writer.write(camera);
+    }
+
+    void Player::restoreState(BinaryReader &reader) {
+        person.restoreState(reader);
+        water.headUnderWater = reader.readIndex(Water::values(), Water::NONE);
+        water.feetInWater = reader.readIndex(Water::values(), Water::NONE);
+        sprite = world->getSpriteList().restoreHandle(reader);
+        gunSprite = world->getSpriteList().restoreHandle(reader);
+        reader.read(flags);
+        reader.read(orientation);
+        reader.read(life);
+        reader.read(air);
+        reader.read(ammo);
+        bonus = reader.readIndex(BonusType::values(), BonusType::NONE);
+        reader.read(roundKills);
+        reader.read(timeToReload);
+        reader.read(bonusRemainingTime);
+        reader.read(bonusDuration);
+        reader.read(timeSinceHit);
+        reader.read(timeStuckInWall);
+        reader.read(tempSkinDuration);
+        reader.read(alpha);
+        weapon = reader.readIndex(Weapon::values(), weapon);
+        reader.read(bodyAlpha);
+        reader.read(indicators);
+        reader.read(controllerState);
+        collider.restoreState(reader, world->getElevatorList());
+        previousPosition = getPosition();
+        reader.read(camera);
+        previousCameraPosition = camera.getPosition();
+    }
 }
@@ -62,8 +62,14 @@ namespace Duel6 {
 
     class InfoMessageQueue;
 
+    class Random;
+
     class PlayerEventListener;
 
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class Player {
     private:
         enum Flags {
@@ -105,6 +111,8 @@ namespace Duel6 {
         Person &person;
         PlayerSkin skin;
         Camera camera;
+        Vector previousCameraPosition; // After the previous update, for interpolation
+        Vector previousPosition;
         Vector cameraFov;
         Vector cameraTolerance;
         const PlayerAnimations &animations;
@@ -112,8 +120,8 @@ namespace Duel6 {
         const PlayerControls &controls;
         PlayerView view;
         WaterState water;
-        SpriteList::Iterator sprite;
-        SpriteList::Iterator gunSprite;
+        SpriteList::Handle sprite;
+        SpriteList::Handle gunSprite;
         Uint32 flags;
         Orientation orientation;
         Float32 life;
@@ -189,6 +197,15 @@ namespace Duel6 {
             return collider.getCollisionRect();
         }
 
+        /**
+         * Collision rectangle between the last two updates, anchors the indicators drawn around the player.
+         */
+        Rectangle getCollisionRect(Float32 interpolation) const {
+            Rectangle rect = getCollisionRect();
+            Vector offset = (getPosition() - previousPosition) * (interpolation - 1.0f);
+            return Rectangle::fromCorners(rect.left + offset, rect.right + offset);
+        }
+
         Vector getSpritePosition() const {
             return getPosition();
         }
@@ -225,6 +242,24 @@ namespace Duel6 {
             return camera;
         }
 
+        /**
+         * Camera position between the last two updates, see Video::getInterpolation.
+         */
+        Vector getCameraPosition(Float32 interpolation) const;
+
+        /**
+         * Part of the level the camera sees at the back of the blocks (z = 0), which is wider than at their front.
+         */
+        Rectangle getVisibleArea(Float32 interpolation) const;
+
+        /**
+         * Remembers the camera and player positions before an update moves them.
+         */
+        void storePreviousPositions() {
+            previousCameraPosition = camera.getPosition();
+            previousPosition = getPosition();
+        }
+
         const Weapon &getWeapon() const {
             return weapon;
         }
@@ -296,7 +331,7 @@ namespace Duel6 {
             return *this;
         }
 
-        void useTemporarySkin(PlayerSkin &tempSkin);
+        void useTemporarySkin(PlayerSkin &tempSkin, Random &random);
 
         Player &pickWeapon(Weapon weapon, Int32 bullets, Float32 remainingReloadTime);
 
@@ -402,10 +437,26 @@ namespace Duel6 {
             controllerState |= button;
         }
 
+        Uint32 getControllerState() const {
+            return controllerState;
+        }
+
+        void setControllerState(Uint32 state) {
+            controllerState = state;
+        }
+
         void die();
 
         const CollidingEntity &getCollider() const;
 
+        /**
+         * Saves the state the player has during a round, together with the statistics of the person.
+         * Sprites and elevators are referred to by handles of the world the round was started in.
+         */
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
+
     private:
         void makeMove(const Level &level, Float32 elapsedTime);
 
@@ -56,6 +56,11 @@ namespace Duel6 {
 
     Texture PlayerAnimations::generateAnimationTexture(const TextureManager &textureManager,
                                                        const PlayerSkinColors &colors) const {
+        return textureManager.createTexture(generateAnimationImage(textureManager, colors), TextureFilter::Nearest, true);
+    }
+
+    Image PlayerAnimations::generateAnimationImage(const TextureManager &textureManager,
+                                                   const PlayerSkinColors &colors) const {
         animation::Palette substitution_table(animation.palette);
         int dst[] = {4, 5, 8, 9, 12, 13, 16, 20, 24, 25, 36, 37}; //indexes to palette colors used in the man.ase
         int src[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 10};
@@ -74,7 +79,7 @@ namespace Duel6 {
         view.setLayerVisibility("Hair_Short", colors.getHair() == PlayerSkinColors::Hair::Short);
         view.setLayerVisibility("Headband", colors.hasHeadBand());
 
-        return textureManager.generateSprite(animation, view, substitution_table, TextureFilter::Nearest, true);
+        return textureManager.composeSprite(animation, view, substitution_table);
     }
 
     const PlayerAnimation &PlayerAnimations::getStand() const {
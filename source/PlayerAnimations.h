@@ -64,6 +64,11 @@ namespace Duel6 {
 
         Texture generateAnimationTexture(const TextureManager &textureManager, const PlayerSkinColors &colors) const;
 
+        /**
+         * Composites the skin image without creating a texture, safe to call from any thread.
+         */
+        Image generateAnimationImage(const TextureManager &textureManager, const PlayerSkinColors &colors) const;
+
         const PlayerAnimation &getStand() const;
 
         const PlayerAnimation &getWalk() const;
@@ -37,6 +37,11 @@ namespace Duel6 {
           textures(animations.generateAnimationTexture(textureManager, colors)) {
     }
 
+    PlayerSkin::PlayerSkin(Texture textures, const PlayerAnimations &animations)
+        : animations(animations),
+          textures(textures) {
+    }
+
     Texture PlayerSkin::getTexture() const {
         return textures;
     }
@@ -46,6 +46,8 @@ namespace Duel6 {
         PlayerSkin(const PlayerSkinColors &colors, const TextureManager &textureManager,
                    const PlayerAnimations &animations);
 
+        PlayerSkin(Texture textures, const PlayerAnimations &animations);
+
         Texture getTexture() const;
 
         const PlayerAnimations &getAnimations() const;
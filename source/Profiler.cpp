@@ -0,0 +1,194 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <SDL2/SDL.h>
+#include "File.h"
+#include "Format.h"
+#include "json/JsonWriter.h"
+#include "Profiler.h"
+
+namespace Duel6 {
+    namespace {
+        const char *sectionNames[Profiler::SECTIONS] = {
+                "tick", "players", "scripts", "world", "sprites", "explosions", "render_state", "shots", "elevators",
+                "messages", "bonuses"
+        };
+    }
+
+    Profiler::Timer::Timer(Profiler &profiler, Section section)
+            : profiler(profiler), section(section), start(profiler.enabled ? SDL_GetPerformanceCounter() : 0) {}
+
+    Profiler::Timer::~Timer() {
+        if (profiler.enabled) {
+            profiler.add(section, SDL_GetPerformanceCounter() - start);
+        }
+    }
+
+    Profiler::Tick::Tick(Profiler &profiler)
+            : profiler(profiler), start(profiler.enabled ? SDL_GetPerformanceCounter() : 0) {}
+
+    Profiler::Tick::~Tick() {
+        if (profiler.enabled) {
+            profiler.endTick(SDL_GetPerformanceCounter() - start);
+        }
+    }
+
+    Profiler::Profiler()
+            : enabled(false), counterToMicroseconds(1000000.0 / SDL_GetPerformanceFrequency()) {
+        reset();
+    }
+
+    Profiler &Profiler::enable(bool enable) {
+        if (enable && !enabled) {
+            reset();
+        }
+        enabled = enable;
+        return *this;
+    }
+
+    void Profiler::reset() {
+        current.fill(0);
+        samples.clear();
+        samples.reserve(WINDOW);
+        nextSample = 0;
+        ticks = 0;
+    }
+
+    void Profiler::endTick(Uint64 counter) {
+        add(Section::Tick, counter);
+
+        Sample sample;
+        for (Size i = 0; i < SECTIONS; i++) {
+            sample[i] = Float32(current[i] * counterToMicroseconds);
+        }
+        current.fill(0);
+
+        if (samples.size() < WINDOW) {
+            samples.push_back(sample);
+        } else {
+            samples[nextSample] = sample;
+        }
+        nextSample = (nextSample + 1) % WINDOW;
+        ticks++;
+    }
+
+    std::vector<Profiler::Sample> Profiler::getSamples() const {
+        if (samples.size() < WINDOW) {
+            return samples;
+        }
+
+        std::vector<Sample> ordered(samples.begin() + nextSample, samples.end());
+        ordered.insert(ordered.end(), samples.begin(), samples.begin() + nextSample);
+        return ordered;
+    }
+
+    Profiler::Stats Profiler::getStats(Section section) const {
+        Stats stats;
+        if (samples.empty()) {
+            return stats;
+        }
+
+        Size index = Size(section);
+        std::vector<Float32> values;
+        values.reserve(samples.size());
+        Float64 sum = 0;
+        for (const Sample &sample : samples) {
+            values.push_back(sample[index]);
+            sum += sample[index];
+        }
+
+        Size p99Index = (values.size() * 99) / 100;
+        std::nth_element(values.begin(), values.begin() + p99Index, values.end());
+        stats.p99 = values[p99Index];
+        stats.min = *std::min_element(values.begin(), values.end());
+        stats.avg = sum / values.size();
+        stats.last = samples[(nextSample + samples.size() - 1) % samples.size()][index];
+        return stats;
+    }
+
+    const char *Profiler::getName(Section section) {
+        return sectionNames[Size(section)];
+    }
+
+    std::string Profiler::formatTime(Float64 microseconds) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.1f", microseconds);
+        return buffer;
+    }
+
+    void Profiler::writeCsv(const std::string &path) const {
+        File file(path, File::Mode::Text, File::Access::Write);
+
+        std::string header = "tick";
+        for (const char *name : sectionNames) {
+            header += Format(",{0}") << name;
+        }
+        header += "\n";
+        file.write(header.c_str(), 1, header.size());
+
+        Uint64 tick = ticks - samples.size();
+        for (const Sample &sample : getSamples()) {
+            std::string line = Format("{0}") << tick++;
+            for (Float32 value : sample) {
+                line += Format(",{0}") << value;
+            }
+            line += "\n";
+            file.write(line.c_str(), 1, line.size());
+        }
+    }
+
+    void Profiler::writeJson(const std::string &path) const {
+        Json::Value json = Json::Value::makeObject();
+        json.set("unit", Json::Value::makeString("us"));
+        json.set("ticks", Json::Value::makeNumber(Float64(ticks)));
+
+        Json::Value sections = Json::Value::makeObject();
+        for (Size i = 0; i < SECTIONS; i++) {
+            Stats stats = getStats(Section(i));
+            Json::Value entry = Json::Value::makeObject();
+            entry.set("min", Json::Value::makeNumber(stats.min));
+            entry.set("avg", Json::Value::makeNumber(stats.avg));
+            entry.set("p99", Json::Value::makeNumber(stats.p99));
+            sections.set(sectionNames[i], entry);
+        }
+        json.set("sections", sections);
+
+        Json::Value trace = Json::Value::makeArray();
+        for (const Sample &sample : getSamples()) {
+            Json::Value row = Json::Value::makeArray();
+            for (Float32 value : sample) {
+                row.add(Json::Value::makeNumber(Float64(value)));
+            }
+            trace.add(row);
+        }
+        json.set("samples", trace);
+
+        Json::Writer writer(false);
+        writer.writeToFile(path, json);
+    }
+}
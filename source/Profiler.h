@@ -0,0 +1,153 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_PROFILER_H
+#define DUEL6_PROFILER_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include "Type.h"
+#include "TimeHistogram.h"
+
+namespace Duel6 {
+    /**
+     * Per-subsystem timing of the fixed-step game update. Every section accumulates its time during a tick,
+     * the totals are stored in a rolling window when the tick ends.
+     */
+    class Profiler {
+    public:
+        enum class Section : Size {
+            Tick,
+            Players,
+            Scripts,
+            World,
+            Sprites,
+            Explosions,
+            RenderState,
+            Shots,
+            Elevators,
+            Messages,
+            Bonuses
+        };
+
+        static constexpr Size SECTIONS = 11;
+        static constexpr Size WINDOW = 512;
+
+        struct Stats {
+            Float64 min = 0;
+            Float64 avg = 0;
+            Float64 p99 = 0;
+            Float64 last = 0;
+        };
+
+        // Adds time spent in the enclosing scope to a section
+        class Timer {
+        private:
+            Profiler &profiler;
+            Section section;
+            Uint64 start;
+
+        public:
+            Timer(Profiler &profiler, Section section);
+
+            ~Timer();
+        };
+
+        // Measures the whole tick and closes it when leaving the scope
+        class Tick {
+        private:
+            Profiler &profiler;
+            Uint64 start;
+
+        public:
+            explicit Tick(Profiler &profiler);
+
+            ~Tick();
+        };
+
+    private:
+        typedef std::array<Float32, SECTIONS> Sample;
+
+        bool enabled;
+        Float64 counterToMicroseconds;
+        std::array<Uint64, SECTIONS> current;
+        std::vector<Sample> samples;
+        Size nextSample;
+        Uint64 ticks;
+        TimeHistogram frameTimes;
+        TimeHistogram tickTimes;
+
+    public:
+        Profiler();
+
+        Profiler &enable(bool enable);
+
+        bool isEnabled() const {
+            return enabled;
+        }
+
+        void reset();
+
+        Uint64 getTicks() const {
+            return ticks;
+        }
+
+        // Stats of the rolling window in microseconds
+        Stats getStats(Section section) const;
+
+        static const char *getName(Section section);
+
+        static std::string formatTime(Float64 microseconds);
+
+        void writeCsv(const std::string &path) const;
+
+        void writeJson(const std::string &path) const;
+
+        // Time between presented frames, recorded also when the profiler is off
+        TimeHistogram &getFrameTimes() {
+            return frameTimes;
+        }
+
+        // Time of every fixed-step update including the ones run on the simulation thread
+        TimeHistogram &getTickTimes() {
+            return tickTimes;
+        }
+
+    private:
+        void add(Section section, Uint64 counter) {
+            current[Size(section)] += counter;
+        }
+
+        void endTick(Uint64 counter);
+
+        // Samples of the rolling window ordered from the oldest
+        std::vector<Sample> getSamples() const;
+    };
+}
+
+#endif
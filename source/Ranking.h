@@ -68,7 +68,7 @@ namespace Duel6 {
     public:
         Ranking() = default;
 
-        Int32 getMaxLength() {
+        Int32 getMaxLength() const {
             Int32 maxLength = 0;
             for (auto &entry : entries) {
                 maxLength = std::max(maxLength, Int32(entry.name.size()));
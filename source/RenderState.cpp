@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RenderState.h"
+#include "Game.h"
+#include "GameMode.h"
+
+namespace Duel6 {
+    namespace {
+        Rectangle interpolate(const Rectangle &previous, const Rectangle &current, Float32 interpolation) {
+            return Rectangle::fromCorners(previous.left + (current.left - previous.left) * interpolation,
+                                          previous.right + (current.right - previous.right) * interpolation);
+        }
+    }
+
+    Vector RenderState::PlayerState::getCameraPosition(Float32 interpolation) const {
+        return previousCameraPosition + (cameraPosition - previousCameraPosition) * interpolation;
+    }
+
+    Rectangle RenderState::PlayerState::getVisibleArea(Float32 interpolation) const {
+        // The camera keeps its distance from the level, so the area only moves with it
+        return interpolate(previousVisibleArea, visibleArea, interpolation);
+    }
+
+    Rectangle RenderState::PlayerState::getCollisionRect(Float32 interpolation) const {
+        return interpolate(previousCollisionRect, collisionRect, interpolation);
+    }
+
+    RenderState::RenderState()
+            : time(0), waterLevel(0), winner(false), over(false), remainingYouAreHere(0), remainingGameOverWait(0),
+              transparentBegin(0), messages(0) {}
+
+    void RenderState::capture(const Game &game) {
+        const Round &round = game.getRound();
+        const World &world = round.getWorld();
+
+        time = world.getTime();
+        waterLevel = world.getLevel().getWaterLevel();
+        winner = round.hasWinner();
+        over = game.isOver();
+        remainingYouAreHere = round.getRemainingYouAreHere();
+        remainingGameOverWait = round.getRemainingGameOverWait();
+        ranking = game.getMode().getRanking(game.getPlayers());
+
+        if (game.getSettings().isShowProfiler()) {
+            const Profiler &profiler = game.getAppService().getProfiler();
+            for (Size i = 0; i < Profiler::SECTIONS; i++) {
+                profilerStats[i] = profiler.getStats(Profiler::Section(i));
+            }
+        }
+
+        players.resize(game.getPlayers().size());
+        for (Size i = 0; i < players.size(); i++) {
+            const Player &player = game.getPlayers()[i];
+            PlayerState &state = players[i];
+            state.previousCameraPosition = player.getCameraPosition(0.0f);
+            state.cameraPosition = player.getCameraPosition(1.0f);
+            state.cameraFront = player.getCamera().getFront();
+            state.cameraUp = player.getCamera().getUp();
+            state.previousVisibleArea = player.getVisibleArea(0.0f);
+            state.visibleArea = player.getVisibleArea(1.0f);
+            state.previousCollisionRect = player.getCollisionRect(0.0f);
+            state.collisionRect = player.getCollisionRect(1.0f);
+            state.dimensions = player.getDimensions();
+            state.indicators = player.getIndicators();
+            state.reloadInterval = player.getReloadInterval();
+            state.reloadTime = player.getReloadTime();
+            state.air = player.getAir();
+            state.life = player.getLife();
+            state.bonusRemainingTime = player.getBonusRemainingTime();
+            state.bonusDuration = player.getBonusDuration();
+            state.bonusTextureIndex = player.getBonus().getTextureIndex();
+            state.ammo = player.getAmmo();
+            state.roundKills = player.getRoundKills();
+            state.alive = player.isAlive();
+            state.invulnerable = player.isInvulnerable();
+        }
+
+        world.getSpriteList().captureRenderState(*this);
+        world.getElevatorList().captureRenderState(*this);
+        world.getBonusList().captureRenderState(*this);
+        world.getExplosionList().captureRenderState(*this);
+        messages = world.getMessageQueue();
+    }
+}
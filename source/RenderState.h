@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_RENDERSTATE_H
+#define DUEL6_RENDERSTATE_H
+
+#include <array>
+#include <vector>
+#include "Type.h"
+#include "Rectangle.h"
+#include "Ranking.h"
+#include "Profiler.h"
+#include "PlayerIndicators.h"
+#include "InfoMessageQueue.h"
+#include "Explosion.h"
+#include "math/Vector.h"
+#include "renderer/RendererTypes.h"
+
+namespace Duel6 {
+    class Game;
+
+    /**
+     * Everything the world renderer draws that the updates change, captured at the end of each update and handed
+     * to the main thread in a triple buffer. Frames are drawn from it while the next updates run, so drawing never
+     * waits for the world lock. Moving things keep their positions from before and after the update, one state
+     * covers the last two updates. What stays the same for the whole round (level faces, player views and names)
+     * is read from the round itself.
+     */
+    class RenderState {
+    public:
+        struct PlayerState {
+            Vector previousCameraPosition;
+            Vector cameraPosition;
+            Vector cameraFront;
+            Vector cameraUp;
+            Rectangle previousVisibleArea = Rectangle::empty();
+            Rectangle visibleArea = Rectangle::empty();
+            Rectangle previousCollisionRect = Rectangle::empty();
+            Rectangle collisionRect = Rectangle::empty();
+            Vector dimensions;
+            PlayerIndicators indicators;
+            Float32 reloadInterval = 0;
+            Float32 reloadTime = 0;
+            Float32 air = 0;
+            Float32 life = 0;
+            Float32 bonusRemainingTime = 0;
+            Float32 bonusDuration = 0;
+            Int32 bonusTextureIndex = 0;
+            Int32 ammo = 0;
+            Int32 roundKills = 0;
+            bool alive = false;
+            bool invulnerable = false;
+
+            Vector getCameraPosition(Float32 interpolation) const;
+
+            Rectangle getVisibleArea(Float32 interpolation) const;
+
+            Rectangle getCollisionRect(Float32 interpolation) const;
+        };
+
+        struct SpriteState {
+            Vector previousPosition;
+            Vector position;
+            Vector size;
+            Vector rotationCentre;
+            Float32 z;
+            Float32 zRotation;
+            Float32 alpha;
+            Texture texture;
+            Int32 textureIndex;
+            BlendFunc blendFunc;
+            bool reversed;
+            bool noDepth;
+        };
+
+        struct ElevatorState {
+            Vector previousPosition;
+            Vector position;
+
+            Vector getPosition(Float32 interpolation) const {
+                return previousPosition + (position - previousPosition) * interpolation;
+            }
+        };
+
+        // Bonus or a lying weapon
+        struct BonusState {
+            Vector position;
+            Texture texture;
+            Int32 textureIndex;
+        };
+
+    public:
+        Float32 time;
+        Int32 waterLevel;
+        bool winner;
+        bool over; // The last round is over
+        Float32 remainingYouAreHere;
+        Float32 remainingGameOverWait;
+        Ranking ranking;
+        std::array<Profiler::Stats, Profiler::SECTIONS> profilerStats; // Only while the profiler overlay is shown
+        std::vector<PlayerState> players; // In the order of the players of the game
+        std::vector<SpriteState> sprites; // Visible ones in drawing order, opaque before blended
+        Size transparentBegin; // Index of the first blended sprite
+        std::vector<ElevatorState> elevators;
+        std::vector<BonusState> bonuses;
+        std::vector<Explosion> explosions;
+        InfoMessageQueue messages; // Refer to the players of the game
+
+    public:
+        RenderState();
+
+        /**
+         * Copies the state of the current round over the previous one, the lists keep their capacity.
+         */
+        void capture(const Game &game);
+    };
+}
+
+#endif
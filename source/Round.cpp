@@ -31,15 +31,17 @@
 #include "GameMode.h"
 #include "Weapon.h"
 #include "PersonProfile.h"
+#include "File.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    Round::Round(Game &game, Int32 roundNumber, const std::string &levelPath, bool mirror)
-            : game(game), roundNumber(roundNumber), world(game, levelPath, mirror),
+    Round::Round(Game &game, Int32 roundNumber, PreparedLevel &preparedLevel, Uint32 seed)
+            : game(game), roundNumber(roundNumber), world(game, preparedLevel, seed),
               suddenDeathMode(false), waterFillWait(0), showYouAreHere(D6_YOU_ARE_HERE_DURATION), gameOverWait(0),
-              winner(false), scriptContext(world) {}
+              ticks(0), winner(false), scriptContext(world), recording(nullptr), replayed(nullptr),
+              inputPosition(0) {}
 
     void Round::start() {
-        startTime = SDL_GetTicks();
         auto &players = world.getPlayers();
         game.getMode().initializePlayerPositions(game, players, world);
         setPlayerViews();
@@ -71,7 +73,7 @@ namespace Duel6 {
     }
 
     void Round::scriptUpdate(Player &player) {
-        Uint32 roundTime = SDL_GetTicks() - startTime;
+        Uint32 roundTime = ticks * 1000 / D6_UPDATE_FREQUENCY;
         PersonProfile *profile = player.getPerson().getProfile();
         if (profile != nullptr) {
             auto &personScripts = profile->getScripts();
@@ -82,7 +84,7 @@ namespace Duel6 {
     }
 
     void Round::scriptEnd() {
-        Uint32 roundTime = SDL_GetTicks() - startTime;
+        Uint32 roundTime = ticks * 1000 / D6_UPDATE_FREQUENCY;
         auto &players = world.getPlayers();
         for (auto &player : players) {
             PersonProfile *profile = player.getPerson().getProfile();
@@ -167,6 +169,10 @@ namespace Duel6 {
     }
 
     void Round::update(Float32 elapsedTime) {
+        Profiler &profiler = game.getAppService().getProfiler();
+        ticks++;
+        world.storePreviousPositions();
+
         // Check if there's a winner
         if (!hasWinner()) {
             checkWinner();
@@ -178,16 +184,32 @@ namespace Duel6 {
         }
 
         for (Player &player : world.getPlayers()) {
-            player.updateControllerStatus();
-            scriptUpdate(player);
-            player.update(world, game.getSettings().getScreenMode(), elapsedTime);
+            if (replayed != nullptr) {
+                // A truncated log keeps the last players idle rather than reading past its end
+                bool recorded = inputPosition < replayed->states.size();
+                player.setControllerState(recorded ? replayed->states[inputPosition] : 0);
+            } else {
+                player.updateControllerStatus();
+                Profiler::Timer timer(profiler, Profiler::Section::Scripts);
+                scriptUpdate(player);
+            }
+            if (recording != nullptr) {
+                recording->addState(player.getControllerState());
+            }
+            inputPosition++;
+            {
+                Profiler::Timer timer(profiler, Profiler::Section::Players);
+                player.update(world, game.getSettings().getScreenMode(), elapsedTime);
+            }
             if (game.getSettings().isGhostEnabled() && !player.isInGame() && !player.isGhost()) {
                 player.makeGhost();
             }
         }
 
-        world.update(elapsedTime);
-        game.getAppService().getVideo().getRenderer().setGlobalTime(world.getTime());
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::World);
+            world.update(elapsedTime);
+        }
 
         if (suddenDeathMode) {
             waterFillWait += elapsedTime;
@@ -226,6 +248,46 @@ namespace Duel6 {
         setPlayerViews();
     }
 
+    Uint64 Round::getChecksum() const {
+        Uint64 hash = File::hash(&ticks, sizeof(ticks));
+        for (const Player &player : world.getPlayers()) {
+            Float32 state[] = {player.getPosition().x, player.getPosition().y, player.getLife(), player.getAir(),
+                               Float32(player.getAmmo()), player.isAlive() ? 1.0f : 0.0f};
+            hash = File::hash(state, sizeof(state), hash);
+        }
+        return hash;
+    }
+
+    void Round::record(InputLog *log) {
+        recording = log;
+    }
+
+    void Round::replay(const InputLog::Round &recordedRound) {
+        replayed = &recordedRound;
+    }
+
+    void Round::saveState(BinaryWriter &writer) const {
+        writer.write(ticks);
+        writer.write(suddenDeathMode);
+        writer.write(waterFillWait);
+        writer.write(showYouAreHere);
+        writer.write(gameOverWait);
+        writer.write(winner);
+        writer.write(Uint64(inputPosition));
+        world.saveState(writer);
+    }
+
+    void Round::restoreState(BinaryReader &reader) {
+        reader.read(ticks);
+        reader.read(suddenDeathMode);
+        reader.read(waterFillWait);
+        reader.read(showYouAreHere);
+        reader.read(gameOverWait);
+        reader.read(winner);
+        inputPosition = Size(reader.read<Uint64>());
+        world.restoreState(reader);
+    }
+
     bool Round::isOver() const {
         return hasWinner() && gameOverWait <= 0;
     }
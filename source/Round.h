@@ -33,6 +33,7 @@
 #include "Player.h"
 #include "World.h"
 #include "SysEvent.h"
+#include "InputLog.h"
 
 namespace Duel6 {
     class Game;
@@ -46,14 +47,17 @@ namespace Duel6 {
         Float32 waterFillWait;
         Float32 showYouAreHere;
         Float32 gameOverWait;
-        Uint32 startTime;
+        Uint32 ticks;
         bool winner;
         std::vector<Player *> alivePlayers;
         Script::RoundScriptContext scriptContext;
         std::function<void()> onRoundEnd;
+        InputLog *recording;
+        const InputLog::Round *replayed;
+        Size inputPosition;
 
     public:
-        Round(Game &game, Int32 roundNumber, const std::string &levelPath, bool mirror);
+        Round(Game &game, Int32 roundNumber, PreparedLevel &preparedLevel, Uint32 seed);
 
         void start();
 
@@ -63,6 +67,10 @@ namespace Duel6 {
 
         void keyEvent(const KeyPressEvent &event);
 
+        World &getWorld() {
+            return world;
+        }
+
         const World &getWorld() const {
             return world;
         }
@@ -83,6 +91,32 @@ namespace Duel6 {
             return roundNumber;
         }
 
+        Uint32 getTicks() const {
+            return ticks;
+        }
+
+        // Hash of the simulated player state, used to verify that a replay matches its recording
+        Uint64 getChecksum() const;
+
+        // Appends controller states of all players to the current round of the log on every update, nullptr stops it
+        void record(InputLog *log);
+
+        // Drives players by recorded controller states instead of their controls and scripts
+        void replay(const InputLog::Round &recordedRound);
+
+        /**
+         * Saves the state of the round and its world. Player scripts keep their own state,
+         * so a restored round continues the same only when it is replayed.
+         */
+        void saveState(BinaryWriter &writer) const;
+
+        // Continues a replay or a recording from the controller state at which the snapshot was taken
+        void restoreState(BinaryReader &reader);
+
+        bool isReplayOver() const {
+            return replayed != nullptr && ticks >= replayed->ticks;
+        }
+
         bool isOver() const;
 
         bool isLast() const;
@@ -43,12 +43,31 @@ namespace Duel6 {
 
     class Shot;
 
+    class BinaryWriter;
+
     struct ShotHit {
         bool hit; // TODO: Remove and use C++17 std::optional
         Player *collidingPlayer;
         Player *collidingShotPlayer;
     };
 
+    /**
+     * Straight-line motion of a shot in the current update.
+     */
+    struct ShotMotion {
+        Vector position; // Bottom left corner of the collision rectangle
+        Vector dimensions;
+        Vector velocity; // Per second
+    };
+
+    /**
+     * Result of moving a shot by its motion, computed by ShotList for all shots before any of them is updated.
+     */
+    struct ShotStep {
+        Vector position;
+        bool hitsWall;
+    };
+
     class Shot {
     public:
         virtual ~Shot() {}
@@ -67,8 +86,21 @@ namespace Duel6 {
 
         virtual const Player &getPlayer() const = 0;
 
+        virtual ShotMotion getMotion() const = 0;
+
+        /**
+         * Moves the shot and resolves its hits on its own. This is the reference for the batched update,
+         * ShotList uses it only for shots fired during the update.
+         * @return false when the shot is over and has to be removed
+         */
         virtual bool update(Float32 elapsedTime, World &world) = 0;
 
+        /**
+         * Moves the shot to the step position and resolves its hits, the same way as update(elapsedTime, world).
+         * @return false when the shot is over and has to be removed
+         */
+        virtual bool update(const ShotStep &step, World &world) = 0;
+
         virtual Rectangle getCollisionRect() const = 0;
 
         virtual bool requestCollision(Shot &shot) = 0;
@@ -78,6 +110,11 @@ namespace Duel6 {
         virtual void onKillPlayer(Player &player, bool directHit, const Vector &hitPoint, World &world) = 0;
 
         virtual ShotHit getShotHit() = 0;
+
+        /**
+         * Saves the state of the shot, it is made again by Weapon::restoreShot() of its weapon.
+         */
+        virtual void saveState(BinaryWriter &writer, const World &world) const = 0;
     };
 }
 
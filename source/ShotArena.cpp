@@ -0,0 +1,77 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ShotArena.h"
+
+namespace Duel6 {
+    ShotArena::Pool::Pool(Size objectSize) {
+        const Size alignment = alignof(std::max_align_t);
+        slotSize = (objectSize + alignment - 1) / alignment * alignment;
+    }
+
+    void *ShotArena::Pool::allocate() {
+        if (freeSlots.empty()) {
+            // A new array of bytes is aligned for any type of its size and slot sizes are multiples of the alignment
+            blocks.push_back(std::make_unique<Uint8[]>(slotSize * BLOCK_SLOTS));
+            Uint8 *block = blocks.back().get();
+            for (Size i = BLOCK_SLOTS; i > 0; i--) {
+                freeSlots.push_back(block + (i - 1) * slotSize);
+            }
+        }
+
+        void *slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    void ShotArena::Pool::release(void *slot) {
+        freeSlots.push_back(slot);
+    }
+
+    void ShotArena::Deleter::operator()(Shot *shot) const {
+        // The most derived object starts at the slot even if the shot isn't its first base
+        void *slot = dynamic_cast<void *>(shot);
+        shot->~Shot();
+        pool->release(slot);
+    }
+
+    Size ShotArena::getAllocatedSlots() const {
+        Size slots = 0;
+        for (auto &pool : pools) {
+            slots += pool.second->getAllocatedSlots();
+        }
+        return slots;
+    }
+
+    ShotArena::Pool &ShotArena::getPool(std::type_index type, Size objectSize) {
+        auto iter = pools.find(type);
+        if (iter == pools.end()) {
+            iter = pools.emplace(type, std::make_unique<Pool>(objectSize)).first;
+        }
+        return *iter->second;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_SHOTARENA_H
+#define DUEL6_SHOTARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Type.h"
+#include "Shot.h"
+
+namespace Duel6 {
+    /**
+     * Memory for the shots of a round. Every shot type gets slots of its own size from blocks that
+     * stay allocated until the arena is destroyed, so once the blocks are warmed up, firing and
+     * removing shots doesn't go to the heap. Shots made by the arena must not outlive it.
+     */
+    class ShotArena {
+    private:
+        class Pool {
+        private:
+            static const Size BLOCK_SLOTS = 64;
+
+        private:
+            Size slotSize;
+            std::vector<std::unique_ptr<Uint8[]>> blocks;
+            std::vector<void *> freeSlots;
+
+        public:
+            explicit Pool(Size objectSize);
+
+            void *allocate();
+
+            // Freed slots are used first so that the memory of new shots is likely in cache
+            void release(void *slot);
+
+            Size getAllocatedSlots() const {
+                return blocks.size() * BLOCK_SLOTS;
+            }
+        };
+
+    public:
+        struct Deleter {
+            Pool *pool = nullptr;
+
+            void operator()(Shot *shot) const;
+        };
+
+        typedef std::unique_ptr<Shot, Deleter> Pointer;
+
+    private:
+        std::unordered_map<std::type_index, std::unique_ptr<Pool>> pools;
+
+    public:
+        ShotArena() = default;
+
+        ShotArena(const ShotArena &) = delete;
+
+        ShotArena &operator=(const ShotArena &) = delete;
+
+        template<class T, class... Args>
+        Pointer make(Args &&... args) {
+            static_assert(std::is_base_of<Shot, T>::value, "Arena makes only shots");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Shot type is over-aligned");
+
+            Pool &pool = getPool(typeid(T), sizeof(T));
+            void *slot = pool.allocate();
+            try {
+                return Pointer(new(slot) T(std::forward<Args>(args)...), Deleter{&pool});
+            } catch (...) {
+                pool.release(slot);
+                throw;
+            }
+        }
+
+        /** Number of slots of all shot types, used or free. */
+        Size getAllocatedSlots() const;
+
+    private:
+        Pool &getPool(std::type_index type, Size objectSize);
+    };
+}
+
+#endif
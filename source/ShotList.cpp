@@ -29,40 +29,142 @@
 #include "World.h"
 #include "Weapon.h"
 #include "Player.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    ShotList::ShotList() {}
+    ShotList::ShotList(Int32 width, Int32 height)
+            : grid(width, height), nextKey(0) {}
 
     void ShotList::addShot(ShotPointer &&shot) {
-        shots.push_back(std::forward<ShotPointer>(shot));
+        if (shots.empty()) {
+            nextKey = 0;
+        }
+
+        Grid::Key key = nextKey++;
+        grid.insert(key, shot.get(), shot->getCollisionRect());
+        shots.push_back(Entry{key, std::forward<ShotPointer>(shot)});
     }
 
     void ShotList::update(World &world, Float32 elapsedTime) {
-        auto iter = shots.begin();
+        // Moves and wall hits depend only on the shot itself, so they are computed for all shots at once.
+        // Hits of players and other shots depend on the shots updated before, so they are resolved one by one.
+        bool batched = world.getGameSettings().isBatchedShotUpdate();
+        Size stepCount = batched ? shots.size() : 0;
+        if (batched) {
+            computeSteps(world.getLevel(), elapsedTime);
+        }
+
+        // Dead shots are removed by moving the live ones down in place, which keeps the firing order
+        // the collisions are resolved in. Shots fired during the update are appended and updated too,
+        // only forEach can't be used until the loop is over as it would meet the removed entries.
+        Size live = 0;
+        for (Size i = 0; i < shots.size(); i++) {
+            Shot &shot = *shots[i].shot;
+            bool alive;
+            if (i < stepCount) {
+                ShotStep step = {Vector(steps.x[i], steps.y[i]), steps.hitsWall[i] != 0};
+                alive = shot.update(step, world);
+            } else {
+                alive = shot.update(elapsedTime, world);
+            }
 
-        while (iter != shots.end()) {
-            Shot &shot = *iter->get();
-            if (!shot.update(elapsedTime, world)) {
-                iter = shots.erase(iter);
+            if (!alive) {
+                grid.remove(shots[i].key);
+                shots[i].shot.reset();
             } else {
-                ++iter;
+                grid.move(shots[i].key, shot.getCollisionRect());
+                if (live != i) {
+                    shots[live] = std::move(shots[i]);
+                }
+                live++;
             }
         }
+        shots.erase(shots.begin() + live, shots.end());
+    }
+
+    void ShotList::computeSteps(const Level &level, Float32 elapsedTime) {
+        Size count = shots.size();
+        steps.x.resize(count);
+        steps.y.resize(count);
+        steps.velocityX.resize(count);
+        steps.velocityY.resize(count);
+        steps.width.resize(count);
+        steps.height.resize(count);
+        steps.hitsWall.resize(count);
+
+        for (Size i = 0; i < count; i++) {
+            ShotMotion motion = shots[i].shot->getMotion();
+            steps.x[i] = motion.position.x;
+            steps.y[i] = motion.position.y;
+            steps.velocityX[i] = motion.velocity.x;
+            steps.velocityY[i] = motion.velocity.y;
+            steps.width[i] = motion.dimensions.x;
+            steps.height[i] = motion.dimensions.y;
+        }
+
+        Float32 *x = steps.x.data();
+        Float32 *y = steps.y.data();
+        const Float32 *velocityX = steps.velocityX.data();
+        const Float32 *velocityY = steps.velocityY.data();
+        for (Size i = 0; i < count; i++) {
+            x[i] += velocityX[i] * elapsedTime;
+            y[i] += velocityY[i] * elapsedTime;
+        }
+
+        // Same corners as LegacyShot::checkWorldCollision
+        for (Size i = 0; i < count; i++) {
+            Float32 left = x[i];
+            Float32 right = x[i] + steps.width[i];
+            Float32 down = y[i];
+            Float32 up = y[i] + steps.height[i];
+            steps.hitsWall[i] = level.isWall(left, up, true) || level.isWall(left, down, true) ||
+                                level.isWall(right, up, true) || level.isWall(right, down, true);
+        }
     }
 
     void ShotList::forEach(std::function<bool(const Shot &)> handler) const {
-        for (auto &shotPointer : shots) {
-            if (!handler(*shotPointer)) {
+        for (auto &entry : shots) {
+            if (!handler(*entry.shot)) {
                 break;
             }
         }
     }
 
     void ShotList::forEach(std::function<bool(Shot &)> handler) {
-        for (auto &shotPointer : shots) {
-            if (!handler(*shotPointer)) {
+        for (auto &entry : shots) {
+            if (!handler(*entry.shot)) {
                 break;
             }
         }
     }
+
+    void ShotList::forEachInArea(const Rectangle &area, std::function<bool(Shot &)> handler) {
+        grid.forEach(area, [&handler](Grid::Key key, Shot *shot) -> bool {
+            return handler(*shot);
+        });
+    }
+
+    void ShotList::saveState(BinaryWriter &writer, const World &world) const {
+        writer.write(Uint32(shots.size()));
+        for (const Entry &entry : shots) {
+            const Shot &shot = *entry.shot;
+            writer.writeIndex(Weapon::values(), shot.getWeapon());
+            writer.write(Uint8(&shot.getPlayer() - world.getPlayers().data()));
+            shot.saveState(writer, world);
+        }
+    }
+
+    void ShotList::restoreState(BinaryReader &reader, World &world) {
+        shots.clear();
+        grid.clear();
+        Size count = reader.read<Uint32>();
+        for (Size i = 0; i < count; i++) {
+            Weapon weapon = reader.readIndex(Weapon::values(), Weapon());
+            Player &player = world.getPlayers().at(reader.read<Uint8>());
+            ShotPointer shot = weapon.restoreShot(player, world, reader);
+            if (shot) {
+                addShot(std::move(shot));
+            }
+        }
+    }
 }
\ No newline at end of file
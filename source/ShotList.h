@@ -29,31 +29,90 @@
 #define DUEL6_SHOTLIST_H
 
 #include <memory>
-#include <list>
+#include <vector>
 #include <functional>
 #include "Shot.h"
+#include "ShotArena.h"
 #include "Orientation.h"
+#include "collision/SpatialGrid.h"
 
 namespace Duel6 {
     class World;
 
+    class Level;
+
+    class BinaryWriter;
+
+    class BinaryReader;
+
+    /**
+     * Shots of a round. Shots live in the arena of the list, entries are kept in a vector in the order
+     * the shots were fired, so the update loop walks contiguous memory and stays deterministic.
+     */
     class ShotList {
+    public:
+        typedef ShotArena::Pointer ShotPointer;
+
     private:
-        typedef std::unique_ptr<Shot> ShotPointer;
+        typedef SpatialGrid<Shot *> Grid;
+
+        struct Entry {
+            Grid::Key key;
+            ShotPointer shot;
+        };
+
+        // Motion of the shots in structure of arrays, in the order of the entries
+        struct Steps {
+            std::vector<Float32> x;
+            std::vector<Float32> y;
+            std::vector<Float32> velocityX;
+            std::vector<Float32> velocityY;
+            std::vector<Float32> width;
+            std::vector<Float32> height;
+            std::vector<Uint8> hitsWall;
+        };
 
     private:
-        std::list<ShotPointer> shots;
+        ShotArena arena; // Has to be destroyed after the shots
+        std::vector<Entry> shots;
+        Steps steps;
+        Grid grid;
+        Grid::Key nextKey;
 
     public:
-        ShotList();
+        ShotList(Int32 width, Int32 height);
+
+        template<class T, class... Args>
+        ShotPointer makeShot(Args &&... args) {
+            return arena.make<T>(std::forward<Args>(args)...);
+        }
 
         void addShot(ShotPointer &&shot);
 
+        Size getSize() const {
+            return shots.size();
+        }
+
+        const ShotArena &getArena() const {
+            return arena;
+        }
+
         void update(World &world, Float32 elapsedTime);
 
         void forEach(std::function<bool(const Shot &)> handler) const;
 
         void forEach(std::function<bool(Shot &)> handler);
+
+        // Visits shots that may overlap the area, in the same order as forEach
+        void forEachInArea(const Rectangle &area, std::function<bool(Shot &)> handler);
+
+        void saveState(BinaryWriter &writer, const World &world) const;
+
+        // Shots add sprites when they are made, so the sprite list has to be restored after them
+        void restoreState(BinaryReader &reader, World &world);
+
+    private:
+        void computeSteps(const Level &level, Float32 elapsedTime);
     };
 }
 
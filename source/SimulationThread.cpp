@@ -0,0 +1,104 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <SDL2/SDL.h>
+#include "Context.h"
+#include "Defines.h"
+#include "TimeHistogram.h"
+#include "SimulationThread.h"
+
+namespace Duel6 {
+    SimulationThread::SimulationThread(TimeHistogram &tickTimes)
+            : running(false), active(false), lastTickCounter(0), tickTimes(tickTimes),
+              tickPeriod(SDL_GetPerformanceFrequency() / D6_UPDATE_FREQUENCY) {}
+
+    SimulationThread::~SimulationThread() {
+        stop();
+    }
+
+    void SimulationThread::start() {
+        if (!running) {
+            running = true;
+            thread = std::thread(&SimulationThread::run, this);
+        }
+    }
+
+    void SimulationThread::stop() {
+        if (running) {
+            running = false;
+            thread.join();
+            active = false;
+        }
+    }
+
+    Float32 SimulationThread::getInterpolation() const {
+        Uint64 now = SDL_GetPerformanceCounter();
+        Uint64 last = lastTickCounter;
+        if (now <= last) {
+            return 0.0f;
+        }
+        return std::min(1.0f, Float32(Float64(now - last) / tickPeriod));
+    }
+
+    void SimulationThread::run() {
+        Uint64 nextTick = SDL_GetPerformanceCounter();
+
+        while (running) {
+            Uint64 now = SDL_GetPerformanceCounter();
+            if (now < nextTick) {
+                Uint64 wait = (nextTick - now) * 1000000 / SDL_GetPerformanceFrequency();
+                std::this_thread::sleep_for(std::chrono::microseconds(wait));
+                continue;
+            }
+
+            bool ticked = false;
+            {
+                std::lock_guard<TicketMutex> lock(worldMutex);
+                // Runs every update that got due while waiting for the lock, but not the ones getting due meanwhile,
+                // so the main thread gets its turn even when the updates are slower than the game time
+                Uint64 dueCounter = SDL_GetPerformanceCounter();
+                while (nextTick <= dueCounter && Context::exists() && Context::getCurrent().canUpdateConcurrently()) {
+                    Uint64 start = SDL_GetPerformanceCounter();
+                    Context::getCurrent().update(Float32(1.0 / D6_UPDATE_FREQUENCY));
+                    Uint64 end = SDL_GetPerformanceCounter();
+                    tickTimes.add(Float64(end - start) * 1000.0 / SDL_GetPerformanceFrequency());
+                    lastTickCounter = nextTick;
+                    nextTick += tickPeriod;
+                    ticked = true;
+                }
+                active = ticked;
+            }
+
+            if (!ticked) {
+                // Idle, start counting again from now
+                nextTick = now + tickPeriod;
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_SIMULATIONTHREAD_H
+#define DUEL6_SIMULATIONTHREAD_H
+
+#include <atomic>
+#include <thread>
+#include "TicketMutex.h"
+#include "Type.h"
+
+namespace Duel6 {
+    class TimeHistogram;
+
+    /**
+     * Runs the fixed-step updates of the current context on its own thread while the context allows it, so that
+     * rendering and waiting for the display do not hold back the game and the other way round. The main thread
+     * keeps the world lock while it handles events and picks the published render state of the next frame, which it
+     * then draws without the lock. The simulation thread takes the lock to run the updates that are due. The lock
+     * is handed over in turn, so neither thread can take it again while the other one waits, and updates held back
+     * by a slow frame are caught up afterwards instead of being dropped.
+     */
+    class SimulationThread {
+    private:
+        TicketMutex worldMutex;
+        std::thread thread;
+        std::atomic<bool> running;
+        std::atomic<bool> active;
+        std::atomic<Uint64> lastTickCounter;
+        TimeHistogram &tickTimes;
+        Uint64 tickPeriod;
+
+    public:
+        explicit SimulationThread(TimeHistogram &tickTimes);
+
+        ~SimulationThread();
+
+        SimulationThread(const SimulationThread &) = delete;
+
+        SimulationThread &operator=(const SimulationThread &) = delete;
+
+        void start();
+
+        void stop();
+
+        bool isRunning() const {
+            return running;
+        }
+
+        // Whether the last update of the current context ran on the simulation thread
+        bool isActive() const {
+            return running && active;
+        }
+
+        TicketMutex &getWorldMutex() {
+            return worldMutex;
+        }
+
+        // Part of the update step elapsed since the last update of the thread, in the range 0 - 1
+        Float32 getInterpolation() const;
+
+    private:
+        void run();
+    };
+}
+
+#endif
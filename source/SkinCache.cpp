@@ -0,0 +1,147 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include "SkinCache.h"
+#include "File.h"
+#include "Format.h"
+#include "IoException.h"
+
+namespace Duel6 {
+    namespace {
+        const char MAGIC[4] = {'D', '6', 'S', 'K'};
+        const Uint32 VERSION = 1;
+
+        struct Header {
+            char magic[4];
+            Uint32 version;
+            Uint64 key;
+            Uint32 width;
+            Uint32 height;
+            Uint32 depth;
+            Uint32 reserved;
+        };
+    }
+
+    SkinCache::SkinCache(const std::string &directory, const std::string &animationPath)
+            : directory(directory), animationHash(File::hash(animationPath)) {
+        try {
+            File::createDirectory(directory);
+        } catch (const IoException &) {
+        }
+    }
+
+    bool SkinCache::load(const PlayerSkinColors &colors, Image &image) const {
+        Uint64 key = getKey(colors);
+        std::string path = getPath(key);
+        if (!File::exists(path)) {
+            return false;
+        }
+
+        std::vector<Uint8> data;
+        try {
+            data = File::load(path);
+        } catch (const IoException &) {
+            return false;
+        }
+
+        Header header;
+        if (data.size() < sizeof(Header)) {
+            return false;
+        }
+        memcpy(&header, data.data(), sizeof(Header));
+        Size pixels = Size(header.width) * header.height * header.depth;
+        if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.key != key ||
+            data.size() != sizeof(Header) + pixels * sizeof(Color)) {
+            return false;
+        }
+
+        image.resize(header.width, header.height, header.depth);
+        if (pixels > 0) {
+            memcpy(&image.at(0), data.data() + sizeof(Header), pixels * sizeof(Color));
+        }
+        return true;
+    }
+
+    void SkinCache::save(const PlayerSkinColors &colors, const Image &image) const {
+        Uint64 key = getKey(colors);
+        Header header = {};
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.key = key;
+        header.width = Uint32(image.getWidth());
+        header.height = Uint32(image.getHeight());
+        header.depth = Uint32(image.getDepth());
+        Size pixels = image.getWidth() * image.getHeight() * image.getDepth();
+
+        // Per-thread temporary file, two games may generate the same skin at once
+        std::string path = getPath(key);
+        Size threadHash = std::hash<std::thread::id>()(std::this_thread::get_id());
+        std::string temporaryPath = Format("{0}.{1}.tmp") << path << threadHash;
+        try {
+            {
+                File file(temporaryPath, File::Mode::Binary, File::Access::Write);
+                file.write(&header, sizeof(Header), 1);
+                if (pixels > 0) {
+                    file.write(&image.at(0), sizeof(Color), pixels);
+                }
+            }
+            std::remove(path.c_str());
+            if (std::rename(temporaryPath.c_str(), path.c_str()) == 0) {
+                return;
+            }
+        } catch (const IoException &) {
+        }
+        std::remove(temporaryPath.c_str());
+    }
+
+    Uint64 SkinCache::getKey(const PlayerSkinColors &colors) const {
+        std::vector<Uint8> key;
+        for (Int32 i = PlayerSkinColors::HairTop; i <= PlayerSkinColors::HeadBandOuter; i++) {
+            const Color &color = colors.get(PlayerSkinColors::BodyPart(i));
+            key.push_back(color.getRed());
+            key.push_back(color.getGreen());
+            key.push_back(color.getBlue());
+            key.push_back(color.getAlpha());
+        }
+        key.push_back(Uint8(colors.getHair()));
+        key.push_back(colors.hasHeadBand() ? 1 : 0);
+        return File::hash(key.data(), key.size(), animationHash);
+    }
+
+    std::string SkinCache::getPath(Uint64 key) const {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        std::string name(16, '0');
+        for (Int32 i = 15; i >= 0; i--, key >>= 4) {
+            name[i] = HEX_DIGITS[key & 0xf];
+        }
+        return directory + name + ".skin";
+    }
+}
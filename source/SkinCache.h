@@ -0,0 +1,67 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_SKINCACHE_H
+#define DUEL6_SKINCACHE_H
+
+#include <string>
+#include "Type.h"
+#include "Image.h"
+#include "PlayerSkinColors.h"
+
+namespace Duel6 {
+    /**
+     * On-disk cache of composited player skins keyed by their colors. Keys include the hash of the player
+     * animation file, so editing the animation invalidates all cached skins. Different skins can be
+     * loaded and saved from several threads at once.
+     */
+    class SkinCache {
+    private:
+        std::string directory;
+        Uint64 animationHash;
+
+    public:
+        SkinCache(const std::string &directory, const std::string &animationPath);
+
+        /**
+         * @return true if the skin was found in the cache and loaded into the image
+         */
+        bool load(const PlayerSkinColors &colors, Image &image) const;
+
+        /**
+         * Stores a skin in the cache. Failures are ignored, the skin is just generated again next time.
+         */
+        void save(const PlayerSkinColors &colors, const Image &image) const;
+
+    private:
+        Uint64 getKey(const PlayerSkinColors &colors) const;
+
+        std::string getPath(Uint64 key) const;
+    };
+}
+
+#endif
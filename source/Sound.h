@@ -85,6 +85,7 @@ namespace Duel6 {
     private:
         Console &console;
         Int32 channels;
+        bool enabled;
         bool playing;
         std::vector<Mix_Music *> modules;
         std::vector<Mix_Chunk *> samples;
@@ -92,6 +93,9 @@ namespace Duel6 {
     public:
         Sound(Int32 channels, Console &console);
 
+        // Sound without an audio device; loading returns empty samples and tracks
+        explicit Sound(Console &console);
+
         ~Sound();
 
         Track loadModule(const std::string &fileName);
@@ -102,6 +106,10 @@ namespace Duel6 {
 
         void stopMusic();
 
+        bool isEnabled() const {
+            return enabled;
+        }
+
     private:
         void startMusic(Mix_Music *music, bool loop);
 
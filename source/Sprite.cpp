@@ -26,7 +26,6 @@
 */
 
 #include "Sprite.h"
-#include "Video.h"
 
 namespace Duel6 {
     Sprite::Sprite(Animation animation, Texture texture) {
@@ -37,6 +36,7 @@ namespace Duel6 {
         speed = 1;
         looping = AnimationLooping::RepeatForever;
         orientation = Orientation::Left;
+        hasPreviousPosition = false;
         visible = true;
         noDepth = false;
         finished = false;
@@ -152,40 +152,4 @@ namespace Duel6 {
             size += 2 * growStep;
         }
     }
-
-    void Sprite::render(Renderer &renderer) const {
-        if (!visible) {
-            return;
-        }
-
-        if (isNoDepth()) {
-            renderer.enableDepthTest(false);
-        }
-        if (isTransparent()) {
-            renderer.setBlendFunc(blendFunc);
-        }
-
-        Int32 textureIndex = animation[frame];
-        Material material(texture, Color(255, 255, 255, Uint8(255 * alpha)), !isTransparent());
-
-        bool rotated = zRotation != 0.0;
-        if (rotated) {
-            Matrix rotate = Matrix::rotateAroundPoint(zRotation, Vector::UNIT_Z, position + rotationCentre);
-            renderer.setModelMatrix(rotate);
-        }
-
-        bool reversed = (orientation == Orientation::Right);
-        Vector texturePos = Vector(reversed ? 1.0f : 0.0f, 1.0f, Float32(textureIndex));
-        Vector textureSize = Vector(reversed ? -1.0f : 1.0f, -1.0f);
-
-        renderer.quadXY(Vector(position.x, position.y, z), size, texturePos, textureSize, material);
-
-        if (rotated) {
-            renderer.setModelMatrix(Matrix::IDENTITY);
-        }
-
-        if (isNoDepth()) {
-            renderer.enableDepthTest(true);
-        }
-    }
 }
@@ -54,6 +54,8 @@ namespace Duel6 {
         AnimationLooping looping;   // Type of looping
         Orientation orientation;   // Current orientation
         Vector position;
+        Vector previousPosition; // After the previous update, for interpolation
+        bool hasPreviousPosition;
         Float32 z;
         Vector size;
         Float32 grow;   // Grow factor for explosions
@@ -134,8 +136,6 @@ namespace Duel6 {
         }
 
         void update(Float32 elapsedTime);
-
-        void render(Renderer &renderer) const;
     };
 }
 
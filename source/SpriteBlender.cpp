@@ -0,0 +1,254 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "SpriteBlender.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define D6_SPRITE_BLENDER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define D6_TARGET_AVX2
+#else
+#define D6_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Duel6 {
+    namespace {
+        Uint32 loadColor(const Color *color) {
+            Uint32 value;
+            memcpy(&value, color, sizeof(Uint32));
+            return value;
+        }
+
+        void storeColor(Color *color, Uint32 value) {
+            memcpy(static_cast<void *>(color), &value, sizeof(Uint32));
+        }
+
+        Uint8 channel(Uint32 color, Int32 index) {
+            return Uint8(color >> (index * 8));
+        }
+
+        Uint32 darken(Uint32 source, Uint32 destination) {
+            Float32 factor = (255 - channel(source, 3)) / 255.0f;
+            Uint32 result = Uint32(std::max(channel(destination, 3), channel(source, 3))) << 24;
+            for (Int32 i = 0; i < 3; i++) {
+                Int32 darker = std::min(channel(destination, i), channel(source, i));
+                Float32 value = darker + (darker - channel(destination, i)) * factor;
+                result |= Uint32(Uint8(Int32(value))) << (i * 8);
+            }
+            return result;
+        }
+
+        void blendRowScalar(const Uint8 *indexes, Size count, const SpriteBlender::ColorTable &table,
+                            animation::Layer::BLEND_MODE blendMode, Color *destination) {
+            bool darkenMode = blendMode == animation::Layer::BLEND_MODE::Darken;
+            for (Size i = 0; i < count; i++) {
+                Uint32 source = table[indexes[i]];
+                if (source == 0) {
+                    continue;
+                }
+                Uint32 target = loadColor(destination + i);
+                storeColor(destination + i, (darkenMode && target != 0) ? darken(source, target) : source);
+            }
+        }
+
+#ifdef D6_SPRITE_BLENDER_X86
+        inline __m128i select(__m128i mask, __m128i ifTrue, __m128i ifFalse) {
+            return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+        }
+
+        inline __m128i darkenChannel(__m128i darker, __m128i destination, __m128 factor, Int32 shift) {
+            const __m128i mask = _mm_set1_epi32(0xff);
+            __m128i dark = _mm_and_si128(_mm_srli_epi32(darker, shift), mask);
+            __m128i original = _mm_and_si128(_mm_srli_epi32(destination, shift), mask);
+            __m128 difference = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(dark, original)), factor);
+            __m128 value = _mm_add_ps(_mm_cvtepi32_ps(dark), difference);
+            return _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(value), mask), shift);
+        }
+
+        inline __m128i blend4(__m128i source, __m128i destination, bool darkenMode) {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i sourceEmpty = _mm_cmpeq_epi32(source, zero);
+            __m128i result = source;
+            if (darkenMode) {
+                __m128i darker = _mm_min_epu8(source, destination);
+                __m128i alpha = _mm_and_si128(_mm_max_epu8(source, destination), _mm_set1_epi32(Int32(0xff000000)));
+                __m128i transparency = _mm_sub_epi32(_mm_set1_epi32(255), _mm_srli_epi32(source, 24));
+                __m128 factor = _mm_div_ps(_mm_cvtepi32_ps(transparency), _mm_set1_ps(255.0f));
+                __m128i darkened = _mm_or_si128(
+                        _mm_or_si128(darkenChannel(darker, destination, factor, 0),
+                                     darkenChannel(darker, destination, factor, 8)),
+                        _mm_or_si128(darkenChannel(darker, destination, factor, 16), alpha));
+                result = select(_mm_cmpeq_epi32(destination, zero), source, darkened);
+            }
+            return select(sourceEmpty, destination, result);
+        }
+
+        void blendRowSse2(const Uint8 *indexes, Size count, const SpriteBlender::ColorTable &table,
+                          animation::Layer::BLEND_MODE blendMode, Color *destination) {
+            bool darkenMode = blendMode == animation::Layer::BLEND_MODE::Darken;
+            Size i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128i source = _mm_set_epi32(Int32(table[indexes[i + 3]]), Int32(table[indexes[i + 2]]),
+                                               Int32(table[indexes[i + 1]]), Int32(table[indexes[i]]));
+                __m128i *target = reinterpret_cast<__m128i *>(destination + i);
+                _mm_storeu_si128(target, blend4(source, _mm_loadu_si128(target), darkenMode));
+            }
+            blendRowScalar(indexes + i, count - i, table, blendMode, destination + i);
+        }
+
+        D6_TARGET_AVX2 inline __m256i select8(__m256i mask, __m256i ifTrue, __m256i ifFalse) {
+            return _mm256_blendv_epi8(ifFalse, ifTrue, mask);
+        }
+
+        D6_TARGET_AVX2 inline __m256i darkenChannel8(__m256i darker, __m256i destination, __m256 factor,
+                                                     Int32 shift) {
+            const __m256i mask = _mm256_set1_epi32(0xff);
+            __m256i dark = _mm256_and_si256(_mm256_srli_epi32(darker, shift), mask);
+            __m256i original = _mm256_and_si256(_mm256_srli_epi32(destination, shift), mask);
+            __m256 difference = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(dark, original)), factor);
+            __m256 value = _mm256_add_ps(_mm256_cvtepi32_ps(dark), difference);
+            return _mm256_slli_epi32(_mm256_and_si256(_mm256_cvttps_epi32(value), mask), shift);
+        }
+
+        D6_TARGET_AVX2 void blendRowAvx2(const Uint8 *indexes, Size count, const SpriteBlender::ColorTable &table,
+                                         animation::Layer::BLEND_MODE blendMode, Color *destination) {
+            bool darkenMode = blendMode == animation::Layer::BLEND_MODE::Darken;
+            const Int32 *colors = reinterpret_cast<const Int32 *>(table.data());
+            const __m256i zero = _mm256_setzero_si256();
+            Size i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m128i packedIndexes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(indexes + i));
+                __m256i source = _mm256_i32gather_epi32(colors, _mm256_cvtepu8_epi32(packedIndexes), 4);
+                __m256i *target = reinterpret_cast<__m256i *>(destination + i);
+                __m256i original = _mm256_loadu_si256(target);
+
+                __m256i result = source;
+                if (darkenMode) {
+                    __m256i darker = _mm256_min_epu8(source, original);
+                    __m256i alpha = _mm256_and_si256(_mm256_max_epu8(source, original),
+                                                     _mm256_set1_epi32(Int32(0xff000000)));
+                    __m256i transparency = _mm256_sub_epi32(_mm256_set1_epi32(255), _mm256_srli_epi32(source, 24));
+                    __m256 factor = _mm256_div_ps(_mm256_cvtepi32_ps(transparency), _mm256_set1_ps(255.0f));
+                    __m256i darkened = _mm256_or_si256(
+                            _mm256_or_si256(darkenChannel8(darker, original, factor, 0),
+                                            darkenChannel8(darker, original, factor, 8)),
+                            _mm256_or_si256(darkenChannel8(darker, original, factor, 16), alpha));
+                    result = select8(_mm256_cmpeq_epi32(original, zero), source, darkened);
+                }
+                _mm256_storeu_si256(target, select8(_mm256_cmpeq_epi32(source, zero), original, result));
+            }
+            // Avoid the AVX to SSE transition penalty in the SSE2 tail
+            _mm256_zeroupper();
+            blendRowSse2(indexes + i, count - i, table, blendMode, destination + i);
+        }
+
+        bool cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+            __cpuid(info, 1);
+            bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(info, 7, 0);
+            return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2") != 0;
+#endif
+        }
+#endif
+
+        SpriteBlender::InstructionSet detectInstructionSet() {
+#ifdef D6_SPRITE_BLENDER_X86
+            return cpuSupportsAvx2() ? SpriteBlender::InstructionSet::AVX2 : SpriteBlender::InstructionSet::SSE2;
+#else
+            return SpriteBlender::InstructionSet::Scalar;
+#endif
+        }
+
+        std::atomic<SpriteBlender::InstructionSet> selectedInstructionSet(detectInstructionSet());
+    }
+
+    void SpriteBlender::makeColorTable(const animation::Palette &palette, Uint8 opacity, Uint8 transparentIndex,
+                                       ColorTable &table) {
+        for (Size i = 0; i < table.size(); i++) {
+            const animation::Color &color = palette.colors[i];
+            Uint8 alpha = Uint8(color.a * (opacity / 255.0f));
+            table[i] = (i == transparentIndex) ? 0 : Uint32(color.r) | (Uint32(color.g) << 8) |
+                                                     (Uint32(color.b) << 16) | (Uint32(alpha) << 24);
+        }
+    }
+
+    void SpriteBlender::blendRow(const Uint8 *indexes, Size count, const ColorTable &table,
+                                 animation::Layer::BLEND_MODE blendMode, Color *destination) {
+        switch (selectedInstructionSet.load(std::memory_order_relaxed)) {
+#ifdef D6_SPRITE_BLENDER_X86
+            case InstructionSet::AVX2:
+                blendRowAvx2(indexes, count, table, blendMode, destination);
+                break;
+            case InstructionSet::SSE2:
+                blendRowSse2(indexes, count, table, blendMode, destination);
+                break;
+#endif
+            default:
+                blendRowScalar(indexes, count, table, blendMode, destination);
+                break;
+        }
+    }
+
+    bool SpriteBlender::isSupported(InstructionSet instructionSet) {
+        return instructionSet <= detectInstructionSet();
+    }
+
+    SpriteBlender::InstructionSet SpriteBlender::getInstructionSet() {
+        return selectedInstructionSet;
+    }
+
+    void SpriteBlender::setInstructionSet(InstructionSet instructionSet) {
+        if (isSupported(instructionSet)) {
+            selectedInstructionSet = instructionSet;
+        }
+    }
+
+    const char *SpriteBlender::getName(InstructionSet instructionSet) {
+        switch (instructionSet) {
+            case InstructionSet::SSE2:
+                return "SSE2";
+            case InstructionSet::AVX2:
+                return "AVX2";
+            default:
+                return "scalar";
+        }
+    }
+}
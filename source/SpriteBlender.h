@@ -0,0 +1,78 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_SPRITEBLENDER_H
+#define DUEL6_SPRITEBLENDER_H
+
+#include <array>
+#include "Type.h"
+#include "Color.h"
+#include "aseprite/animation.h"
+
+namespace Duel6 {
+    /**
+     * Pixel kernels compositing palette-indexed Aseprite cels straight into sprite frames.
+     * Opacity and the transparent index are folded into a 256 entry color table once per cel, rows are then
+     * looked up and blended 4 (SSE2) or 8 (AVX2) pixels at a time. The best instruction set supported by the CPU
+     * is selected at startup, all variants produce the same pixels as the scalar one.
+     */
+    class SpriteBlender {
+    public:
+        enum class InstructionSet {
+            Scalar,
+            SSE2,
+            AVX2
+        };
+
+        /** Colors packed in memory order of Color (red in the lowest byte). */
+        typedef std::array<Uint32, 256> ColorTable;
+
+    public:
+        static void makeColorTable(const animation::Palette &palette, Uint8 opacity, Uint8 transparentIndex,
+                                   ColorTable &table);
+
+        /**
+         * Blends a row of palette indexes over destination colors. Fully transparent source pixels keep the
+         * destination, fully transparent destination pixels take the source.
+         */
+        static void blendRow(const Uint8 *indexes, Size count, const ColorTable &table,
+                             animation::Layer::BLEND_MODE blendMode, Color *destination);
+
+        static bool isSupported(InstructionSet instructionSet);
+
+        static InstructionSet getInstructionSet();
+
+        /**
+         * Overrides the automatically selected instruction set, unsupported ones are ignored.
+         */
+        static void setInstructionSet(InstructionSet instructionSet);
+
+        static const char *getName(InstructionSet instructionSet);
+    };
+}
+
+#endif
@@ -25,48 +25,259 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
+#include <utility>
+#include "Exception.h"
 #include "SpriteList.h"
-#include "Video.h"
+#include "RenderState.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    SpriteList::Iterator SpriteList::add(Animation animation, Texture texture) {
+    SpriteList::SpriteList()
+            : transparentBegin(0), partitionEnd(0), removedCount(0), updating(false) {}
+
+    SpriteList::Handle SpriteList::add(Animation animation, Texture texture) {
+        // Growing the storage would move the sprite being updated
+        if (updating) {
+            D6_THROW(Exception, "Sprites cannot be added while the sprite list is being updated");
+        }
+
+        Uint32 slot;
+        if (freeSlots.empty()) {
+            slot = Uint32(slots.size());
+            slots.push_back(Slot{0, 0});
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        slots[slot].index = Uint32(sprites.size());
         sprites.emplace_back(animation, texture);
-        return std::prev(sprites.end());
+        owners.push_back(slot);
+        return Handle(this, slot, slots[slot].generation);
+    }
+
+    void SpriteList::remove(Handle handle) {
+        if (isValid(handle)) {
+            Slot &slot = slots[handle.slot];
+            owners[slot.index] = REMOVED;
+            slot.generation++;
+            freeSlots.push_back(handle.slot);
+            removedCount++;
+        }
+    }
+
+    void SpriteList::clear() {
+        for (Uint32 slot : owners) {
+            if (slot != REMOVED) {
+                slots[slot].generation++;
+                freeSlots.push_back(slot);
+            }
+        }
+        sprites.clear();
+        owners.clear();
+        transparentBegin = 0;
+        partitionEnd = 0;
+        removedCount = 0;
     }
 
     void SpriteList::update(Float32 elapsedTime) {
-        // Update everything
+        updating = true;
+        for (Size i = 0; i < sprites.size(); i++) {
+            if (owners[i] != REMOVED) {
+                sprites[i].update(elapsedTime);
+            }
+        }
+        updating = false;
+
+        partition();
+    }
+
+    void SpriteList::storePreviousPositions() {
         for (Sprite &sprite : sprites) {
-            sprite.update(elapsedTime);
+            sprite.previousPosition = sprite.position;
+            sprite.hasPreviousPosition = true;
         }
+    }
 
-        // Delete sprites with finished animations
-        auto sprite = sprites.begin();
-        while (sprite != sprites.end()) {
-            if (sprite->getLooping() == AnimationLooping::OnceAndRemove && sprite->isFinished()) {
-                sprite = sprites.erase(sprite);
+    void SpriteList::partition() {
+        // Sprites at the same depth cover each other in the order they are drawn, so both the opaque
+        // and the transparent ones keep the order they were added in. Removed sprites and sprites with finished
+        // animations are deleted, opaque ones are moved down in place and transparent ones appended after them.
+        Size opaqueEnd = 0;
+        for (Size i = 0; i < sprites.size(); i++) {
+            Sprite &sprite = sprites[i];
+            if (owners[i] == REMOVED) {
+                continue;
+            }
+            if (sprite.getLooping() == AnimationLooping::OnceAndRemove && sprite.isFinished()) {
+                slots[owners[i]].generation++;
+                freeSlots.push_back(owners[i]);
+            } else if (sprite.isTransparent()) {
+                transparentSprites.push_back(std::move(sprite));
+                transparentOwners.push_back(owners[i]);
             } else {
-                ++sprite;
+                if (opaqueEnd != i) {
+                    sprites[opaqueEnd] = std::move(sprite);
+                    owners[opaqueEnd] = owners[i];
+                }
+                slots[owners[opaqueEnd]].index = Uint32(opaqueEnd);
+                opaqueEnd++;
             }
         }
-    }
 
-    void SpriteList::render(Renderer &renderer) const {
-        renderTransparent(renderer, false);
+        sprites.erase(sprites.begin() + opaqueEnd, sprites.end());
+        owners.erase(owners.begin() + opaqueEnd, owners.end());
+        for (Size i = 0; i < transparentSprites.size(); i++) {
+            slots[transparentOwners[i]].index = Uint32(sprites.size());
+            sprites.push_back(std::move(transparentSprites[i]));
+            owners.push_back(transparentOwners[i]);
+        }
+        transparentSprites.clear();
+        transparentOwners.clear();
 
-        renderer.enableDepthWrite(false);
+        transparentBegin = opaqueEnd;
+        partitionEnd = sprites.size();
+        removedCount = 0;
+    }
 
-        renderTransparent(renderer, true);
+    void SpriteList::captureRenderState(RenderState &state) const {
+        state.sprites.clear();
+        captureRange(state, 0, transparentBegin);
+        captureTail(state, false);
+        state.transparentBegin = state.sprites.size();
+        captureRange(state, transparentBegin, partitionEnd);
+        captureTail(state, true);
+    }
 
-        renderer.enableDepthWrite(true);
-        renderer.setBlendFunc(BlendFunc::None);
+    void SpriteList::captureRange(RenderState &state, Size from, Size to) const {
+        for (Size i = from; i < to; i++) {
+            if (owners[i] != REMOVED) {
+                capture(state, sprites[i]);
+            }
+        }
     }
 
-    void SpriteList::renderTransparent(Renderer &renderer, bool transparent) const {
-        for (const Sprite &sprite : sprites) {
-            if (sprite.isTransparent() == transparent) {
-                sprite.render(renderer);
+    void SpriteList::captureTail(RenderState &state, bool transparent) const {
+        for (Size i = partitionEnd; i < sprites.size(); i++) {
+            if (owners[i] != REMOVED && sprites[i].isTransparent() == transparent) {
+                capture(state, sprites[i]);
             }
         }
     }
-}
\ No newline at end of file
+
+    void SpriteList::capture(RenderState &state, const Sprite &sprite) {
+        if (!sprite.visible) {
+            return;
+        }
+
+        RenderState::SpriteState spriteState;
+        // Sprites added by the last update start where they were placed
+        spriteState.previousPosition = sprite.hasPreviousPosition ? sprite.previousPosition : sprite.position;
+        spriteState.position = sprite.position;
+        spriteState.size = sprite.size;
+        spriteState.rotationCentre = sprite.rotationCentre;
+        spriteState.z = sprite.z;
+        spriteState.zRotation = sprite.zRotation;
+        spriteState.alpha = sprite.alpha;
+        spriteState.texture = sprite.texture;
+        spriteState.textureIndex = sprite.animation[sprite.frame];
+        spriteState.blendFunc = sprite.blendFunc;
+        spriteState.reversed = sprite.orientation == Orientation::Right;
+        spriteState.noDepth = sprite.noDepth;
+        state.sprites.push_back(spriteState);
+    }
+
+    void SpriteList::saveState(BinaryWriter &writer) const {
+        writer.write(Uint32(slots.size()));
+        for (const Slot &slot : slots) {
+            writer.write(slot.index);
+            writer.write(slot.generation);
+        }
+        writer.write(Uint32(freeSlots.size()));
+        for (Uint32 slot : freeSlots) {
+            writer.write(slot);
+        }
+
+        writer.write(Uint32(sprites.size()));
+        for (Size i = 0; i < sprites.size(); i++) {
+            const Sprite &sprite = sprites[i];
+            writer.write(owners[i]);
+            writer.write(sprite.animation);
+            writer.write(sprite.texture);
+            writer.write(Uint32(sprite.frame));
+            writer.write(sprite.delay);
+            writer.write(sprite.speed);
+            writer.write(sprite.looping);
+            writer.write(sprite.orientation);
+            writer.write(sprite.position);
+            writer.write(sprite.z);
+            writer.write(sprite.size);
+            writer.write(sprite.grow);
+            writer.write(sprite.alpha);
+            writer.write(sprite.blendFunc);
+            writer.write(Uint8((sprite.visible ? 1 : 0) | (sprite.noDepth ? 2 : 0) | (sprite.finished ? 4 : 0)));
+            writer.write(sprite.zRotation);
+            writer.write(sprite.rotationCentre);
+        }
+        writer.write(Uint32(transparentBegin));
+        writer.write(Uint32(partitionEnd));
+    }
+
+    void SpriteList::restoreState(BinaryReader &reader) {
+        slots.resize(reader.read<Uint32>());
+        for (Slot &slot : slots) {
+            reader.read(slot.index);
+            reader.read(slot.generation);
+        }
+        freeSlots.resize(reader.read<Uint32>());
+        for (Uint32 &slot : freeSlots) {
+            reader.read(slot);
+        }
+
+        Size count = reader.read<Uint32>();
+        sprites.clear();
+        owners.clear();
+        sprites.reserve(count);
+        owners.reserve(count);
+        for (Size i = 0; i < count; i++) {
+            owners.push_back(reader.read<Uint32>());
+            Animation animation = reader.read<Animation>();
+            sprites.emplace_back(animation, reader.read<Texture>());
+
+            Sprite &sprite = sprites.back();
+            sprite.frame = reader.read<Uint32>();
+            reader.read(sprite.delay);
+            reader.read(sprite.speed);
+            reader.read(sprite.looping);
+            reader.read(sprite.orientation);
+            reader.read(sprite.position);
+            reader.read(sprite.z);
+            reader.read(sprite.size);
+            reader.read(sprite.grow);
+            reader.read(sprite.alpha);
+            reader.read(sprite.blendFunc);
+            Uint8 flags = reader.read<Uint8>();
+            sprite.visible = (flags & 1) != 0;
+            sprite.noDepth = (flags & 2) != 0;
+            sprite.finished = (flags & 4) != 0;
+            reader.read(sprite.zRotation);
+            reader.read(sprite.rotationCentre);
+        }
+        transparentBegin = reader.read<Uint32>();
+        partitionEnd = reader.read<Uint32>();
+        removedCount = Size(std::count(owners.begin(), owners.end(), REMOVED));
+    }
+
+    void SpriteList::saveHandle(BinaryWriter &writer, Handle handle) const {
+        // Handles that were never assigned are marked by a slot no list can have
+        writer.write(handle.spriteList != nullptr ? handle.slot : Uint32(-1));
+        writer.write(handle.generation);
+    }
+
+    SpriteList::Handle SpriteList::restoreHandle(BinaryReader &reader) {
+        Uint32 slot = reader.read<Uint32>();
+        Uint32 generation = reader.read<Uint32>();
+        return slot != Uint32(-1) ? Handle(this, slot, generation) : Handle();
+    }
+}
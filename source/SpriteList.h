@@ -28,35 +28,129 @@
 #ifndef DUEL6_SPRITELIST_H
 #define DUEL6_SPRITELIST_H
 
-#include <list>
+#include <vector>
 #include "Sprite.h"
 
 namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
+    class RenderState;
+
+    /**
+     * Sprites are stored contiguously and addressed through generational handles, so a handle to a removed
+     * sprite never aliases a new one. Removed sprites only lose their owner and are dropped by the next update,
+     * which partitions the storage into opaque and transparent sprites, sprites added since then are kept at
+     * the end. Both keep the order the sprites were added in.
+     */
     class SpriteList {
     public:
-        typedef std::list<Sprite>::iterator Iterator;
+        class Handle {
+        private:
+            friend class SpriteList;
+
+            SpriteList *spriteList;
+            Uint32 slot;
+            Uint32 generation;
+
+        private:
+            Handle(SpriteList *spriteList, Uint32 slot, Uint32 generation)
+                    : spriteList(spriteList), slot(slot), generation(generation) {}
+
+        public:
+            Handle()
+                    : spriteList(nullptr), slot(0), generation(0) {}
+
+            bool isValid() const {
+                return spriteList != nullptr && spriteList->isValid(*this);
+            }
+
+            Sprite *operator->() const {
+                return &spriteList->get(*this);
+            }
+
+            Sprite &operator*() const {
+                return spriteList->get(*this);
+            }
+        };
 
     private:
-        std::list<Sprite> sprites;
+        static constexpr Uint32 REMOVED = Uint32(-1); // Owner of a removed sprite until the next update
+
+        struct Slot {
+            Uint32 index;
+            Uint32 generation;
+        };
+
+        std::vector<Sprite> sprites;
+        std::vector<Uint32> owners; // Slot of each sprite
+        std::vector<Slot> slots;
+        std::vector<Uint32> freeSlots;
+        Size transparentBegin;
+        Size partitionEnd;
+        Size removedCount;
+        bool updating;
+        std::vector<Sprite> transparentSprites; // Scratch lists of the partition
+        std::vector<Uint32> transparentOwners;
 
     public:
-        Iterator add(Animation animation, Texture texture);
+        SpriteList();
+
+        Handle add(Animation animation, Texture texture);
+
+        void remove(Handle handle);
 
-        void remove(Iterator iterator) {
-            sprites.erase(iterator);
+        void clear();
+
+        bool isValid(Handle handle) const {
+            return handle.slot < slots.size() && slots[handle.slot].generation == handle.generation;
+        }
+
+        Sprite &get(Handle handle) {
+            return sprites[slots[handle.slot].index];
         }
 
-        void clear() {
-            sprites.clear();
+        const Sprite &get(Handle handle) const {
+            return sprites[slots[handle.slot].index];
+        }
+
+        Size size() const {
+            return sprites.size() - removedCount;
         }
 
         void update(Float32 elapsedTime);
 
-        void render(Renderer &renderer) const;
+        /**
+         * Remembers where the sprites are before an update moves them, so they can be drawn in between.
+         */
+        void storePreviousPositions();
+
+        // Visible sprites in the order they are drawn, opaque before transparent ones
+        void captureRenderState(RenderState &state) const;
+
+        /**
+         * Snapshot of all sprites including the slot layout, so handles held by game objects stay valid
+         * after restoring. Animations and textures are stored by address and finish callbacks are left
+         * to the owners of the sprites, a snapshot can only be restored in the process that took it.
+         */
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
+
+        void saveHandle(BinaryWriter &writer, Handle handle) const;
+
+        Handle restoreHandle(BinaryReader &reader);
 
     private:
-        void renderTransparent(Renderer &renderer, bool transparent) const;
+        void partition();
+
+        void captureRange(RenderState &state, Size from, Size to) const;
+
+        void captureTail(RenderState &state, bool transparent) const;
+
+        static void capture(RenderState &state, const Sprite &sprite);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -25,15 +25,25 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#if defined(__APPLE__)
+#include <SDL2_image/SDL_image.h>
+#else
+#include <SDL2/SDL_image.h>
+#endif
+
 #include <algorithm>
 #include "TextureManager.h"
+#include "SpriteBlender.h"
 #include "File.h"
 #include "Video.h"
 #include "aseprite/animation.h"
 
 namespace Duel6 {
     TextureManager::TextureManager(Renderer &renderer)
-            : renderer(renderer) {}
+            : renderer(renderer) {
+        // Load the PNG decoder up front, IMG_Load would initialize it lazily from the loader threads
+        IMG_Init(IMG_INIT_PNG);
+    }
 
     const animation::Animation TextureManager::loadAnimation(const std::string &path) {
         return animation::Animation::loadAseImage(path);
@@ -51,12 +61,17 @@ namespace Duel6 {
                                            const animation::Palette &substitutionTable,
                                            TextureFilter filtering,
                                            bool clamp) const {
+        return createTexture(composeSprite(animation, animationView, substitutionTable), filtering, clamp);
+    }
+
+    Image TextureManager::composeSprite(const animation::Animation &animation,
+                                        const animation::Animation::AnimationView &animationView,
+                                        const animation::Palette &substitutionTable) const {
         Image list;
+        SpriteBlender::ColorTable colorTable;
+        Image frameImage(animation.width, animation.height);
         for (uint16_t f = 0; f < animation.framesCount; f++) {
-            Image frameImage(animation.width, animation.height);
-            for (uint16_t p = 0; p < animation.width * animation.height; p++) {
-                frameImage.at(p).setAlpha(0);
-            }
+            std::fill(&frameImage.at(0), &frameImage.at(0) + animation.width * animation.height, Color(0, 0, 0, 0));
 
             for (size_t l = 0; l < animation.layers.size(); l++) {
                 const auto &layer = animation.layers[l];
@@ -67,60 +82,45 @@ namespace Duel6 {
 
                 const animation::Image &image = animation.images[frame.image];
                 const float layerOpacity = layer.opacity / 255.0f;
-                const auto x = frame.x;
-                const auto y = frame.y;
-                const auto width = image.width;
-                const auto height = image.height;
-
-                auto pixels = image.substitute(substitutionTable, layerOpacity * frame.opacity,
-                                               animation.transparentIndex);
-                for (uint16_t v = 0; v < height && v + y < animation.height; v++) {
-                    if (v + y < 0)
-                        continue; // In Aseprite image cel can be placed in a way that it spans beyond the image boundaries (and could crash code below)
-                    for (uint16_t u = 0; u < width && u + x < animation.width; u++) {
-                        if (u + x < 0)
-                            continue;
-                        //TODO LAYER BLEND MODE
-                        const auto &color = pixels[v * width + u];
-                        auto &dstColor = frameImage.at((y + v) * animation.width + u + x);
-                        bool transparent = dstColor.getRed() == 0 &&
-                                           dstColor.getGreen() == 0 &&
-                                           dstColor.getBlue() == 0 &&
-                                           dstColor.getAlpha() == 0;
-                        if (color.r == 0 && color.g == 0 && color.b == 0 && color.a == 0) {
-                            // do not overwrite pixel with empty pixel
-                            continue;
-                        } else if (transparent) {
-                            // overwrite empty pixel
-                            dstColor.set(color.r, color.g, color.b, color.a);
-                        } else {
-                            // color mixing //TODO
-                            switch (layer.blendMode) {
-                                case animation::Layer::BLEND_MODE::Darken: {
-                                    uint8_t R = std::min(dstColor.getRed(), color.r);
-                                    uint8_t G = std::min(dstColor.getGreen(), color.g);
-                                    uint8_t B = std::min(dstColor.getBlue(), color.b);
-                                    uint8_t A = std::max(dstColor.getAlpha(), color.a);
-                                    R += (R - dstColor.getRed()) * ((255 - color.a) / 255.0f);
-                                    G += (G - dstColor.getGreen()) * ((255 - color.a) / 255.0f);
-                                    B += (B - dstColor.getBlue()) * ((255 - color.a) / 255.0f);
-
-                                    dstColor.set(R, G, B, A);
-                                    break;
-                                }
-                                case animation::Layer::BLEND_MODE::Normal:
-                                default:
-                                    frameImage.at((y + v) * animation.width + u + x).set(color.r, color.g, color.b,
-                                                                                         color.a);
-                            }
-                        }
-                    }
+                const Int32 x = frame.x;
+                const Int32 y = frame.y;
+                if (x >= animation.width) {
+                    continue;
+                }
+
+                // Opacity and palette substitution are resolved once per cel, rows are then blended in place
+                SpriteBlender::makeColorTable(substitutionTable, Uint8(layerOpacity * frame.opacity),
+                                              animation.transparentIndex, colorTable);
+                const Size rowLength = std::min<Int32>(image.width, animation.width - x);
+                //TODO LAYER BLEND MODE (only Normal and Darken are supported)
+                for (Int32 v = 0; v < image.height && v + y < animation.height; v++) {
+                    SpriteBlender::blendRow(&image.pixels[v * image.width], rowLength, colorTable, layer.blendMode,
+                                            &frameImage.at((y + v) * animation.width + x));
                 }
             }
             // frameImage now contains pixels from all layers
             list.addSlice(frameImage);
         }
-        return renderer.createTexture(list, filtering, clamp);
+        return list;
+    }
+
+    Texture TextureManager::createTexture(const Image &image, TextureFilter filtering, bool clamp) const {
+        return renderer.createTexture(image, filtering, clamp);
+    }
+
+    void TextureManager::prefetchStack(const std::string &path) {
+        if (prefetchedStacks.find(path) == prefetchedStacks.end()) {
+            prefetchedStacks[path] = threadPool.submit([path]() {
+                return Image::loadStack(path);
+            }).share();
+        }
+    }
+
+    void TextureManager::clearPrefetched() {
+        for (auto &stack : prefetchedStacks) {
+            stack.second.wait();
+        }
+        prefetchedStacks.clear();
     }
 
     Texture TextureManager::loadStack(const std::string &path, TextureFilter filtering, bool clamp) {
@@ -130,7 +130,8 @@ namespace Duel6 {
 
     Texture TextureManager::loadStack(const std::string &path, TextureFilter filtering, bool clamp,
                                       const SubstitutionTable &substitutionTable) {
-        Image image = Image::loadStack(path);
+        auto prefetched = prefetchedStacks.find(path);
+        Image image = prefetched != prefetchedStacks.end() ? prefetched->second.get() : Image::loadStack(path);
         substituteColors(image, substitutionTable);
 
         Texture texture = renderer.createTexture(image, filtering, clamp);
@@ -140,11 +141,18 @@ namespace Duel6 {
     const TextureDictionary TextureManager::loadDict(const std::string &path, TextureFilter filtering, bool clamp) {
         std::vector<std::string> textureFiles = File::listDirectory(path);
 
+        std::vector<std::future<Image>> images;
+        for (const std::string &file : textureFiles) {
+            std::string filePath = path + file;
+            images.push_back(threadPool.submit([filePath]() {
+                return Image::load(filePath);
+            }));
+        }
+
         TextureDictionary dict;
-        for (std::string &file : textureFiles) {
-            Image image = Image::load(path + file);
-            Texture texture = renderer.createTexture(image, filtering, clamp);
-            dict.textures[file] = texture;
+        for (Size i = 0; i < textureFiles.size(); i++) {
+            Texture texture = renderer.createTexture(images[i].get(), filtering, clamp);
+            dict.textures[textureFiles[i]] = texture;
         }
 
         return dict;
@@ -28,10 +28,12 @@
 #ifndef DUEL6_TEXTUREMANAGER_H
 #define DUEL6_TEXTUREMANAGER_H
 
+#include <future>
 #include <memory>
 #include <unordered_map>
 #include <string>
 #include "Type.h"
+#include "ThreadPool.h"
 #include "Color.h"
 #include "Image.h"
 #include "TextureDictionary.h"
@@ -52,21 +54,42 @@
 
 namespace Duel6 {
     class TextureManager {
-    private:
-        Renderer &renderer;
-
     public:
         typedef std::unordered_map<Color, Color, ColorHash> SubstitutionTable;
 
+    private:
+        Renderer &renderer;
+        ThreadPool threadPool;
+        std::unordered_map<std::string, std::shared_future<Image>> prefetchedStacks;
+
     public:
         TextureManager(Renderer &renderer);
 
         void dispose(Texture texture);
 
+        /**
+         * Starts decoding a texture stack on the thread pool, a later loadStack of the same path waits for it.
+         */
+        void prefetchStack(const std::string &path);
+
+        /**
+         * Drops prefetched stacks that were not used, their decoding errors are ignored.
+         */
+        void clearPrefetched();
+
         Texture loadStack(const std::string &path, TextureFilter filtering, bool clamp);
 
         const animation::Animation loadAnimation(const std::string &path);
 
+        /**
+         * Composites all visible layers of every animation frame into an image stack, safe to call from any thread.
+         */
+        Image composeSprite(const animation::Animation &animation,
+                            const animation::Animation::AnimationView &animationView,
+                            const animation::Palette &substitutionTable) const;
+
+        Texture createTexture(const Image &image, TextureFilter filtering, bool clamp) const;
+
         Texture generateSprite(const animation::Animation& animation,
                                const animation::Animation::AnimationView & animationView,
                                const animation::Palette &substitutionTable,
@@ -81,6 +104,10 @@ namespace Duel6 {
 
         const TextureDictionary loadDict(const std::string &path, TextureFilter filtering, bool clamp);
 
+        ThreadPool &getThreadPool() {
+            return threadPool;
+        }
+
     private:
         void substituteColors(Image &image, const SubstitutionTable &substitutionTable);
     };
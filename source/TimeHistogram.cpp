@@ -0,0 +1,62 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <limits>
+#include "TimeHistogram.h"
+
+namespace Duel6 {
+    namespace {
+        const Float64 upperBounds[TimeHistogram::BUCKETS - 1] = {
+                0.25, 0.5, 1, 2, 4, 6, 8, 10, 12, 14, 17, 20, 25, 33, 50
+        };
+    }
+
+    TimeHistogram::TimeHistogram() {
+        reset();
+    }
+
+    void TimeHistogram::add(Float64 milliseconds) {
+        Size bucket = std::upper_bound(std::begin(upperBounds), std::end(upperBounds), milliseconds) -
+                      std::begin(upperBounds);
+        counts[bucket]++;
+        total++;
+        sum += milliseconds;
+        max = std::max(max, milliseconds);
+    }
+
+    void TimeHistogram::reset() {
+        counts.fill(0);
+        total = 0;
+        sum = 0;
+        max = 0;
+    }
+
+    Float64 TimeHistogram::getUpperBound(Size bucket) {
+        return bucket + 1 < BUCKETS ? upperBounds[bucket] : std::numeric_limits<Float64>::infinity();
+    }
+}
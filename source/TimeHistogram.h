@@ -0,0 +1,76 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_TIMEHISTOGRAM_H
+#define DUEL6_TIMEHISTOGRAM_H
+
+#include <array>
+#include "Type.h"
+
+namespace Duel6 {
+    /**
+     * Counts durations in fixed millisecond buckets, used to compare frame and tick times of the update modes.
+     */
+    class TimeHistogram {
+    public:
+        static constexpr Size BUCKETS = 16;
+
+    private:
+        std::array<Uint32, BUCKETS> counts;
+        Uint32 total;
+        Float64 sum;
+        Float64 max;
+
+    public:
+        TimeHistogram();
+
+        void add(Float64 milliseconds);
+
+        void reset();
+
+        Uint32 getCount() const {
+            return total;
+        }
+
+        Uint32 getCount(Size bucket) const {
+            return counts[bucket];
+        }
+
+        Float64 getAverage() const {
+            return total > 0 ? sum / total : 0;
+        }
+
+        Float64 getMax() const {
+            return max;
+        }
+
+        // Upper bound of a bucket in milliseconds, the last bucket has none
+        static Float64 getUpperBound(Size bucket);
+    };
+}
+
+#endif
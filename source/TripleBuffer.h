@@ -0,0 +1,79 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_TRIPLEBUFFER_H
+#define DUEL6_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include "Type.h"
+
+namespace Duel6 {
+    /**
+     * Hands values over from a writer to a reader without locking. The writer fills the back slot and publishes it,
+     * the reader takes the slot published last. Neither waits for the other: the writer never touches the slot
+     * being read and a slow reader only skips values published in the meantime. Writes have to be ordered by
+     * the caller when more than one thread writes, reads must come from a single thread.
+     */
+    template <class T>
+    class TripleBuffer {
+    private:
+        static constexpr Uint8 FRESH = 0x4; // The middle slot was published since the reader took it last
+
+        std::array<T, 3> slots;
+        std::atomic<Uint8> middle; // Slot published last, with FRESH
+        Uint8 back;
+        Uint8 front;
+
+    public:
+        TripleBuffer()
+                : middle(1), back(0), front(2) {}
+
+        TripleBuffer(const TripleBuffer &) = delete;
+
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        // Slot for the writer to fill, its previous content is from a few publications ago
+        T &getBack() {
+            return slots[back];
+        }
+
+        void publish() {
+            back = Uint8(middle.exchange(Uint8(back | FRESH), std::memory_order_acq_rel) & ~FRESH);
+        }
+
+        // Value published last, stays untouched by the writer until the next read
+        const T &read() {
+            if ((middle.load(std::memory_order_relaxed) & FRESH) != 0) {
+                front = Uint8(middle.exchange(front, std::memory_order_acq_rel) & ~FRESH);
+            }
+            return slots[front];
+        }
+    };
+}
+
+#endif
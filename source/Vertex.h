@@ -35,7 +35,8 @@ namespace Duel6 {
     public:
         enum Flag {
             None = 0,
-            Flow = 1
+            Flow = 1,
+            Tile = 2
         };
 
     public:
@@ -64,6 +65,21 @@ namespace Duel6 {
         Uint32 getFlag() const {
             return flag;
         }
+
+        bool hasFlag(Flag test) const {
+            return (flag & test) != 0;
+        }
+
+        /**
+         * Stretches the texture coordinates over a face spanning several blocks.
+         * Renderers repeat the texture once per block for vertices with the Tile flag.
+         */
+        Vertex &tile(Float32 uBlocks, Float32 vBlocks) {
+            u = (u > 0) ? uBlocks : 0.0f;
+            v = (v > 0) ? vBlocks : 0.0f;
+            flag |= Flag::Tile;
+            return *this;
+        }
     };
 }
 
@@ -37,7 +37,8 @@
 #endif
 
 namespace Duel6 {
-    Video::Video(const std::string &name, const std::string &icon, Console &console) {
+    Video::Video(const std::string &name, const std::string &icon, Console &console)
+            : interpolation(1.0f) {
         // Get current video mode
         SDL_DisplayMode currentVideoMode;
         if (SDL_GetCurrentDisplayMode(0, &currentVideoMode)) {
@@ -69,27 +70,64 @@ namespace Duel6 {
         SDL_ShowCursor(SDL_DISABLE);
     }
 
+    Video::Video(const ScreenParameters &screen, std::unique_ptr<Renderer> renderer)
+            : window(nullptr), glContext(nullptr), fps(0), interpolation(1.0f), screen(screen),
+              view(1.0f, 40.0f, 45.0f), renderer(std::move(renderer)) {
+        setMode(Mode::Orthogonal);
+    }
+
     Video::~Video() {
-        SDL_GL_DeleteContext(glContext);
-        SDL_DestroyWindow(window);
+        if (glContext != nullptr) {
+            SDL_GL_DeleteContext(glContext);
+        }
+        if (window != nullptr) {
+            SDL_DestroyWindow(window);
+        }
     }
 
     void Video::screenUpdate(Console &console, const Font &font) {
+        if (isHeadless()) {
+            return;
+        }
         renderConsole(console, font);
         swapBuffers();
     }
 
     void Video::renderConsole(Console &console, const Font &font) {
-        if (console.isActive()) {
+        if (!isHeadless() && console.isActive()) {
             console.render(*renderer, screen.getClientWidth(), screen.getClientHeight(), font);
         }
     }
 
     void Video::swapBuffers() {
+        if (isHeadless()) {
+            return;
+        }
+        framePacer.startPresent();
         SDL_GL_SwapWindow(window);
+        framePacer.endPresent();
         calculateFps();
     }
 
+    Video::Vsync Video::setVsync(Vsync vsync) {
+        if (isHeadless()) {
+            return Vsync::Off;
+        }
+        if (vsync == Vsync::Adaptive && SDL_GL_SetSwapInterval(-1) == 0) {
+            return Vsync::Adaptive;
+        }
+        SDL_GL_SetSwapInterval(vsync == Vsync::Off ? 0 : 1);
+        return getVsync();
+    }
+
+    Video::Vsync Video::getVsync() const {
+        if (isHeadless()) {
+            return Vsync::Off;
+        }
+        Int32 interval = SDL_GL_GetSwapInterval();
+        return interval < 0 ? Vsync::Adaptive : (interval > 0 ? Vsync::On : Vsync::Off);
+    }
+
     void Video::calculateFps() {
         static Uint32 curTime = 0, lastTime = 0, frameCounter = 0;
         curTime = SDL_GetTicks();
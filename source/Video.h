@@ -34,6 +34,7 @@
 #include "ScreenParameters.h"
 #include "ViewParameters.h"
 #include "renderer/Renderer.h"
+#include "FramePacer.h"
 
 namespace Duel6 {
     class Video {
@@ -43,21 +44,37 @@ namespace Duel6 {
             Perspective
         };
 
+        enum class Vsync {
+            Off,
+            On,
+            Adaptive
+        };
+
     private:
         SDL_Window *window;
         SDL_GLContext glContext;
         Float32 fps;
+        Float32 interpolation;
         ScreenParameters screen;
         ViewParameters view;
         std::unique_ptr<Renderer> renderer;
+        FramePacer framePacer;
 
     public:
         Video(const std::string &name, const std::string &icon, Console &console);
 
+        // Headless video without a window or a graphics context
+        Video(const ScreenParameters &screen, std::unique_ptr<Renderer> renderer);
+
         ~Video();
 
         void screenUpdate(Console &console, const Font &font);
 
+        // The two halves of screenUpdate, the swap may wait for the display without holding the world
+        void renderConsole(Console &console, const Font &font);
+
+        void swapBuffers();
+
         const ScreenParameters &getScreen() const {
             return screen;
         }
@@ -70,15 +87,40 @@ namespace Duel6 {
             return fps;
         }
 
+        /**
+         * Part of the update step elapsed since the last update when drawing the frame. Moving objects are drawn
+         * between their positions after the last two updates, 1 draws them where the last update left them.
+         */
+        Float32 getInterpolation() const {
+            return interpolation;
+        }
+
+        void setInterpolation(Float32 interpolation) {
+            this->interpolation = interpolation;
+        }
+
+        FramePacer &getFramePacer() {
+            return framePacer;
+        }
+
+        /**
+         * Adaptive vsync waits for the display only with frames that are on time, late frames are shown at once.
+         * Drivers without adaptive vsync get the plain one.
+         * @return the mode in use
+         */
+        Vsync setVsync(Vsync vsync);
+
+        Vsync getVsync() const;
+
         void setMode(Mode mode) const;
 
         Renderer &getRenderer() const;
 
-    private:
-        void renderConsole(Console &console, const Font &font);
-
-        void swapBuffers();
+        bool isHeadless() const {
+            return window == nullptr;
+        }
 
+    private:
         void calculateFps();
 
         SDL_Window *createWindow(const std::string &name, const std::string &icon, const ScreenParameters &params,
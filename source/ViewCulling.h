@@ -0,0 +1,79 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_VIEWCULLING_H
+#define DUEL6_VIEWCULLING_H
+
+#include "Type.h"
+#include "Rectangle.h"
+
+namespace Duel6 {
+    /**
+     * Part of the level one view can see. Things outside of it are not drawn, the tested ones are counted
+     * so that the profiler overlay can show how much is skipped.
+     */
+    class ViewCulling {
+    private:
+        Rectangle area;
+        Size visible;
+        Size culled;
+
+    public:
+        explicit ViewCulling(const Rectangle &area)
+                : area(area), visible(0), culled(0) {}
+
+        bool isVisible(const Vector &position, const Vector &size) {
+            bool overlaps = position.x < area.right.x && position.x + size.x > area.left.x &&
+                            position.y < area.right.y && position.y + size.y > area.left.y;
+            if (overlaps) {
+                visible++;
+            } else {
+                culled++;
+            }
+            return overlaps;
+        }
+
+        bool isVisible(const Rectangle &rectangle) {
+            return isVisible(rectangle.left, rectangle.getSize());
+        }
+
+        // For things that can't be tested, e.g. rotated sprites
+        void addVisible() {
+            visible++;
+        }
+
+        Size getVisible() const {
+            return visible;
+        }
+
+        Size getCulled() const {
+            return culled;
+        }
+    };
+}
+
+#endif
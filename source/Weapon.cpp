@@ -29,7 +29,9 @@
 #include <stdlib.h>
 #include "Sound.h"
 #include "Weapon.h"
+#include "Shot.h"
 #include "GameSettings.h"
+#include "math/Random.h"
 #include "weapon/LegacyWeapon.h"
 #include "weapon/impl/Pistol.h"
 #include "weapon/impl/Bazooka.h"
@@ -59,7 +61,12 @@ namespace Duel6 {
 
             void shoot(Player &player, Orientation orientation, World &world) const override {}
 
-            SpriteList::Iterator makeSprite(SpriteList &spriteList) const override { return SpriteList::Iterator(); }
+            ShotArena::Pointer restoreShot(const Weapon &weapon, Player &player, World &world,
+                                           BinaryReader &reader) const override {
+                return nullptr;
+            }
+
+            SpriteList::Handle makeSprite(SpriteList &spriteList) const override { return SpriteList::Handle(); }
 
             Texture getBonusTexture() const override { return Texture(); }
 
@@ -103,7 +110,11 @@ namespace Duel6 {
         impl->shoot(player, orientation, world);
     }
 
-    SpriteList::Iterator Weapon::makeSprite(SpriteList &spriteList) const {
+    ShotArena::Pointer Weapon::restoreShot(Player &player, World &world, BinaryReader &reader) const {
+        return impl->restoreShot(*this, player, world, reader);
+    }
+
+    SpriteList::Handle Weapon::makeSprite(SpriteList &spriteList) const {
         return impl->makeSprite(spriteList);
     }
 
@@ -150,9 +161,9 @@ namespace Duel6 {
         return weapons;
     }
 
-    const Weapon &Weapon::getRandomEnabled(const GameSettings &settings) {
+    const Weapon &Weapon::getRandomEnabled(const GameSettings &settings, Random &random) {
         auto &enabledWeapons = settings.getEnabledWeapons();
-        Size randomIndex = Math::random(enabledWeapons.size());
+        Size randomIndex = random.random(Int32(enabledWeapons.size()));
         auto randomWeapon = enabledWeapons.cbegin();
         std::advance(randomWeapon, randomIndex);
         return *randomWeapon;
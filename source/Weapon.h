@@ -35,11 +35,16 @@
 #include "Sound.h"
 #include "SpriteList.h"
 #include "TextureManager.h"
+#include "ShotArena.h"
 
 namespace Duel6 {
     class World;
     class GameSettings;
+    class Random;
     class Player;
+    class Shot;
+    class BinaryReader;
+    class Weapon;
 
     class WeaponImpl {
     public:
@@ -51,7 +56,14 @@ namespace Duel6 {
 
         virtual void shoot(Player &player, Orientation orientation, World &world) const = 0;
 
-        virtual SpriteList::Iterator makeSprite(SpriteList &spriteList) const = 0;
+        /**
+         * Makes a shot of this weapon from the state saved by Shot::saveState().
+         * @param weapon this weapon
+         */
+        virtual ShotArena::Pointer restoreShot(const Weapon &weapon, Player &player, World &world,
+                                               BinaryReader &reader) const = 0;
+
+        virtual SpriteList::Handle makeSprite(SpriteList &spriteList) const = 0;
 
         virtual Texture getBonusTexture() const = 0;
 
@@ -92,7 +104,9 @@ namespace Duel6 {
 
         void shoot(Player &player, Orientation orientation, World &world) const;
 
-        SpriteList::Iterator makeSprite(SpriteList &spriteList) const;
+        ShotArena::Pointer restoreShot(Player &player, World &world, BinaryReader &reader) const;
+
+        SpriteList::Handle makeSprite(SpriteList &spriteList) const;
 
         Texture getBonusTexture() const;
 
@@ -109,7 +123,7 @@ namespace Duel6 {
 
         static void initialize(Sound &sound, TextureManager &textureManager);
 
-        static const Weapon &getRandomEnabled(const GameSettings &settings);
+        static const Weapon &getRandomEnabled(const GameSettings &settings, Random &random);
     };
 }
 
@@ -25,60 +25,148 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
 #include "World.h"
 #include "Game.h"
 #include "Weapon.h"
+#include "BinaryStream.h"
 
 namespace Duel6 {
-    World::World(Game &game, const std::string &levelPath, bool mirror)
+    World::World(Game &game, PreparedLevel &preparedLevel, Uint32 seed)
             : gameSettings(game.getSettings()), players(game.getPlayers()),
-              level(levelPath, mirror, game.getResources().getBlockMeta()),
-              levelRenderData(level, game.getAppService().getVideo().getRenderer(), gameSettings.getScreenMode(),
-                              D6_ANM_SPEED, D6_WAVE_HEIGHT), messageQueue(D6_INFO_DURATION),
-              explosionList(game.getResources(), D6_EXPL_SPEED), fireList(game.getResources(), spriteList),
+              profiler(game.getAppService().getProfiler()), random(seed), compiledLevel(std::move(preparedLevel.compiledLevel)),
+              level(std::move(preparedLevel.level)), renderLevel(std::move(preparedLevel.renderLevel)),
+              levelRenderData(std::move(preparedLevel.renderData)), renderTime(0),
+              messageQueue(D6_INFO_DURATION), shotList(level->getWidth(), level->getHeight()),
+              explosionList(D6_EXPL_SPEED), fireList(game.getResources(), spriteList),
               bonusList(game.getSettings(), game.getResources(), *this),
-              elevatorList(game.getResources().getElevatorTextures()), time(0) {
+              playerGrid(level->getWidth(), level->getHeight()), time(0) {
         Console &console = game.getAppService().getConsole();
-        console.printLine(Format("...Width   : {0}") << level.getWidth());
-        console.printLine(Format("...Height  : {0}") << level.getHeight());
-        console.printLine("...Preparing faces");
-        levelRenderData.generateFaces();
-        console.printLine(Format("...Walls   : {0}") << levelRenderData.getWalls().getFaces().size());
-        console.printLine(Format("...Sprites : {0}") << levelRenderData.getSprites().getFaces().size());
-        console.printLine(Format("...Water   : {0}") << levelRenderData.getWater().getFaces().size());
-
-        console.printLine("...Level initialization");
-        console.printLine("...Loading elevators");
-        elevatorList.load(levelPath, mirror);
-        fireList.find(level);
+        console.printLine(Format("...Width   : {0}") << level->getWidth(), LogLevel::Verbose);
+        console.printLine(Format("...Height  : {0}") << level->getHeight(), LogLevel::Verbose);
+        console.printLine("...Building face buffers", LogLevel::Verbose);
+        levelRenderData->build();
+        console.printLine(Format("...Walls   : {0}") << levelRenderData->getWalls().getFaces().size(),
+                          LogLevel::Verbose);
+        console.printLine(Format("...Sprites : {0}") << levelRenderData->getSprites().getFaces().size(),
+                          LogLevel::Verbose);
+        console.printLine(Format("...Water   : {0}") << levelRenderData->getWater().getFaces().size(),
+                          LogLevel::Verbose);
+
+        console.printLine("...Level initialization", LogLevel::Verbose);
+        console.printLine("...Loading elevators", LogLevel::Verbose);
+        elevatorList.load(*compiledLevel, preparedLevel.mirror);
+        fireList.find(*level);
         background = findBackground(game.getResources().getBcgTextures());
     }
 
     void World::update(Float32 elapsedTime) {
         time += elapsedTime;
+        updatePlayerGrid();
 
-        spriteList.update(elapsedTime);
-        explosionList.update(elapsedTime);
-        levelRenderData.update(elapsedTime);
-        shotList.update(*this, elapsedTime);
-        elevatorList.update(elapsedTime);
-        messageQueue.update(elapsedTime);
-        bonusList.update(elapsedTime);
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::Sprites);
+            spriteList.update(elapsedTime);
+        }
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::Explosions);
+            explosionList.update(elapsedTime);
+        }
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::Shots);
+            shotList.update(*this, elapsedTime);
+        }
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::Elevators);
+            elevatorList.update(elapsedTime);
+        }
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::Messages);
+            messageQueue.update(elapsedTime);
+        }
+        {
+            Profiler::Timer timer(profiler, Profiler::Section::Bonuses);
+            bonusList.update(elapsedTime);
+        }
 
         // Add new bonuses
         Int32 mod = Int32(3.0f / elapsedTime);
-        if (mod != 0 && Math::random(mod) == 0) {
+        if (mod != 0 && random.random(mod) == 0) {
             bonusList.addRandomBonus();
         }
     }
 
+    void World::storePreviousPositions() {
+        for (Player &player : players) {
+            player.storePreviousPositions();
+        }
+        elevatorList.storePreviousPositions();
+        spriteList.storePreviousPositions();
+    }
+
+    void World::updatePlayerGrid() {
+        playerGrid.clear();
+        for (Size i = 0; i < players.size(); i++) {
+            playerGrid.insert(SpatialGrid<Player *>::Key(i), &players[i], players[i].getCollisionRect());
+        }
+    }
+
     void World::raiseWater() {
-        level.raiseWater();
-        levelRenderData.generateWater();
+        level->raiseWater();
+    }
+
+    void World::updateRenderData(Float32 time, Int32 waterLevel) {
+        levelRenderData->update(time - renderTime);
+        renderTime = time;
+
+        Int32 renderedLevel = renderLevel->getWaterLevel();
+        if (waterLevel != renderedLevel) {
+            renderLevel->setWaterLevel(waterLevel);
+            // Besides the flooded rows, the flow of water below and waterfalls above them changes
+            Int32 from = std::min(waterLevel, renderedLevel);
+            Int32 to = std::max(waterLevel, renderedLevel);
+            levelRenderData->updateWaterRows(from - 1, to + 1);
+        }
+    }
+
+    void World::saveState(BinaryWriter &writer) const {
+        writer.write(time);
+        random.saveState(writer);
+        level->saveState(writer);
+        messageQueue.saveState(writer, players);
+        for (const Player &player : players) {
+            player.saveState(writer);
+        }
+        elevatorList.saveState(writer);
+        bonusList.saveState(writer);
+        explosionList.saveState(writer);
+        shotList.saveState(writer, *this);
+        spriteList.saveState(writer);
+        fireList.saveState(writer);
+    }
+
+    void World::restoreState(BinaryReader &reader) {
+        reader.read(time);
+        random.restoreState(reader);
+        level->restoreState(reader);
+
+        messageQueue.restoreState(reader, players);
+        for (Player &player : players) {
+            player.restoreState(reader);
+        }
+        elevatorList.restoreState(reader);
+        bonusList.restoreState(reader);
+        explosionList.restoreState(reader);
+        // Shots add their sprites when they are made, the sprite list then overwrites them
+        shotList.restoreState(reader, *this);
+        spriteList.restoreState(reader);
+        // Flames are bound to sprites
+        fireList.restoreState(reader);
+        updatePlayerGrid();
     }
 
     std::string World::findBackground(const GameResources::BackgroundList &backgrounds) {
-        const std::string &levelBackground = level.getBackground();
+        const std::string &levelBackground = level->getBackground();
         auto &bcgDict = backgrounds.getTextures();
         if (levelBackground.size() && bcgDict.find(levelBackground) != bcgDict.end()) {
             return levelBackground;
@@ -29,6 +29,9 @@
 #define DUEL6_WORLD_H
 
 #include "Level.h"
+#include "CompiledLevel.h"
+#include "LevelPreloader.h"
+#include "Profiler.h"
 #include "InfoMessageQueue.h"
 #include "LevelRenderData.h"
 #include "Explosion.h"
@@ -36,17 +39,28 @@
 #include "ShotList.h"
 #include "BonusList.h"
 #include "ElevatorList.h"
+#include "collision/SpatialGrid.h"
+#include "math/Random.h"
 
 namespace Duel6 {
     class Game;
 
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class World {
     private:
         const GameSettings &gameSettings;
         std::vector<Player> &players;
-        Level level;
+        Profiler &profiler;
+        Random random;
+        std::shared_ptr<const CompiledLevel> compiledLevel;
+        std::unique_ptr<Level> level;
         std::string background;
-        LevelRenderData levelRenderData;
+        std::unique_ptr<Level> renderLevel; // Only used on the main thread, like the render data
+        std::unique_ptr<LevelRenderData> levelRenderData;
+        Float32 renderTime; // Of the last render data update
         InfoMessageQueue messageQueue;
         SpriteList spriteList;
         ShotList shotList;
@@ -54,15 +68,44 @@ namespace Duel6 {
         FireList fireList;
         BonusList bonusList;
         ElevatorList elevatorList;
+        SpatialGrid<Player *> playerGrid;
         Float32 time;
 
     public:
-        World(Game &game, const std::string &levelPath, bool mirror);
+        /**
+         * Takes over the level from a prepared level and builds its renderer buffers.
+         * All gameplay randomness of the world is drawn from a generator with the given seed.
+         */
+        World(Game &game, PreparedLevel &preparedLevel, Uint32 seed);
 
         void update(Float32 elapsedTime);
 
+        /**
+         * Remembers positions of moving objects before an update, frames are drawn in between the last two updates.
+         */
+        void storePreviousPositions();
+
         void raiseWater();
 
+        /**
+         * Brings the level render data up to a render state of the world on the main thread: advances
+         * the animation by the time elapsed since the last call and floods or drains the changed rows.
+         */
+        void updateRenderData(Float32 time, Int32 waterLevel);
+
+        /**
+         * Saves the live state of the world: level water, players, entities, sprites and the generator.
+         * Resources shared with the level (animations, textures) are referred to by address,
+         * so a snapshot can be restored only into the world it was taken from.
+         */
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
+
+        Random &getRandom() {
+            return random;
+        }
+
         const GameSettings &getGameSettings() const {
             return gameSettings;
         }
@@ -75,20 +118,25 @@ namespace Duel6 {
             return players;
         }
 
+        // Player positions as of the start of the current world update
+        const SpatialGrid<Player *> &getPlayerGrid() const {
+            return playerGrid;
+        }
+
         Level &getLevel() {
-            return level;
+            return *level;
         }
 
         const Level &getLevel() const {
-            return level;
+            return *level;
         }
 
         LevelRenderData &getLevelRenderData() {
-            return levelRenderData;
+            return *levelRenderData;
         }
 
         const LevelRenderData &getLevelRenderData() const {
-            return levelRenderData;
+            return *levelRenderData;
         }
 
         InfoMessageQueue &getMessageQueue() {
@@ -156,6 +204,8 @@ namespace Duel6 {
         }
 
     private:
+        void updatePlayerGrid();
+
         std::string findBackground(const GameResources::BackgroundList &backgrounds);
     };
 }
@@ -25,13 +25,19 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include "BonusList.h"
-#include "ElevatorList.h"
+#include "Elevator.h"
 #include "Game.h"
-#include "GameMode.h"
-#include "Explosion.h"
 
 namespace Duel6 {
+    namespace {
+        // HUD texts change every frame, they are formatted into fixed buffers without allocations
+        constexpr FormatPattern extendedRankingPattern("|{0,3}|{1,3}|{2,3}|{3,5}|{4,4}");
+        constexpr FormatPattern rankingPattern("|{0,4}");
+        constexpr FormatPattern roundsPattern("Rounds: {0,3}|{1,3}");
+        constexpr FormatPattern fpsPattern("FPS - {0}");
+        constexpr FormatPattern bulletPattern("{0}");
+    }
+
     WorldRenderer::WorldRenderer(Duel6::AppService &appService, const Duel6::Game &game)
         : font(appService.getFont()), video(appService.getVideo()), game(game), renderer(video.getRenderer()) {}
 
@@ -43,22 +49,22 @@ namespace Duel6 {
         renderer.setViewport(x, y, width, height);
     }
 
-    void WorldRenderer::walls(const FaceList &walls) const {
-        walls.render(game.getResources().getBlockTextures(), false);
+    void WorldRenderer::walls(const FaceList &walls, const std::vector<FaceList::Range> &ranges) const {
+        walls.render(game.getResources().getBlockTextures(), false, ranges);
     }
 
-    void WorldRenderer::water(const FaceList &water) const {
+    void WorldRenderer::water(const FaceList &water, const std::vector<FaceList::Range> &ranges) const {
         renderer.enableDepthWrite(false);
         renderer.setBlendFunc(BlendFunc::SrcColor);
 
-        water.render(game.getResources().getBlockTextures(), false);
+        water.render(game.getResources().getBlockTextures(), false, ranges);
 
         renderer.setBlendFunc(BlendFunc::None);
         renderer.enableDepthWrite(true);
     }
 
-    void WorldRenderer::sprites(const FaceList &sprites) const {
-        sprites.render(game.getResources().getBlockTextures(), true);
+    void WorldRenderer::sprites(const FaceList &sprites, const std::vector<FaceList::Range> &ranges) const {
+        sprites.render(game.getResources().getBlockTextures(), true, ranges);
     }
 
     void WorldRenderer::background(Texture texture) const {
@@ -67,10 +73,10 @@ namespace Duel6 {
         renderer.quadXY(Vector(0, 0), Vector(cw, ch), Vector(0, 1), Vector(1, -1), Material::makeTexture(texture));
     }
 
-    void WorldRenderer::playerRankings() const {
+    void WorldRenderer::playerRankings(const RenderState &state) const {
         Float32 fontSize = 16;
-        Float32 fontWidth = fontSize / 2;
-        Ranking ranking = game.getMode().getRanking(game.getPlayers());
+        Float32 fontWidth = font.getCharWidth(fontSize);
+        const Ranking &ranking = state.ranking;
         Int32 maxNameLength = ranking.getMaxLength() + 6;
 
         const PlayerView &view = game.getPlayers().front().getView();
@@ -91,7 +97,8 @@ namespace Duel6 {
         }
         renderer.setBlendFunc(BlendFunc::SrcAlpha);
         Color fontColor(entry.fontColor);
-        renderer.quadXY(Vector(posX, posY + 1), Vector((charHeight/2) * maxLength, charHeight), entry.bcgColor);
+        Float32 charWidth = font.getCharWidth(charHeight);
+        renderer.quadXY(Vector(posX, posY + 1), Vector(charWidth * maxLength, charHeight), entry.bcgColor);
 
         Int32 paddingLeft = entry.isSuperEntry() ? 0 : 5;
         renderer.setBlendFunc(BlendFunc::None);
@@ -103,17 +110,21 @@ namespace Duel6 {
                 fontColor = Color::YELLOW;
             }
             auto killsToDeaths = Person::getKillsToDeathsRatio(entry.kills, entry.deaths);
-            font.print(posX + (charHeight / 2) * (maxLength - 23), posY, 0.0f, fontColor, (Format("|{0,3}|{1,3}|{2,3}|{3,5}|{4,4}") << entry.kills  << entry.assistances << entry.deaths << killsToDeaths << entry.points), charHeight);
+            FormatBuffer<64> text;
+            extendedRankingPattern.format(text, entry.kills, entry.assistances, entry.deaths, killsToDeaths, entry.points);
+            font.print(posX + charWidth * (maxLength - 23), posY, 0.0f, fontColor, text.c_str(), text.size(), charHeight);
         } else {
-            font.print(posX + (charHeight / 2) * (maxLength - 5), posY, 0.0f, fontColor, (Format("|{0,4}") << entry.points), charHeight);
+            FormatBuffer<16> text;
+            rankingPattern.format(text, entry.points);
+            font.print(posX + charWidth * (maxLength - 5), posY, 0.0f, fontColor, text.c_str(), text.size(), charHeight);
         }
         return posY - charHeight;
     }
 
-    void WorldRenderer::roundOverSummary() const {
+    void WorldRenderer::roundOverSummary(const RenderState &state) const {
         Float32 fontSize = 32;
-        Float32 fontWidth = fontSize / 2;
-        Ranking ranking = game.getMode().getRanking(game.getPlayers());
+        Float32 fontWidth = font.getCharWidth(fontSize);
+        const Ranking &ranking = state.ranking;
         Int32 maxLength = ranking.getMaxLength() + 6;
         Int32 maxNameLength = maxLength + 20;
         int height = fontSize * 3; // reserve for 'SCORE'
@@ -152,40 +163,86 @@ namespace Duel6 {
         }
     }
 
-    void WorldRenderer::gameOverSummary() const {
-        roundOverSummary();
+    void WorldRenderer::gameOverSummary(const RenderState &state) const {
+        roundOverSummary(state);
     }
 
     void WorldRenderer::roundsPlayed() const {
-        int width = 134;
+        FormatBuffer<32> text;
+        roundsPattern.format(text, game.getCurrentRound() + 1, game.getSettings().getMaxRounds());
+
+        int width = font.getTextWidth(text.c_str(), text.size(), font.getCharHeight()) + 16;
         int x = video.getScreen().getClientWidth() / 2 - width / 2;
         int y = video.getScreen().getClientHeight() - 20;
 
         renderer.quadXY(Vector(x - 1, y - 1), Vector(width + 2, 18), Color::BLACK);
-        font.print(x + 8, y, Color::WHITE,
-                   Format("Rounds: {0,3}|{1,3}") << game.getCurrentRound() + 1 << game.getSettings().getMaxRounds());
+        font.print(x + 8, y, Color::WHITE, text.c_str(), text.size());
     }
 
     void WorldRenderer::fpsCounter() const {
-        std::string fpsCount = Format("FPS - {0}") << Int32(video.getFps());
-        Int32 width = 8 * Int32(fpsCount.size()) + 2;
+        FormatBuffer<32> fpsCount;
+        fpsPattern.format(fpsCount, Int32(video.getFps()));
+        Int32 width = font.getTextWidth(fpsCount.c_str(), fpsCount.size(), font.getCharHeight()) + 2;
 
         Int32 x = Int32(video.getScreen().getClientWidth()) - width;
         Int32 y = Int32(video.getScreen().getClientHeight()) - 20;
 
         renderer.quadXY(Vector(x - 1, y - 1), Vector(width + 2, 18), Color::BLACK);
-        font.print(x, y, Color::WHITE, fpsCount);
+        font.print(x, y, Color::WHITE, fpsCount.c_str(), fpsCount.size());
+    }
+
+    void WorldRenderer::profilerOverlay(const RenderState &state) const {
+        Int32 width = font.getCharWidth() * 36 + 2;
+        Int32 height = 16 * Int32(Profiler::SECTIONS + 1) + 2;
+
+        Int32 x = Int32(video.getScreen().getClientWidth()) - width;
+        Int32 y = Int32(video.getScreen().getClientHeight()) - 42;
+
+        renderer.quadXY(Vector(x - 1, y - height + 17), Vector(width + 2, height), Color(0, 0, 0, 178));
+        font.print(x, y, Color::YELLOW, Format("{0,-12}{1,8}{2,8}{3,8}") << "us" << "min" << "avg" << "p99");
+
+        for (Size i = 0; i < Profiler::SECTIONS; i++) {
+            y -= 16;
+            Profiler::Section section = Profiler::Section(i);
+            const Profiler::Stats &stats = state.profilerStats[i];
+            font.print(x, y, Color::WHITE, Format("{0,-12}{1,8}{2,8}{3,8}") << Profiler::getName(section)
+                                                                             << Profiler::formatTime(stats.min)
+                                                                             << Profiler::formatTime(stats.avg)
+                                                                             << Profiler::formatTime(stats.p99));
+        }
     }
 
-    void WorldRenderer::youAreHere() const {
-        Float32 remainingTime = game.getRound().getRemainingYouAreHere();
+    void WorldRenderer::cullingOverlay() const {
+        Int32 width = font.getCharWidth() * 36 + 2;
+        Int32 height = 16 * Int32(cullingStats.size() + 1) + 2;
+
+        // Right below the profiler overlay
+        Int32 x = Int32(video.getScreen().getClientWidth()) - width;
+        Int32 y = Int32(video.getScreen().getClientHeight()) - 42 - 16 * Int32(Profiler::SECTIONS + 1) - 8;
+
+        renderer.quadXY(Vector(x - 1, y - height + 17), Vector(width + 2, height), Color(0, 0, 0, 178));
+        font.print(x, y, Color::YELLOW, Format("{0,-12}{1,12}{2,12}") << "drawn/all" << "chunks" << "objects");
+
+        for (Size i = 0; i < cullingStats.size(); i++) {
+            y -= 16;
+            const CullingStats &stats = cullingStats[i];
+            std::string view = Format("view {0}") << i + 1;
+            std::string chunks = Format("{0}/{1}") << stats.visibleChunks << stats.visibleChunks + stats.culledChunks;
+            std::string objects = Format("{0}/{1}") << stats.visibleObjects
+                                                    << stats.visibleObjects + stats.culledObjects;
+            font.print(x, y, Color::WHITE, Format("{0,-12}{1,12}{2,12}") << view << chunks << objects);
+        }
+    }
+
+    void WorldRenderer::youAreHere(const RenderState &state) const {
+        Float32 remainingTime = state.remainingYouAreHere;
         if (remainingTime <= 0) return;
 
         renderer.enableDepthTest(false);
 
         Float32 radius = 0.5f + 0.5f * std::abs(D6_YOU_ARE_HERE_DURATION / 2 - remainingTime);
-        for (const Player &player : game.getPlayers()) {
-            Vector playerCentre = player.getCentre();
+        for (const RenderState::PlayerState &player : state.players) {
+            Vector playerCentre = player.getCollisionRect(video.getInterpolation()).getCentre();
             playerCentre.z = 0.5;
 
             Vector lastPoint;
@@ -203,8 +260,8 @@ namespace Duel6 {
     }
 
     Float32
-    WorldRenderer::playerIndicator(const Player &player, const Indicator &indicator, const Color &color, Float32 value,
-                                   Float32 xOfs, Float32 yOfs) const {
+    WorldRenderer::playerIndicator(const RenderState::PlayerState &player, const Indicator &indicator,
+                                   const Color &color, Float32 value, Float32 xOfs, Float32 yOfs) const {
         Float32 width = value * 0.98f;
         Float32 X = xOfs - 0.5f;
         Float32 Y = yOfs;
@@ -224,7 +281,7 @@ namespace Duel6 {
     void WorldRenderer::playerName(const Player &player, const Indicator &indicator, Float32 xOfs, Float32 yOfs) const {
         const std::string &name = player.getPerson().getName();
 
-        Float32 width = 0.15f * name.size();
+        Float32 width = font.getTextWidth(name, 0.3f);
         Float32 X = xOfs - width / 2;
         Float32 Y = yOfs;
 
@@ -240,11 +297,12 @@ namespace Duel6 {
         renderer.enableDepthWrite(true);
     }
 
-    void
-    WorldRenderer::bulletIndicator(const Player &player, const Indicator &indicator, Float32 xOfs, Float32 yOfs) const {
-        std::string bulletCount = Format("{0}") << player.getAmmo();
+    void WorldRenderer::bulletIndicator(const RenderState::PlayerState &player, const Indicator &indicator,
+                                        Float32 xOfs, Float32 yOfs) const {
+        FormatBuffer<16> bulletCount;
+        bulletPattern.format(bulletCount, player.ammo);
 
-        Float32 width = 0.15f * bulletCount.size();
+        Float32 width = font.getTextWidth(bulletCount.c_str(), bulletCount.size(), 0.3f);
         Float32 X = xOfs - width / 2;
         Float32 Y = yOfs;
 
@@ -256,15 +314,14 @@ namespace Duel6 {
         renderer.quadXY(Vector(X, Y, 0.5f), Vector(width, 0.3f), Color::YELLOW.withAlpha(alpha));
         renderer.setBlendFunc(BlendFunc::None);
 
-        font.print(X, Y, 0.5f, Color::BLUE.withAlpha(alpha), bulletCount, 0.3f);
+        font.print(X, Y, 0.5f, Color::BLUE.withAlpha(alpha), bulletCount.c_str(), bulletCount.size(), 0.3f);
 
         renderer.enableDepthWrite(true);
     }
 
-    void
-    WorldRenderer::bonusIndicator(const Player &player, const Indicator &indicator, Float32 xOfs, Float32 yOfs) const {
+    void WorldRenderer::bonusIndicator(const RenderState::PlayerState &player, const Indicator &indicator,
+                                       Float32 xOfs, Float32 yOfs) const {
         Uint8 alpha = Uint8(255 * indicator.getAlpha());
-        auto bonusType = player.getBonus();
         Material material = Material::makeColoredTexture(game.getResources().getBonusTextures(), Color::WHITE.withAlpha(alpha));
 
         Float32 size = 0.3f;
@@ -273,49 +330,50 @@ namespace Duel6 {
 
         renderer.enableDepthWrite(false);
         renderer.setBlendFunc(BlendFunc::SrcAlpha);
-        renderer.quadXY(Vector(X, Y, 0.5f), Vector(size, size), Vector(0.3f, 0.7f, Float32(bonusType.getTextureIndex())), Vector(0.4f, -0.4f), material);
+        renderer.quadXY(Vector(X, Y, 0.5f), Vector(size, size), Vector(0.3f, 0.7f, Float32(player.bonusTextureIndex)), Vector(0.4f, -0.4f), material);
         renderer.setBlendFunc(BlendFunc::None);
         renderer.enableDepthWrite(true);
     }
 
-    void WorldRenderer::playerStatus(const Player &player) const {
-        const auto &indicators = player.getIndicators();
+    void WorldRenderer::playerStatus(const Player &player, const RenderState::PlayerState &state) const {
+        const auto &indicators = state.indicators;
 
-        if (player.isAlive()) {
-            Rectangle rect = player.getCollisionRect();
+        if (state.alive) {
+            Rectangle rect = state.getCollisionRect(video.getInterpolation());
             Float32 xOfs = rect.getCentre().x;
             Float32 yOfs = rect.right.y + 0.15f;
 
             const auto &reload = indicators.getReload();
             if (reload.isVisible()) {
-                Float32 interval = player.getReloadInterval();
-                Float32 value = 1.0f - std::min(interval, player.getReloadTime()) / interval;
-                yOfs += playerIndicator(player, reload, Color::GREEN, value, xOfs, yOfs);
+                Float32 interval = state.reloadInterval;
+                Float32 value = 1.0f - std::min(interval, state.reloadTime) / interval;
+                yOfs += playerIndicator(state, reload, Color::GREEN, value, xOfs, yOfs);
             }
 
             const auto &air = indicators.getAir();
             if (air.isVisible()) {
-                yOfs += playerIndicator(player, air, Color::BLUE, player.getAir() / D6_MAX_AIR, xOfs, yOfs);
+                yOfs += playerIndicator(state, air, Color::BLUE, state.air / D6_MAX_AIR, xOfs, yOfs);
             }
 
             const auto &bonus = indicators.getBonus();
             if (bonus.isVisible()) {
-                yOfs += playerIndicator(player, bonus, Color::MAGENTA,
-                                        player.getBonusRemainingTime() / player.getBonusDuration(), xOfs, yOfs);
+                yOfs += playerIndicator(state, bonus, Color::MAGENTA, state.bonusRemainingTime / state.bonusDuration,
+                                        xOfs, yOfs);
             }
 
             const auto &health = indicators.getHealth();
             if (health.isVisible()) {
-                yOfs += playerIndicator(player, health, Color::RED, player.getLife() / D6_MAX_LIFE, xOfs, yOfs);
+                yOfs += playerIndicator(state, health, Color::RED, state.life / D6_MAX_LIFE, xOfs, yOfs);
             }
 
             const auto &name = indicators.getName();
             const auto &bullets = indicators.getBullets();
 
             Float32 space = 0.08f;
-            Float32 nameWidth = name.isVisible() ? space + player.getPerson().getName().size() * 0.15f : 0;
-            std::string bulletString = Format("{0}") << player.getAmmo();
-            Float32 bulletWidth = bullets.isVisible() ? space + bulletString.size() * 0.15f : 0;
+            Float32 nameWidth = name.isVisible() ? space + font.getTextWidth(player.getPerson().getName(), 0.3f) : 0;
+            FormatBuffer<16> bulletString;
+            bulletPattern.format(bulletString, state.ammo);
+            Float32 bulletWidth = bullets.isVisible() ? space + font.getTextWidth(bulletString.c_str(), bulletString.size(), 0.3f) : 0;
             Float32 bonusWidth = bonus.isVisible() ? space + 0.3f : 0;
             Float32 totalWidth = nameWidth + bulletWidth + bonusWidth;
             Float32 halfWidth = totalWidth / 2;
@@ -328,36 +386,36 @@ namespace Duel6 {
 
             if (bullets.isVisible()) {
                 Float32 bulletX = xStart + nameWidth + bulletWidth / 2;
-                bulletIndicator(player, bullets, bulletX, yOfs);
+                bulletIndicator(state, bullets, bulletX, yOfs);
             }
 
             if (bonus.isVisible()) {
                 Float32 bonusX = xStart + nameWidth + bulletWidth + bonusWidth / 2;
-                bonusIndicator(player, bonus, bonusX, yOfs);
+                bonusIndicator(state, bonus, bonusX, yOfs);
             }
 
             if (name.isVisible() || bullets.isVisible() || bonus.isVisible()) {
                 yOfs += 0.4f;
             }
 
-            roundKills(player, xOfs, yOfs);
+            roundKills(state, xOfs, yOfs);
         }
     }
 
-    void WorldRenderer::roundKills(const Player &player, Float32 xOfs, Float32 yOfs) const {
-        Float32 width = (2 * player.getRoundKills() - 1) * 0.1f;
+    void WorldRenderer::roundKills(const RenderState::PlayerState &player, Float32 xOfs, Float32 yOfs) const {
+        Float32 width = (2 * player.roundKills - 1) * 0.1f;
         Float32 X = xOfs + 0.05f - width / 2;
         Float32 Y = yOfs + 0.1f;
 
-        for (Int32 i = 0; i < player.getRoundKills(); i++, X += 0.2f) {
+        for (Int32 i = 0; i < player.roundKills; i++, X += 0.2f) {
             renderer.point(Vector(X, Y, 0.5f), 5.0f, Color::BLUE);
         }
     }
 
-    void WorldRenderer::invulRing(const Player &player) const {
-        Vector playerCentre = player.getCentre();
-        Float32 radius = player.getDimensions().length() / 2.0f;
-        Int32 p = Int32(player.getBonusRemainingTime() * 30) % 360;
+    void WorldRenderer::invulRing(const RenderState::PlayerState &player) const {
+        Vector playerCentre = player.getCollisionRect(video.getInterpolation()).getCentre();
+        Float32 radius = player.dimensions.length() / 2.0f;
+        Int32 p = Int32(player.bonusRemainingTime * 30) % 360;
 
         for (Int32 uh = p; uh < 360 + p; uh += 15) {
             Int32 u = uh % 360;
@@ -366,9 +424,9 @@ namespace Duel6 {
         }
     }
 
-    void WorldRenderer::invulRings(const std::vector<Player> &players) const {
-        for (const Player &player : players) {
-            if (player.isInvulnerable()) {
+    void WorldRenderer::invulRings(const RenderState &state) const {
+        for (const RenderState::PlayerState &player : state.players) {
+            if (player.invulnerable) {
                 invulRing(player);
             }
         }
@@ -390,8 +448,8 @@ namespace Duel6 {
         video.setMode(Video::Mode::Perspective);
     }
 
-    void WorldRenderer::infoMessages() const {
-        const InfoMessageQueue &messageQueue = game.getRound().getWorld().getMessageQueue();
+    void WorldRenderer::infoMessages(const RenderState &state) const {
+        const InfoMessageQueue &messageQueue = state.messages;
 
         if (game.getSettings().getScreenMode() == ScreenMode::FullScreen) {
             messageQueue.renderAllMessages(renderer, game.getPlayers().front().getView(), 20, font);
@@ -402,6 +460,100 @@ namespace Duel6 {
         }
     }
 
+    void WorldRenderer::elevators(const RenderState &state, ViewCulling &culling, Float32 interpolation) const {
+        Texture texture = game.getResources().getElevatorTextures();
+        for (const RenderState::ElevatorState &elevator : state.elevators) {
+            Vector position = elevator.getPosition(interpolation);
+            if (culling.isVisible(Vector(position.x, position.y - 0.3f), Vector(1.0f, 0.3f))) {
+                Elevator::render(renderer, texture, position);
+            }
+        }
+    }
+
+    void WorldRenderer::bonuses(const RenderState &state, ViewCulling &culling) const {
+        for (const RenderState::BonusState &bonus : state.bonuses) {
+            if (culling.isVisible(bonus.position, Vector(1.0f, 1.0f))) {
+                Material material = Material::makeMaskedTexture(bonus.texture);
+                renderer.quadXY(bonus.position, Vector(1.0f, 1.0f), Vector(0.1f, 0.9f, Float32(bonus.textureIndex)),
+                                Vector(0.8f, -0.8f), material);
+            }
+        }
+    }
+
+    void WorldRenderer::objectSprites(const RenderState &state, ViewCulling &culling, Float32 interpolation) const {
+        for (Size i = 0; i < state.transparentBegin; i++) {
+            objectSprite(state.sprites[i], culling, interpolation);
+        }
+
+        renderer.enableDepthWrite(false);
+
+        for (Size i = state.transparentBegin; i < state.sprites.size(); i++) {
+            objectSprite(state.sprites[i], culling, interpolation);
+        }
+
+        renderer.enableDepthWrite(true);
+        renderer.setBlendFunc(BlendFunc::None);
+    }
+
+    void WorldRenderer::objectSprite(const RenderState::SpriteState &sprite, ViewCulling &culling,
+                                     Float32 interpolation) const {
+        // Rotation may swing a sprite into the view, there are only a few rotated ones
+        if (sprite.zRotation != 0.0) {
+            culling.addVisible();
+        } else if (!culling.isVisible(sprite.position, sprite.size)) {
+            return;
+        }
+
+        Vector position = sprite.previousPosition + (sprite.position - sprite.previousPosition) * interpolation;
+        bool transparent = sprite.blendFunc != BlendFunc::None;
+
+        if (sprite.noDepth) {
+            renderer.enableDepthTest(false);
+        }
+        if (transparent) {
+            renderer.setBlendFunc(sprite.blendFunc);
+        }
+
+        Material material(sprite.texture, Color(255, 255, 255, Uint8(255 * sprite.alpha)), !transparent);
+
+        bool rotated = sprite.zRotation != 0.0;
+        if (rotated) {
+            Matrix rotate = Matrix::rotateAroundPoint(sprite.zRotation, Vector::UNIT_Z, position + sprite.rotationCentre);
+            renderer.setModelMatrix(rotate);
+        }
+
+        Vector texturePos = Vector(sprite.reversed ? 1.0f : 0.0f, 1.0f, Float32(sprite.textureIndex));
+        Vector textureSize = Vector(sprite.reversed ? -1.0f : 1.0f, -1.0f);
+
+        renderer.quadXY(Vector(position.x, position.y, sprite.z), sprite.size, texturePos, textureSize, material);
+
+        if (rotated) {
+            renderer.setModelMatrix(Matrix::IDENTITY);
+        }
+
+        if (sprite.noDepth) {
+            renderer.enableDepthTest(true);
+        }
+    }
+
+    void WorldRenderer::explosions(const RenderState &state, ViewCulling &culling) const {
+        renderer.enableDepthTest(false);
+
+        Texture textures = game.getResources().getExplosionTextures();
+        for (const Explosion &explosion : state.explosions) {
+            Vector position = explosion.centre - Vector(explosion.now, explosion.now);
+            position.z = 0.6f;
+            Vector size = Vector(2 * explosion.now, 2 * explosion.now);
+            if (!culling.isVisible(position, size)) {
+                continue;
+            }
+            Material material = Material::makeMaskedColoredTexture(textures, explosion.color);
+            renderer.quadXY(position, size, Vector::ZERO, Vector(1, 1), material);
+        }
+
+        renderer.enableDepthTest(true);
+    }
+
     void WorldRenderer::shotCollisionBox(const ShotList &shotList) const {
         shotList.forEach([this](const Shot &shot) -> bool {
             const auto &rect = shot.getCollisionRect();
@@ -410,57 +562,66 @@ namespace Duel6 {
         });
     }
 
-    void WorldRenderer::view(const Player &player) const {
-        const Camera &camera = player.getCamera();
-        Matrix viewMatrix = Matrix::lookAt(camera.getPosition(), camera.getFront(), camera.getUp());
+    void WorldRenderer::view(const RenderState &state, Size playerIndex) const {
+        const RenderState::PlayerState &player = state.players[playerIndex];
+        Float32 interpolation = video.getInterpolation();
+        Matrix viewMatrix = Matrix::lookAt(player.getCameraPosition(interpolation), player.cameraFront,
+                                           player.cameraUp);
         renderer.setViewMatrix(viewMatrix);
 
         if (game.getSettings().isWireframe()) {
             renderer.enableWireframe(true);
         }
 
-        const World &world = game.getRound().getWorld();
-        walls(world.getLevelRenderData().getWalls());
-        sprites(world.getLevelRenderData().getSprites());
-        world.getElevatorList().render(renderer);
-        world.getBonusList().render(renderer);
-        world.getSpriteList().render(renderer);
-        invulRings(game.getPlayers());
-        water(world.getLevelRenderData().getWater());
-        youAreHere();
-
-        for (const Player &hpPlayer : game.getPlayers()) {
-            playerStatus(hpPlayer);
+        const LevelRenderData &levelRenderData = game.getRound().getWorld().getLevelRenderData();
+        ViewCulling chunkCulling(player.getVisibleArea(interpolation));
+        ViewCulling objectCulling(player.getVisibleArea(interpolation));
+        levelRenderData.findVisibleFaces(chunkCulling, wallRanges, spriteRanges, waterRanges);
+
+        walls(levelRenderData.getWalls(), wallRanges);
+        sprites(levelRenderData.getSprites(), spriteRanges);
+        elevators(state, objectCulling, interpolation);
+        bonuses(state, objectCulling);
+        objectSprites(state, objectCulling, interpolation);
+        invulRings(state);
+        water(levelRenderData.getWater(), waterRanges);
+        youAreHere(state);
+
+        for (Size i = 0; i < state.players.size(); i++) {
+            playerStatus(game.getPlayers()[i], state.players[i]);
         }
         //shotCollisionBox(world.getShotList());
 
-        world.getExplosionList().render(renderer);
+        explosions(state, objectCulling);
+        cullingStats.push_back({chunkCulling.getVisible(), chunkCulling.getCulled(), objectCulling.getVisible(),
+                                objectCulling.getCulled()});
 
         if (game.getSettings().isWireframe()) {
             renderer.enableWireframe(false);
         }
     }
 
-    Color WorldRenderer::getGameOverOverlay() const {
-        Float32 overlay = game.getRound().getRemainingGameOverWait() / D6_GAME_OVER_WAIT;
+    Color WorldRenderer::getGameOverOverlay(const RenderState &state) const {
+        Float32 overlay = state.remainingGameOverWait / D6_GAME_OVER_WAIT;
         return Color(128, 0, 0, Uint8(200 - 200 * overlay));
     }
 
-    void WorldRenderer::fullScreen() const {
+    void WorldRenderer::fullScreen(const RenderState &state) const {
         const Player &player = game.getPlayers().front();
         setView(player.getView());
         background(game.getResources().getBcgTextures().at(game.getRound().getWorld().getBackground()));
         video.setMode(Video::Mode::Perspective);
-        view(player);
+        view(state, 0);
 
-        if (game.getRound().hasWinner()) {
-            Color overlayColor = getGameOverOverlay();
+        if (state.winner) {
+            Color overlayColor = getGameOverOverlay(state);
             screenCurtain(overlayColor);
         }
     }
 
-    void WorldRenderer::splitScreen() const {
-        for (const Player &player : game.getPlayers()) {
+    void WorldRenderer::splitScreen(const RenderState &state) const {
+        for (Size i = 0; i < state.players.size(); i++) {
+            const Player &player = game.getPlayers()[i];
             video.setMode(Video::Mode::Orthogonal);
             splitBox(player.getView());
 
@@ -468,36 +629,44 @@ namespace Duel6 {
             background(game.getResources().getBcgTextures().at(game.getRound().getWorld().getBackground()));
 
             video.setMode(Video::Mode::Perspective);
-            view(player);
+            view(state, i);
 
-            if (!player.isAlive()) {
+            if (!state.players[i].alive) {
                 screenCurtain(Color(255, 0, 0, 128));
             }
         }
     }
 
-    void WorldRenderer::render() const {
+    void WorldRenderer::render(const RenderState &state) const {
         const GameSettings &settings = game.getSettings();
 
         renderer.clearBuffers();
+        renderer.setGlobalTime(state.time);
+        renderer.beginBatch();
+        cullingStats.clear();
 
         if (settings.getScreenMode() == ScreenMode::FullScreen) {
-            fullScreen();
+            fullScreen(state);
         } else {
-            splitScreen();
+            splitScreen(state);
         }
 
         video.setMode(Video::Mode::Orthogonal);
         setView(0, 0, video.getScreen().getClientWidth(), video.getScreen().getClientHeight());
 
-        infoMessages();
+        infoMessages(state);
 
         if (settings.isShowFps()) {
             fpsCounter();
         }
 
+        if (settings.isShowProfiler()) {
+            profilerOverlay(state);
+            cullingOverlay();
+        }
+
         if (settings.isShowRanking() && settings.getScreenMode() == ScreenMode::FullScreen) {
-            playerRankings();
+            playerRankings(state);
         }
 
         if (settings.isRoundLimit()) {
@@ -505,15 +674,17 @@ namespace Duel6 {
         }
 
         if (game.isDisplayingScoreTab()) {
-            roundOverSummary();
+            roundOverSummary(state);
         }
 
-        if (game.getRound().hasWinner()) {
-            if (game.isOver()) {
-                gameOverSummary();
+        if (state.winner) {
+            if (state.over) {
+                gameOverSummary(state);
             } else {
-                roundOverSummary();
+                roundOverSummary(state);
             }
         }
+
+        renderer.endBatch();
     }
 }
@@ -38,81 +38,112 @@
 #include "FaceList.h"
 #include "ShotList.h"
 #include "Ranking.h"
+#include "Profiler.h"
+#include "RenderState.h"
+#include "ViewCulling.h"
 
 namespace Duel6 {
     class Game;
 
     class WorldRenderer {
+    private:
+        struct CullingStats {
+            Size visibleChunks;
+            Size culledChunks;
+            Size visibleObjects;
+            Size culledObjects;
+        };
+
     private:
         const Font &font;
         const Video &video;
         const Game &game;
         Renderer &renderer;
+        mutable std::vector<FaceList::Range> wallRanges;
+        mutable std::vector<FaceList::Range> spriteRanges;
+        mutable std::vector<FaceList::Range> waterRanges;
+        mutable std::vector<CullingStats> cullingStats; // Of every view in the last frame
 
     public:
         WorldRenderer(AppService &appService, const Game &game);
 
-        void render() const;
+        void render(const RenderState &state) const;
 
     private:
         void setView(const PlayerView &view) const;
 
         void setView(int x, int y, int width, int height) const;
 
-        void view(const Player &player) const;
+        void view(const RenderState &state, Size playerIndex) const;
 
-        void fullScreen() const;
+        void fullScreen(const RenderState &state) const;
 
-        void splitScreen() const;
+        void splitScreen(const RenderState &state) const;
 
-        void walls(const FaceList &walls) const;
+        void walls(const FaceList &walls, const std::vector<FaceList::Range> &ranges) const;
 
-        void water(const FaceList &water) const;
+        void water(const FaceList &water, const std::vector<FaceList::Range> &ranges) const;
 
-        void sprites(const FaceList &sprites) const;
+        void sprites(const FaceList &sprites, const std::vector<FaceList::Range> &ranges) const;
 
         void background(Texture texture) const;
 
-        void playerRankings() const;
+        void playerRankings(const RenderState &state) const;
 
         Int32 renderRankingEntry(const Ranking::Entry &entry, Int32 posX, Int32 posY, Int32 maxLength) const;
 
         Int32 renderRankingEntry(const Ranking::Entry &entry, Int32 posX, Int32 posY, Int32 maxLength, Float32 charHeight, bool extended) const;
 
-        void roundOverSummary() const;
+        void roundOverSummary(const RenderState &state) const;
 
-        void gameOverSummary() const;
+        void gameOverSummary(const RenderState &state) const;
 
         void roundsPlayed() const;
 
         void fpsCounter() const;
 
-        void youAreHere() const;
+        void profilerOverlay(const RenderState &state) const;
+
+        void cullingOverlay() const;
 
-        void roundKills(const Player &player, Float32 xOfs, Float32 yOfs) const;
+        void youAreHere(const RenderState &state) const;
 
-        void playerStatus(const Player &player) const;
+        void roundKills(const RenderState::PlayerState &player, Float32 xOfs, Float32 yOfs) const;
 
-        Float32 playerIndicator(const Player &player, const Indicator &indicator, const Color &color, Float32 value,
-                                Float32 xOfs, Float32 yOfs) const;
+        void playerStatus(const Player &player, const RenderState::PlayerState &state) const;
+
+        Float32 playerIndicator(const RenderState::PlayerState &player, const Indicator &indicator,
+                                const Color &color, Float32 value, Float32 xOfs, Float32 yOfs) const;
 
         void playerName(const Player &player, const Indicator &indicator, Float32 xOfs, Float32 yOfs) const;
 
-        void bulletIndicator(const Player &player, const Indicator &indicator, Float32 xOfs, Float32 yOfs) const;
+        void bulletIndicator(const RenderState::PlayerState &player, const Indicator &indicator,
+                             Float32 xOfs, Float32 yOfs) const;
 
-        void bonusIndicator(const Player &player, const Indicator &indicator, Float32 xOfs, Float32 yOfs) const;
+        void bonusIndicator(const RenderState::PlayerState &player, const Indicator &indicator,
+                            Float32 xOfs, Float32 yOfs) const;
 
-        void invulRings(const std::vector<Player> &players) const;
+        void invulRings(const RenderState &state) const;
 
-        void invulRing(const Player &player) const;
+        void invulRing(const RenderState::PlayerState &player) const;
 
         void splitBox(const PlayerView &view) const;
 
         void screenCurtain(const Color &color) const;
 
-        void infoMessages() const;
+        void infoMessages(const RenderState &state) const;
+
+        Color getGameOverOverlay(const RenderState &state) const;
+
+        void elevators(const RenderState &state, ViewCulling &culling, Float32 interpolation) const;
+
+        void bonuses(const RenderState &state, ViewCulling &culling) const;
+
+        void objectSprites(const RenderState &state, ViewCulling &culling, Float32 interpolation) const;
+
+        void objectSprite(const RenderState::SpriteState &sprite, ViewCulling &culling, Float32 interpolation) const;
 
-        Color getGameOverOverlay() const;
+        void explosions(const RenderState &state, ViewCulling &culling) const;
 
         void shotCollisionBox(const ShotList &shotList) const;
     };
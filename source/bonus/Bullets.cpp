@@ -41,7 +41,7 @@ namespace Duel6 {
         }
 
         void Bullets::onApply(Player &player, World &world, Int32 duration) const {
-            Int32 bullets = 5 + Math::random(12);
+            Int32 bullets = 5 + world.getRandom().random(12);
             player.pickAmmo(bullets);
             world.getMessageQueue().add(player, Format("Bullets +{0}") << bullets);
         }
@@ -0,0 +1,208 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_COLLISION_SPATIALGRID_H
+#define DUEL6_COLLISION_SPATIALGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include "../Type.h"
+#include "../Rectangle.h"
+
+namespace Duel6 {
+    /**
+     * Uniform broadphase grid with unit cells matching level blocks. Every item is registered under
+     * a unique key; queries return candidate items ordered by key, so callers relying on iteration
+     * order (e.g. insertion order) get the same results as a linear scan. Items outside the level
+     * are clamped to the border cells.
+     */
+    template<class Item>
+    class SpatialGrid {
+    public:
+        typedef Uint32 Key;
+
+    private:
+        struct Entry {
+            Key key;
+            Item item;
+        };
+
+        struct Bounds {
+            Int32 left;
+            Int32 bottom;
+            Int32 right;
+            Int32 top;
+
+            bool operator==(const Bounds &other) const {
+                return left == other.left && bottom == other.bottom && right == other.right && top == other.top;
+            }
+        };
+
+        struct Record {
+            Item item;
+            Bounds bounds;
+        };
+
+        Int32 width;
+        Int32 height;
+        std::vector<std::vector<Entry>> cells;
+        std::unordered_map<Key, Record> items;
+        mutable std::vector<Entry> found;
+
+    public:
+        SpatialGrid()
+                : width(0), height(0) {}
+
+        SpatialGrid(Int32 width, Int32 height) {
+            resize(width, height);
+        }
+
+        void resize(Int32 width, Int32 height) {
+            this->width = std::max(width, 1);
+            this->height = std::max(height, 1);
+            cells.clear();
+            cells.resize(Size(this->width) * this->height);
+            items.clear();
+        }
+
+        void clear() {
+            for (auto &cell : cells) {
+                cell.clear();
+            }
+            items.clear();
+        }
+
+        Size size() const {
+            return items.size();
+        }
+
+        void insert(Key key, const Item &item, const Rectangle &rect) {
+            Bounds bounds = getBounds(rect);
+            items[key] = Record{item, bounds};
+            forEachCell(bounds, [key, &item](std::vector<Entry> &cell) {
+                cell.push_back(Entry{key, item});
+            });
+        }
+
+        void remove(Key key) {
+            auto iter = items.find(key);
+            if (iter == items.end()) {
+                return;
+            }
+
+            forEachCell(iter->second.bounds, [key](std::vector<Entry> &cell) {
+                for (Size i = 0; i < cell.size(); i++) {
+                    if (cell[i].key == key) {
+                        cell[i] = cell.back();
+                        cell.pop_back();
+                        break;
+                    }
+                }
+            });
+            items.erase(iter);
+        }
+
+        void move(Key key, const Rectangle &rect) {
+            auto iter = items.find(key);
+            if (iter == items.end()) {
+                return;
+            }
+
+            if (!(getBounds(rect) == iter->second.bounds)) {
+                Item item = iter->second.item;
+                remove(key);
+                insert(key, item, rect);
+            }
+        }
+
+        // Appends items whose cells overlap the rectangle, ordered by key and without duplicates
+        void query(const Rectangle &rect, std::vector<Item> &result) const {
+            forEach(rect, [&result](Key key, const Item &item) -> bool {
+                result.push_back(item);
+                return true;
+            });
+        }
+
+        // Calls handler(key, item) for the same items as query() until it returns false.
+        // The handler must not query this grid.
+        template<class Handler>
+        void forEach(const Rectangle &rect, Handler handler) const {
+            found.clear();
+            forEachCell(getBounds(rect), [this](const std::vector<Entry> &cell) {
+                found.insert(found.end(), cell.begin(), cell.end());
+            });
+
+            std::sort(found.begin(), found.end(), [](const Entry &left, const Entry &right) {
+                return left.key < right.key;
+            });
+
+            for (Size i = 0; i < found.size(); i++) {
+                if (i > 0 && found[i].key == found[i - 1].key) {
+                    continue;
+                }
+                if (!handler(found[i].key, found[i].item)) {
+                    break;
+                }
+            }
+        }
+
+    private:
+        Int32 clampX(Float32 x) const {
+            return std::min(std::max(Int32(std::floor(x)), 0), width - 1);
+        }
+
+        Int32 clampY(Float32 y) const {
+            return std::min(std::max(Int32(std::floor(y)), 0), height - 1);
+        }
+
+        Bounds getBounds(const Rectangle &rect) const {
+            return Bounds{clampX(rect.left.x), clampY(rect.left.y), clampX(rect.right.x), clampY(rect.right.y)};
+        }
+
+        template<class Handler>
+        void forEachCell(const Bounds &bounds, Handler handler) {
+            for (Int32 y = bounds.bottom; y <= bounds.top; y++) {
+                for (Int32 x = bounds.left; x <= bounds.right; x++) {
+                    handler(cells[Size(y) * width + x]);
+                }
+            }
+        }
+
+        template<class Handler>
+        void forEachCell(const Bounds &bounds, Handler handler) const {
+            for (Int32 y = bounds.bottom; y <= bounds.top; y++) {
+                for (Int32 x = bounds.left; x <= bounds.right; x++) {
+                    handler(cells[Size(y) * width + x]);
+                }
+            }
+        }
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 
 #include "WorldCollision.h"
 #include "../Rectangle.h"
+#include "../BinaryStream.h"
 namespace Duel6 {
 //TODO Duplicity
 static const float GRAVITATIONAL_ACCELERATION = -11.0f;
@@ -244,4 +245,26 @@ bool CollidingEntity::isOnElevator() const {
 bool CollidingEntity::isOnGround() const {
     return lastCollisionCheck.onGround;
 }
+
+    void CollidingEntity::saveState(BinaryWriter &writer, const ElevatorList &elevators) const {
+        writer.write(position);
+        writer.write(acceleration);
+        writer.write(externalForces);
+        writer.write(externalForcesSpeed);
+        writer.write(velocity);
+        writer.write(dimensions);
+        writer.write(Int16(elevators.indexOf(elevator)));
+        writer.write(lastCollisionCheck);
+    }
+
+    void CollidingEntity::restoreState(BinaryReader &reader, const ElevatorList &elevators) {
+        reader.read(position);
+        reader.read(acceleration);
+        reader.read(externalForces);
+        reader.read(externalForcesSpeed);
+        reader.read(velocity);
+        reader.read(dimensions);
+        elevator = elevators.get(reader.read<Int16>());
+        reader.read(lastCollisionCheck);
+    }
 }
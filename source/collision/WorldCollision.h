@@ -36,6 +36,10 @@
 #include "../Defines.h"
 
 namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
     class CollisionCheckResult {
     public:
         bool up = false;
@@ -87,6 +91,10 @@ namespace Duel6 {
         bool isOnElevator() const;
         bool isOnGround() const;
 
+        void saveState(BinaryWriter &writer, const ElevatorList &elevators) const;
+
+        void restoreState(BinaryReader &reader, const ElevatorList &elevators);
+
     private:
         Vector boundingBoxHorizontal = {HORIZONTAL_DELTA, DELTA_HEIGHT};
         Vector boundingBoxVertical = {VERTICAL_DELTA, DELTA_HEIGHT};
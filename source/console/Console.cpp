@@ -33,10 +33,12 @@ Popis: Hlavni funkce
 #include <stdlib.h>
 #include <string.h>
 #include "ConsoleException.h"
+#include "ConsoleFileSink.h"
 #include "Console.h"
 
 namespace Duel6 {
     Console::Console(Uint32 flags) {
+        owner = std::this_thread::get_id();
         visible = false;
         insert = false;
         curpos = 0;
@@ -59,6 +61,8 @@ namespace Duel6 {
     }
 
     Console::~Console() {
+        flush();
+        logFile.reset();
         vars.clear();
         cmds.clear();
         aliases.clear();
@@ -71,7 +75,43 @@ namespace Duel6 {
         memset(&text[0], '\n', CON_TEXT_SIZE);
     }
 
-    Console &Console::print(const std::string &str) {
+    Console &Console::print(const std::string &str, LogLevel level) {
+        queue.push(level, str);
+        if (std::this_thread::get_id() == owner) {
+            flush();
+        }
+        return *this;
+    }
+
+    Console &Console::printLine(const std::string &str, LogLevel level) {
+        // One message keeps the line together when other threads print at the same time
+        return print(str + "\n", level);
+    }
+
+    void Console::flush() {
+        ConsoleQueue::Message message;
+        while (queue.pop(message)) {
+            if (logFile) {
+                logFile->write(message.level, message.text);
+            }
+            write(message.text);
+        }
+    }
+
+    bool Console::openLogFile(const std::string &path, LogLevel level) {
+        FILE *file = fopen(path.c_str(), "wt");
+        if (file == nullptr) {
+            return false;
+        }
+        logFile = std::make_unique<ConsoleFileSink>(file, level);
+        return true;
+    }
+
+    void Console::closeLogFile() {
+        logFile.reset();
+    }
+
+    void Console::write(const std::string &str) {
         for (size_t pos = 0; pos < str.length(); ++pos) {
             char tx = str[pos];
 
@@ -98,13 +138,6 @@ namespace Duel6 {
         }
 
         scroll = 0;
-        return *this;
-    }
-
-    Console &Console::printLine(const std::string &str) {
-        print(str);
-        print("\n");
-        return *this;
     }
 
     void Console::verifyRegistration(const std::string &proc, const std::string &name, bool isNull) {
@@ -237,6 +237,37 @@ namespace Duel6 {
         }
     }
 
+    /*
+    ==================================================
+    Log command
+    ==================================================
+    */
+    static void CON_CmdLog(Console &console, const Console::Arguments &args) {
+        if (args.length() == 2 && args.get(1) == "off") {
+            console.closeLogFile();
+            console.print(CON_Lang("Logging to file has been stopped\n"));
+            return;
+        }
+
+        LogLevel level = LogLevel::Info;
+        if (args.length() == 3 && args.get(2) == "error") {
+            level = LogLevel::Error;
+        } else if (args.length() == 3 && args.get(2) == "verbose") {
+            level = LogLevel::Verbose;
+        } else if (args.length() != 2 && !(args.length() == 3 && args.get(2) == "info")) {
+            console.print(CON_Format(CON_Lang("{0} : Usage {0} <file_name | off> [error | info | verbose]\n"))
+                                  << args.get(0));
+            return;
+        }
+
+        if (!console.openLogFile(args.get(1), level)) {
+            console.print(CON_Format(CON_Lang("{0} : Unable to open file {1}\n")) << args.get(0) << args.get(1));
+            return;
+        }
+
+        console.print(CON_Format(CON_Lang("Logging to file {0}\n")) << args.get(1));
+    }
+
     /*
     ==================================================
     Register basic console commands
@@ -250,5 +281,6 @@ namespace Duel6 {
         console.registerCommand("exec", CON_CmdParse);
         console.registerCommand("alias", CON_CmdAlias);
         console.registerCommand("archive", CON_CmdArchive);
+        console.registerCommand("log", CON_CmdLog);
     }
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include "ConsoleFileSink.h"
+
+namespace Duel6 {
+    namespace {
+        // The writer is woken by every message, the timeout only covers a wake-up it missed
+        const std::chrono::milliseconds idleWait(50);
+    }
+
+    ConsoleFileSink::ConsoleFileSink(FILE *file, LogLevel level)
+            : file(file), level(level), stopping(false) {
+        worker = std::thread(&ConsoleFileSink::work, this);
+    }
+
+    ConsoleFileSink::~ConsoleFileSink() {
+        stopping = true;
+        condition.notify_one();
+        worker.join();
+        fclose(file);
+    }
+
+    void ConsoleFileSink::write(LogLevel messageLevel, const std::string &text) {
+        if (messageLevel > level) {
+            return;
+        }
+        queue.push(messageLevel, text);
+        // Notifying without the mutex keeps the writing thread lock-free
+        condition.notify_one();
+    }
+
+    void ConsoleFileSink::work() {
+        while (true) {
+            bool stop = stopping;
+            bool written = false;
+            ConsoleQueue::Message message;
+            while (queue.pop(message)) {
+                fwrite(message.text.data(), 1, message.text.size(), file);
+                written = true;
+            }
+            if (written) {
+                fflush(file);
+            }
+            if (stop) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, idleWait);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_CONSOLE_CONSOLEFILESINK_H
+#define DUEL6_CONSOLE_CONSOLEFILESINK_H
+
+#include <stdio.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "ConsoleQueue.h"
+
+namespace Duel6 {
+    /**
+     * Writes console messages up to a log level to a file on its own thread, so that the thread
+     * printing them never waits for the disk.
+     */
+    class ConsoleFileSink {
+    private:
+        FILE *file;
+        LogLevel level;
+        ConsoleQueue queue;
+        std::atomic<bool> stopping;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::thread worker;
+
+    public:
+        /**
+         * @param file open file the sink takes over and closes when destroyed
+         */
+        ConsoleFileSink(FILE *file, LogLevel level);
+
+        /**
+         * Writes all messages written so far before closing the file.
+         */
+        ~ConsoleFileSink();
+
+        ConsoleFileSink(const ConsoleFileSink &) = delete;
+
+        ConsoleFileSink &operator=(const ConsoleFileSink &) = delete;
+
+        LogLevel getLevel() const {
+            return level;
+        }
+
+        /**
+         * Queues the text unless it is more detailed than the level of the sink. Must be called from one thread at a time.
+         */
+        void write(LogLevel messageLevel, const std::string &text);
+
+    private:
+        void work();
+    };
+}
+
+#endif
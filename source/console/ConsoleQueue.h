@@ -0,0 +1,87 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_CONSOLE_CONSOLEQUEUE_H
+#define DUEL6_CONSOLE_CONSOLEQUEUE_H
+
+#include <atomic>
+#include <string>
+#include "../Type.h"
+
+namespace Duel6 {
+    enum class LogLevel {
+        Error,
+        Info,
+        Verbose
+    };
+
+    /**
+     * Lock-free queue of console messages. Any thread can push, only one thread at a time can pop.
+     */
+    class ConsoleQueue {
+    public:
+        struct Message {
+            LogLevel level;
+            std::string text;
+        };
+
+    private:
+        struct Node {
+            std::atomic<Node *> next;
+            Message message;
+
+            Node()
+                    : next(nullptr), message{LogLevel::Info, ""} {}
+
+            Node(LogLevel level, const std::string &text)
+                    : next(nullptr), message{level, text} {}
+        };
+
+    private:
+        std::atomic<Node *> head; // Most recently pushed node
+        Node *tail; // Already popped node, the one after it holds the oldest message
+
+    public:
+        ConsoleQueue();
+
+        ~ConsoleQueue();
+
+        ConsoleQueue(const ConsoleQueue &) = delete;
+
+        ConsoleQueue &operator=(const ConsoleQueue &) = delete;
+
+        void push(LogLevel level, const std::string &text);
+
+        /**
+         * Takes the oldest message. Returns false when the queue is empty or when the oldest message
+         * is still being linked by its producer, the next call gets it then.
+         */
+        bool pop(Message &message);
+    };
+}
+
+#endif
@@ -125,7 +125,7 @@ namespace Duel6 {
         line += input.substr((size_t) inputscroll);
         font.print(0, y, conCol[0], line);
 
-        int x = font.getCharWidth() * (curpos - inputscroll + 1);
+        int x = font.getTextWidth(line.substr(0, size_t(curpos - inputscroll + 1)), font.getCharHeight());
         std::string cursor = insert ? std::string(1, char(219)) : "_";
         if ((clock() % CLOCKS_PER_SEC) > (CLOCKS_PER_SEC >> 1)) {
             font.print(x, y, conCol[0], cursor);
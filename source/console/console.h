@@ -39,11 +39,13 @@ Potrebuje: Knihovnu mylib
 #include <list>
 #include <functional>
 #include <memory>
+#include <thread>
 #include <SDL2/SDL_keyboard.h>
 
 #include "../Type.h"
 #include "../Format.h"
 #include "../Font.h"
+#include "ConsoleQueue.h"
 
 #define CON_Lang(x)         x
 #define CON_Format          Format
@@ -74,6 +76,8 @@ Potrebuje: Knihovnu mylib
 #define CON_C_ENTER         SDLK_RETURN
 
 namespace Duel6 {
+    class ConsoleFileSink;
+
     class Console {
     public:
         enum Flags {
@@ -289,6 +293,10 @@ namespace Duel6 {
         std::list<std::string> cbuf;                  // Prikazovy buffer
         int aliasloop;                    // Pocet provedenych aliasu (proti zacykleni)
 
+        ConsoleQueue queue;                           // Zpravy cekajici na zapsani do bufferu
+        std::thread::id owner;                        // Vlakno, ktere zpravy zapisuje
+        std::unique_ptr<ConsoleFileSink> logFile;     // Soubor se zaznamem zprav
+
     public:
         explicit Console(Uint32 flags);
 
@@ -296,9 +304,26 @@ namespace Duel6 {
 
         void render(Renderer &renderer, Int32 csX, Int32 csY, const Font &font);
 
-        Console &print(const std::string &str);
+        /**
+         * Can be called from any thread. Text printed by the thread that created the console is shown at once,
+         * text from other threads when that thread calls flush().
+         */
+        Console &print(const std::string &str, LogLevel level = LogLevel::Info);
+
+        Console &printLine(const std::string &str, LogLevel level = LogLevel::Info);
 
-        Console &printLine(const std::string &str);
+        /**
+         * Moves queued text to the console and the log file, called by the thread that created the console.
+         */
+        void flush();
+
+        /**
+         * Starts writing printed text up to the given level to a file, replacing the previous log file.
+         * @return false when the file cannot be opened
+         */
+        bool openLogFile(const std::string &path, LogLevel level);
+
+        void closeLogFile();
 
         void keyEvent(SDL_Keycode keyCode, Uint16 keyModifiers);
 
@@ -347,6 +372,8 @@ namespace Duel6 {
         static void registerBasicCommands(Console &c_ptr);
 
     private:
+        void write(const std::string &str);
+
         void verifyRegistration(const std::string &proc, const std::string &name, bool isNull);
 
         std::string expandLine(const std::string &line);
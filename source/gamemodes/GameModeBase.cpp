@@ -32,15 +32,16 @@ namespace Duel6 {
         game.getAppService().getConsole().printLine("...Preparing base players");
         Level::StartingPositionList startingPositions;
         world.getLevel().findStartingPositions(startingPositions);
-        std::shuffle(startingPositions.begin(), startingPositions.end(), Math::randomEngine);
+        Random &random = world.getRandom();
+        random.shuffle(startingPositions.begin(), startingPositions.end());
 
         Size playerIndex = 0;
         for (Player &player : players) {
             auto &ammoRange = game.getSettings().getAmmoRange();
-            Int32 ammo = Math::random(ammoRange.first, ammoRange.second);
+            Int32 ammo = random.random(ammoRange.first, ammoRange.second);
             Level::StartingPosition position = startingPositions[playerIndex % startingPositions.size()];
             player.startRound(world, position.first, position.second, ammo,
-                              Weapon::getRandomEnabled(game.getSettings()));
+                              Weapon::getRandomEnabled(game.getSettings(), random));
             playerIndex++;
         }
     }
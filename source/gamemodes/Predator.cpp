@@ -29,7 +29,7 @@
 
 namespace Duel6 {
     void Predator::initializeRound(Game &game, std::vector<Player> &players, World &world) {
-        Size predatorIndex = Math::random(world.getPlayers().size());
+        Size predatorIndex = world.getRandom().random(Int32(world.getPlayers().size()));
         predator = &players[predatorIndex];
 
         eventListener = std::make_unique<PredatorPlayerEventListener>(world.getMessageQueue(), game.getSettings(),
@@ -68,18 +68,19 @@ namespace Duel6 {
         world.getLevel().findStartingPositions(startingPositions);
 
         Int32 layerSpan = Int32(startingPositions.size()) / teamsCount;
-        Int32 randomizer = Math::random(teamsCount);
+        Random &random = world.getRandom();
+        Int32 randomizer = random.random(teamsCount);
         Int32 playerIndex = 0;
         for (Player &player : players) {
             auto &ammoRange = game.getSettings().getAmmoRange();
-            Int32 ammo = Math::random(ammoRange.first, ammoRange.second);
+            Int32 ammo = random.random(ammoRange.first, ammoRange.second);
 
             Int32 playerTeam = (playerIndex + randomizer) % teamsCount;
-            Int32 playerTeamIndex = Math::random(layerSpan);
+            Int32 playerTeamIndex = random.random(layerSpan);
             Int32 index = (layerSpan * playerTeam) + playerTeamIndex % layerSpan;
 
             Level::StartingPosition position = startingPositions[index];
-            player.startRound(world, position.first, position.second, ammo, Weapon::getRandomEnabled(game.getSettings()));
+            player.startRound(world, position.first, position.second, ammo, Weapon::getRandomEnabled(game.getSettings(), random));
             playerIndex++;
         }
     }
@@ -177,7 +177,7 @@ namespace Duel6 {
                 Color bcgColor = (index == selected) ? highlightColor : colors.background;
 
                 renderer.quadXY(Vector(x, Y - (itemHeight - 1)), Vector(width - 1, itemHeight - 1), bcgColor);
-                font.print(x, Y - shift, fontColor, label.substr(0, size_t(width) / 8));
+                font.print(x, Y - shift, fontColor, label.substr(0, size_t(width / font.getCharWidth())));
             }
         }
 
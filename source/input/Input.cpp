@@ -34,7 +34,7 @@ namespace Duel6 {
         : console(console) {
         auto load = SDL_GameControllerAddMappingsFromFile("controllers.txt");
         if (load == -1) {
-            console.printLine("...Failed to load controllers.txt with controllers' mappings");
+            console.printLine("...Failed to load controllers.txt with controllers' mappings", LogLevel::Error);
         }
         if (!SDL_WasInit(SDL_INIT_JOYSTICK)) {
             console.printLine("...Starting joypad sub-system");
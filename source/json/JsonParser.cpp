@@ -25,128 +25,247 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 #include "JsonParser.h"
 
 namespace Duel6 {
     namespace Json {
         namespace {
-            std::unordered_set<Uint8> stringSentinel = {'"'};
-            std::unordered_set<Uint8> numberChars = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '.', '-',
-                                                     'e'};
+            enum CharacterClass : Uint8 {
+                Whitespace = 0x01,
+                NumberChar = 0x02,
+                NumberStart = 0x04
+            };
+
+            struct CharacterTable {
+                Uint8 classes[256];
+
+                constexpr CharacterTable()
+                        : classes() {
+                    classes[Uint8(' ')] = classes[Uint8('\t')] = classes[Uint8('\n')] = classes[Uint8('\r')] = Whitespace;
+                    for (char chr = '0'; chr <= '9'; chr++) {
+                        classes[Uint8(chr)] = NumberChar | NumberStart;
+                    }
+                    classes[Uint8('-')] = classes[Uint8('.')] = NumberChar | NumberStart;
+                    classes[Uint8('e')] = NumberChar;
+                }
+
+                bool is(Uint8 chr, CharacterClass characterClass) const {
+                    return (classes[chr] & characterClass) != 0;
+                }
+            };
+
+            constexpr CharacterTable characterTable;
+
+            class ValueBuilder : public Parser::Handler {
+            private:
+                Value root;
+                std::vector<Value> containers;
+                std::vector<std::string> propertyNames;
+
+            public:
+                Value getRoot() const {
+                    return root;
+                }
+
+                void onNull() override {
+                    add(Value::makeNull());
+                }
+
+                void onBoolean(bool value) override {
+                    add(Value::makeBoolean(value));
+                }
+
+                void onNumber(Float64 value) override {
+                    add(Value::makeNumber(value));
+                }
+
+                void onString(const std::string &value) override {
+                    add(Value::makeString(value));
+                }
+
+                void onObjectStart() override {
+                    Value object = Value::makeObject();
+                    add(object);
+                    containers.push_back(object);
+                }
+
+                void onProperty(const std::string &name) override {
+                    propertyNames.push_back(name);
+                }
+
+                void onObjectEnd() override {
+                    containers.pop_back();
+                }
+
+                void onArrayStart() override {
+                    Value array = Value::makeArray();
+                    add(array);
+                    containers.push_back(array);
+                }
+
+                void onArrayEnd() override {
+                    containers.pop_back();
+                }
+
+            private:
+                void add(Value value) {
+                    if (containers.empty()) {
+                        root = value;
+                    } else if (containers.back().getType() == Value::Type::Object) {
+                        containers.back().set(propertyNames.back(), value);
+                        propertyNames.pop_back();
+                    } else {
+                        containers.back().add(value);
+                    }
+                }
+            };
         }
 
         Value Parser::parse(const std::string &fileName) const {
-            File file(fileName, File::Mode::Binary, File::Access::Read);
-            return parseValue(file);
+            ValueBuilder builder;
+            parse(fileName, builder);
+            return builder.getRoot();
+        }
+
+        void Parser::parse(const std::string &fileName, Handler &handler) const {
+            std::vector<Uint8> data = File::load(fileName);
+            parse(data.data(), data.size(), handler);
+        }
+
+        void Parser::parse(const Uint8 *data, Size length, Handler &handler) const {
+            Input input = {data, data + length};
+            parseValue(input, handler);
         }
 
-        Value Parser::parseValue(File &file) const {
-            Uint8 byte = peekNextCharacter(file);
+        void Parser::parseValue(Input &input, Handler &handler) const {
+            Uint8 byte = peekNextCharacter(input);
             Value::Type type = determineValueType(byte);
 
             switch (type) {
                 case Value::Type::Null:
-                    return parseNull(file);
+                    parseNull(input, handler);
+                    return;
                 case Value::Type::Object:
-                    return parseObject(file);
+                    parseObject(input, handler);
+                    return;
                 case Value::Type::Array:
-                    return parseArray(file);
+                    parseArray(input, handler);
+                    return;
                 case Value::Type::Number:
-                    return parseNumber(file);
+                    parseNumber(input, handler);
+                    return;
                 case Value::Type::String:
-                    return parseString(file);
+                    parseString(input, handler);
+                    return;
                 case Value::Type::Boolean:
-                    return parseBoolean(file);
+                    parseBoolean(input, handler);
+                    return;
             }
 
             D6_THROW(JsonException, "Unhandled type: " + std::to_string((Int32) type));
         }
 
-        Value Parser::parseNull(File &file) const {
-            readExpected(file, "null");
-            return Value::makeNull();
+        void Parser::parseNull(Input &input, Handler &handler) const {
+            readExpected(input, "null");
+            handler.onNull();
         }
 
-        Value Parser::parseObject(File &file) const {
-            Value value = Value::makeObject();
+        void Parser::parseObject(Input &input, Handler &handler) const {
+            readExpected(input, '{');
+            handler.onObjectStart();
 
-            readExpected(file, '{');
-            Uint8 next = peekNextCharacter(file);
+            Uint8 next = peekNextCharacter(input);
             if (next == '}') {
-                readExpected(file, '}');
+                readExpected(input, '}');
             } else {
                 do {
-                    readWhitespaceAndExpected(file, '"');
-                    std::string propName = readUntil(file, stringSentinel);
-                    readExpected(file, '"');
-                    readWhitespaceAndExpected(file, ':');
-                    value.set(propName, parseValue(file));
+                    peekNextCharacter(input);
+                    handler.onProperty(readString(input));
+                    peekNextCharacter(input);
+                    readExpected(input, ':');
+                    parseValue(input, handler);
 
-                    next = peekNextCharacter(file);
+                    next = peekNextCharacter(input);
 
                     if (next != ',' && next != '}') {
                         D6_THROW(JsonException,
                                  std::string("Expected next property or end of object, got: ") + (char) next);
                     }
 
-                    readExpected(file, (char) next);
+                    readExpected(input, (char) next);
                 } while (next == ',');
             }
 
-            return value;
+            handler.onObjectEnd();
         }
 
-        Value Parser::parseArray(File &file) const {
-            Value value = Value::makeArray();
+        void Parser::parseArray(Input &input, Handler &handler) const {
+            readExpected(input, '[');
+            handler.onArrayStart();
 
-            readExpected(file, '[');
-            Uint8 next = peekNextCharacter(file);
+            Uint8 next = peekNextCharacter(input);
             if (next == ']') {
-                readExpected(file, ']');
+                readExpected(input, ']');
             } else {
                 do {
-                    value.add(parseValue(file));
-                    next = peekNextCharacter(file);
+                    parseValue(input, handler);
+                    next = peekNextCharacter(input);
 
                     if (next != ',' && next != ']') {
                         D6_THROW(JsonException, std::string("Expect next item or end of array, got: ") + (char) next);
                     }
 
-                    readExpected(file, (char) next);
+                    readExpected(input, (char) next);
                 } while (next == ',');
             }
 
-            return value;
+            handler.onArrayEnd();
         }
 
-        Value Parser::parseString(File &file) const {
-            readExpected(file, '"');
-            std::string val = readUntil(file, stringSentinel);
-            readExpected(file, '"');
-            return Value::makeString(val);
+        void Parser::parseString(Input &input, Handler &handler) const {
+            handler.onString(readString(input));
         }
 
-        Value Parser::parseNumber(File &file) const {
-            std::string val = readWhile(file, numberChars);
-            return Value::makeNumber(std::stod(val));
+        void Parser::parseNumber(Input &input, Handler &handler) const {
+            const Uint8 *start = input.position;
+            while (input.position != input.end && characterTable.is(*input.position, NumberChar)) {
+                ++input.position;
+            }
+
+            // strtod needs a terminated string; numbers are short enough for a local buffer
+            char number[64];
+            Size length = Size(input.position - start);
+            if (length >= sizeof(number)) {
+                D6_THROW(JsonException, "Number literal too long");
+            }
+            memcpy(number, start, length);
+            number[length] = 0;
+
+            char *numberEnd;
+            Float64 value = strtod(number, &numberEnd);
+            if (numberEnd == number) {
+                D6_THROW(JsonException, std::string("Invalid number: ") + number);
+            }
+            handler.onNumber(value);
         }
 
-        Value Parser::parseBoolean(File &file) const {
-            Uint8 byte = peekNextCharacter(file);
+        void Parser::parseBoolean(Input &input, Handler &handler) const {
+            Uint8 byte = peekNextCharacter(input);
             bool val = (byte == 't');
-            readExpected(file, val ? "true" : "false");
-            return Value::makeBoolean(val);
+            readExpected(input, val ? "true" : "false");
+            handler.onBoolean(val);
         }
 
-        Uint8 Parser::peekNextCharacter(File &file) const {
-            while (!file.isEof()) {
-                Uint8 byte;
-                file.read(&byte, 1, 1);
-
-                if (byte != ' ' && byte != '\t' && byte != '\n' && byte != '\r') {
-                    file.seek(-1, File::Seek::Cur);
+        Uint8 Parser::peekNextCharacter(Input &input) const {
+            while (input.position != input.end) {
+                Uint8 byte = *input.position;
+                if (!characterTable.is(byte, Whitespace)) {
                     return byte;
                 }
+                ++input.position;
             }
 
             D6_THROW(JsonException, "Unexpected end of input stream while skipping whitespace");
@@ -161,7 +280,7 @@ namespace Duel6 {
                 return Value::Type::String;
             } else if (firstByte == 't' || firstByte == 'f') {
                 return Value::Type::Boolean;
-            } else if ((firstByte >= '0' && firstByte <= '9') || firstByte == '-' || firstByte == '.') {
+            } else if (characterTable.is(firstByte, NumberStart)) {
                 return Value::Type::Number;
             } else if (firstByte == 'n') {
                 return Value::Type::Null;
@@ -170,57 +289,31 @@ namespace Duel6 {
             D6_THROW(JsonException, std::string("Invalid value type found, starting with: ") + (char) firstByte);
         }
 
-        void Parser::readExpected(File &file, const std::string &expected) const {
+        void Parser::readExpected(Input &input, const std::string &expected) const {
             for (char chr : expected) {
-                readExpected(file, chr);
+                readExpected(input, chr);
             }
         }
 
-        void Parser::readExpected(File &file, char expected) const {
-            Uint8 byte;
-            file.read(&byte, 1, 1);
+        void Parser::readExpected(Input &input, char expected) const {
+            if (input.position == input.end) {
+                D6_THROW(JsonException, std::string("Parsing error - expected: ") + expected + ", got end of input");
+            }
+            Uint8 byte = *input.position++;
             if (expected != byte) {
                 D6_THROW(JsonException, std::string("Parsing error - expected: ") + expected + ", got: " + (char) byte);
             }
         }
 
-        void Parser::readWhitespaceAndExpected(File &file, char expected) const {
-            peekNextCharacter(file);
-            readExpected(file, expected);
-        }
-
-        std::string Parser::readUntil(File &file, const std::unordered_set<Uint8> &sentinels) const {
-            std::string result;
-
-            while (!file.isEof()) {
-                Uint8 byte;
-                file.read(&byte, 1, 1);
-                if (sentinels.find(byte) != sentinels.end()) {
-                    file.seek(-1, File::Seek::Cur);
-                    return result;
-                } else {
-                    result += (char) byte;
-                }
-            }
-
-            D6_THROW(JsonException, "Unexpected end of input stream while looking for sentinel");
-        }
-
-        std::string Parser::readWhile(File &file, const std::unordered_set<Uint8> &allowed) const {
-            std::string result;
-
-            while (!file.isEof()) {
-                Uint8 byte;
-                file.read(&byte, 1, 1);
-                if (allowed.find(byte) == allowed.end()) {
-                    file.seek(-1, File::Seek::Cur);
-                    break;
-                } else {
-                    result += (char) byte;
-                }
+        std::string Parser::readString(Input &input) const {
+            readExpected(input, '"');
+            const Uint8 *start = input.position;
+            auto sentinel = (const Uint8 *) memchr(start, '"', input.end - start);
+            if (sentinel == nullptr) {
+                D6_THROW(JsonException, "Unexpected end of input stream while looking for sentinel");
             }
-
-            return result;
+            input.position = sentinel + 1;
+            return std::string((const char *) start, (const char *) sentinel);
         }
     }
-}
\ No newline at end of file
+}
@@ -33,38 +33,73 @@
 
 namespace Duel6 {
     namespace Json {
+        /**
+         * Reads the whole input into memory once and tokenizes it from there.
+         * Documents can be either built as a Value tree or streamed to a Handler,
+         * which avoids materializing large arrays nobody needs as Values.
+         */
         class Parser {
         public:
-            Value parse(const std::string &fileName) const;
+            class Handler {
+            public:
+                virtual ~Handler() = default;
+
+                virtual void onNull() {}
+
+                virtual void onBoolean(bool value) {}
+
+                virtual void onNumber(Float64 value) {}
+
+                virtual void onString(const std::string &value) {}
+
+                virtual void onObjectStart() {}
+
+                virtual void onProperty(const std::string &name) {}
+
+                virtual void onObjectEnd() {}
+
+                virtual void onArrayStart() {}
+
+                virtual void onArrayEnd() {}
+            };
 
         private:
-            Uint8 peekNextCharacter(File &file) const;
+            struct Input {
+                const Uint8 *position;
+                const Uint8 *end;
+            };
 
-            void readExpected(File &file, const std::string &expected) const;
+        public:
+            Value parse(const std::string &fileName) const;
 
-            void readExpected(File &file, char expected) const;
+            void parse(const std::string &fileName, Handler &handler) const;
+
+            void parse(const Uint8 *data, Size length, Handler &handler) const;
+
+        private:
+            Uint8 peekNextCharacter(Input &input) const;
 
-            void readWhitespaceAndExpected(File &file, char expected) const;
+            void readExpected(Input &input, const std::string &expected) const;
 
-            std::string readUntil(File &file, const std::unordered_set<Uint8> &sentinels) const;
+            void readExpected(Input &input, char expected) const;
 
-            std::string readWhile(File &file, const std::unordered_set<Uint8> &allowed) const;
+            std::string readString(Input &input) const;
 
             Value::Type determineValueType(Uint8 firstByte) const;
 
-            Value parseValue(File &file) const;
+            void parseValue(Input &input, Handler &handler) const;
 
-            Value parseNull(File &file) const;
+            void parseNull(Input &input, Handler &handler) const;
 
-            Value parseObject(File &file) const;
+            void parseObject(Input &input, Handler &handler) const;
 
-            Value parseArray(File &file) const;
+            void parseArray(Input &input, Handler &handler) const;
 
-            Value parseNumber(File &file) const;
+            void parseNumber(Input &input, Handler &handler) const;
 
-            Value parseString(File &file) const;
+            void parseString(Input &input, Handler &handler) const;
 
-            Value parseBoolean(File &file) const;
+            void parseBoolean(Input &input, Handler &handler) const;
         };
     }
 }
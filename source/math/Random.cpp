@@ -0,0 +1,69 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "Random.h"
+#include "../BinaryStream.h"
+
+namespace Duel6 {
+    Random::Random(Uint32 seed)
+            : engine(seed) {}
+
+    Random::Random(Uint32 seed, Uint32 stream) {
+        std::seed_seq sequence = {seed, stream};
+        engine.seed(sequence);
+    }
+
+    void Random::saveState(BinaryWriter &writer) const {
+        // Snapshots are only restored by the process that took them, so the engine goes as it is in memory
+        writer.write(engine);
+    }
+
+    void Random::restoreState(BinaryReader &reader) {
+        reader.read(engine);
+    }
+
+    Int32 Random::random(Int32 max) {
+        if (max <= 1) {
+            return 0;
+        }
+        return Int32((Uint64(engine()) * Uint64(max)) >> 32);
+    }
+
+    Int32 Random::random(Int32 min, Int32 max) {
+        return min + random(max - min + 1);
+    }
+
+    Float32 Random::random(Float32 min, Float32 max) {
+        Float32 unit = Float32(engine() >> 8) * (1.0f / 16777216.0f);
+        return min + (max - min) * unit;
+    }
+
+    Uint32 Random::makeSeed() {
+        std::random_device randomDevice;
+        return randomDevice();
+    }
+}
@@ -0,0 +1,91 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_MATH_RANDOM_H
+#define DUEL6_MATH_RANDOM_H
+
+#include <random>
+#include <utility>
+#include "../Type.h"
+
+namespace Duel6 {
+    class BinaryWriter;
+
+    class BinaryReader;
+
+    /**
+     * Seeded random number generator for gameplay. Unlike Math::random it produces the same sequence
+     * for the same seed with any standard library, which makes recorded matches reproducible.
+     * Snapshots keep the whole state of the engine, so restoring one takes the same time however many numbers
+     * were drawn since the seed.
+     */
+    class Random {
+    public:
+        typedef std::mt19937 Engine;
+
+    private:
+        Engine engine;
+
+    public:
+        explicit Random(Uint32 seed);
+
+        /**
+         * Generator of one of several independent streams derived from a single seed, e.g. one per round.
+         */
+        Random(Uint32 seed, Uint32 stream);
+
+        /** @return random number from 0 to max - 1 */
+        Int32 random(Int32 max);
+
+        /** @return random number from min to max including both */
+        Int32 random(Int32 min, Int32 max);
+
+        /** @return random number from min to max, max excluded */
+        Float32 random(Float32 min, Float32 max);
+
+        Uint32 next() {
+            return engine();
+        }
+
+        void saveState(BinaryWriter &writer) const;
+
+        void restoreState(BinaryReader &reader);
+
+        template<class Iterator>
+        void shuffle(Iterator first, Iterator last) {
+            // Fisher-Yates, std::shuffle differs between standard library implementations
+            for (auto count = last - first; count > 1; count--) {
+                std::swap(first[count - 1], first[random(Int32(count))]);
+            }
+        }
+
+        /** @return seed drawn from the system random device */
+        static Uint32 makeSeed();
+    };
+}
+
+#endif
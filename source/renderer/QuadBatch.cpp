@@ -0,0 +1,56 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "QuadBatch.h"
+
+namespace Duel6 {
+    void QuadBatch::add(const Vector &p1, const Vector &t1,
+                        const Vector &p2, const Vector &t2,
+                        const Vector &p3, const Vector &t3,
+                        const Vector &p4, const Vector &t4,
+                        const Material &material, BlendFunc blendFunc) {
+        Key key = {material.getTexture(), material.isMasked(), blendFunc};
+        if (commands.empty() || !(commands.back().key == key)) {
+            commands.push_back(Command{key, vertices.size(), 0});
+        }
+        commands.back().count += VERTICES_PER_QUAD;
+
+        // Same winding as the triangle fan p1, p2, p3, p4 used by the immediate quad
+        const Color &color = material.getColor();
+        vertices.push_back(Vertex{p1, t1, color});
+        vertices.push_back(Vertex{p2, t2, color});
+        vertices.push_back(Vertex{p3, t3, color});
+        vertices.push_back(Vertex{p1, t1, color});
+        vertices.push_back(Vertex{p3, t3, color});
+        vertices.push_back(Vertex{p4, t4, color});
+    }
+
+    void QuadBatch::clear() {
+        vertices.clear();
+        commands.clear();
+    }
+}
@@ -0,0 +1,101 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_RENDERER_QUADBATCH_H
+#define DUEL6_RENDERER_QUADBATCH_H
+
+#include <vector>
+#include "../math/Vector.h"
+#include "../Color.h"
+#include "../Material.h"
+#include "RendererTypes.h"
+
+namespace Duel6 {
+    /**
+     * Textured quads collected by a renderer between beginBatch() and flushBatch().
+     * Every quad is stored as two triangles. Consecutive quads with the same texture,
+     * alpha masking and blend function are merged into a single draw command, so submission
+     * order (and therefore the blending result) is kept intact.
+     */
+    class QuadBatch {
+    public:
+        struct Vertex {
+            Vector xyz;
+            Vector str;
+            Color color;
+        };
+
+        struct Key {
+            Texture texture;
+            bool masked;
+            BlendFunc blendFunc;
+
+            bool operator==(const Key &key) const {
+                return texture == key.texture && masked == key.masked && blendFunc == key.blendFunc;
+            }
+        };
+
+        struct Command {
+            Key key;
+            Size first;
+            Size count;
+        };
+
+        static const Size VERTICES_PER_QUAD = 6;
+
+    private:
+        std::vector<Vertex> vertices;
+        std::vector<Command> commands;
+
+    public:
+        void add(const Vector &p1, const Vector &t1,
+                 const Vector &p2, const Vector &t2,
+                 const Vector &p3, const Vector &t3,
+                 const Vector &p4, const Vector &t4,
+                 const Material &material, BlendFunc blendFunc);
+
+        void clear();
+
+        bool isEmpty() const {
+            return commands.empty();
+        }
+
+        Size getQuadCount() const {
+            return vertices.size() / VERTICES_PER_QUAD;
+        }
+
+        const std::vector<Vertex> &getVertices() const {
+            return vertices;
+        }
+
+        const std::vector<Command> &getCommands() const {
+            return commands;
+        }
+    };
+}
+
+#endif
@@ -92,6 +92,19 @@ namespace Duel6 {
 
         virtual void clearBuffers() = 0;
 
+        /**
+         * Starts collecting textured quads instead of drawing each of them immediately.
+         * Any other draw call or state change flushes the collected quads first, so the result
+         * is the same as without batching, just with far fewer draw calls.
+         */
+        virtual void beginBatch() = 0;
+
+        virtual void flushBatch() = 0;
+
+        virtual void endBatch() = 0;
+
+        virtual bool isBatching() const = 0;
+
         virtual void triangle(const Vector &p1, const Vector &p2, const Vector &p3, const Color &color) = 0;
 
         virtual void triangle(const Vector &p1, const Vector &t1,
@@ -129,6 +142,9 @@ namespace Duel6 {
         virtual void frame(const Vector &position, const Vector &size, Float32 width, const Color &color) = 0;
 
         virtual std::unique_ptr<RendererBuffer> makeBuffer(const FaceList &faceList) = 0;
+
+        /** Total number of bytes face buffers have sent to the graphics memory so far. */
+        virtual Uint64 getUploadedBytes() const = 0;
     };
 }
 
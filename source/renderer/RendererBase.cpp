@@ -29,9 +29,12 @@
 
 namespace Duel6 {
     RendererBase::RendererBase()
-            : projectionMatrix(Matrix::IDENTITY), viewMatrix(Matrix::IDENTITY), modelMatrix(Matrix::IDENTITY) {}
+            : projectionMatrix(Matrix::IDENTITY), viewMatrix(Matrix::IDENTITY), modelMatrix(Matrix::IDENTITY),
+              batching(false), blendFunc(BlendFunc::None), appliedBlendFunc(BlendFunc::None),
+              uploadedBytes(0) {}
 
     void RendererBase::setProjectionMatrix(const Matrix &m) {
+        flushBatch();
         projectionMatrix = m;
     }
 
@@ -40,6 +43,7 @@ namespace Duel6 {
     }
 
     void RendererBase::setViewMatrix(const Matrix &m) {
+        flushBatch();
         viewMatrix = m;
     }
 
@@ -48,12 +52,57 @@ namespace Duel6 {
     }
 
     void RendererBase::setModelMatrix(const Matrix &m) {
+        flushBatch();
         modelMatrix = m;
     }
 
     Matrix RendererBase::getModelMatrix() const {
         return modelMatrix;
     }
+
+    void RendererBase::setBlendFunc(BlendFunc func) {
+        blendFunc = func;
+        if (!batching) {
+            useBlendFunc(func);
+        }
+    }
+
+    void RendererBase::beginBatch() {
+        flushBatch();
+        batching = true;
+    }
+
+    void RendererBase::flushBatch() {
+        if (!batch.isEmpty()) {
+            drawBatch(batch);
+            batch.clear();
+        }
+        useBlendFunc(blendFunc);
+    }
+
+    void RendererBase::endBatch() {
+        flushBatch();
+        batching = false;
+    }
+
+    bool RendererBase::submitQuad(const Vector &p1, const Vector &t1,
+                                  const Vector &p2, const Vector &t2,
+                                  const Vector &p3, const Vector &t3,
+                                  const Vector &p4, const Vector &t4,
+                                  const Material &material) {
+        if (!batching) {
+            return false;
+        }
+        batch.add(p1, t1, p2, t2, p3, t3, p4, t4, material, blendFunc);
+        return true;
+    }
+
+    void RendererBase::useBlendFunc(BlendFunc func) {
+        if (func != appliedBlendFunc) {
+            applyBlendFunc(func);
+            appliedBlendFunc = func;
+        }
+    }
     
     void RendererBase::quadXY(const Vector &position, const Vector &size, const Color &color) {
         Vector p2(position.x, position.y + size.y, position.z);
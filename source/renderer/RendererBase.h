@@ -29,6 +29,7 @@
 #define DUEL6_RENDERER_RENDERER_BASE_H
 
 #include "Renderer.h"
+#include "QuadBatch.h"
 
 namespace Duel6 {
 
@@ -39,6 +40,11 @@ namespace Duel6 {
         Matrix viewMatrix;
         Matrix modelMatrix;
         Matrix mvpMatrix;
+        QuadBatch batch;
+        bool batching;
+        BlendFunc blendFunc;
+        BlendFunc appliedBlendFunc;
+        Uint64 uploadedBytes;
 
     public:
         RendererBase();
@@ -55,6 +61,18 @@ namespace Duel6 {
 
         Matrix getModelMatrix() const override;
 
+        void setBlendFunc(BlendFunc func) override;
+
+        void beginBatch() override;
+
+        void flushBatch() override;
+
+        void endBatch() override;
+
+        bool isBatching() const override {
+            return batching;
+        }
+
         void quadXY(const Vector &position, const Vector &size, const Color &color) override;
 
         void quadXY(const Vector &position, const Vector &size, const Vector &texturePosition,
@@ -71,6 +89,31 @@ namespace Duel6 {
                     const Vector &textureSize, const Material &material) override;
 
         void frame(const Vector &position, const Vector &size, Float32 width, const Color &color) override;
+
+        Uint64 getUploadedBytes() const override {
+            return uploadedBytes;
+        }
+
+        void countUpload(Size bytes) {
+            uploadedBytes += bytes;
+        }
+
+    protected:
+        /**
+         * Queues the quad if a batch is open.
+         * @return false if the quad has to be drawn immediately
+         */
+        bool submitQuad(const Vector &p1, const Vector &t1,
+                        const Vector &p2, const Vector &t2,
+                        const Vector &p3, const Vector &t3,
+                        const Vector &p4, const Vector &t4,
+                        const Material &material);
+
+        void useBlendFunc(BlendFunc func);
+
+        virtual void applyBlendFunc(BlendFunc func) = 0;
+
+        virtual void drawBatch(const QuadBatch &batch) = 0;
     };
 }
 
@@ -28,6 +28,7 @@
 #ifndef DUEL6_RENDERER_RENDERERBUFFER_H
 #define DUEL6_RENDERER_RENDERERBUFFER_H
 
+#include "../Type.h"
 #include "../Material.h"
 
 namespace Duel6 {
@@ -39,7 +40,20 @@ namespace Duel6 {
 
         virtual void update(const FaceList &faceList) = 0;
 
-        virtual void render(const Material &material) = 0;
+        /**
+         * Faces from firstFace to the end of the list were replaced and their number may have changed.
+         */
+        virtual void replace(const FaceList &faceList, Size firstFace) = 0;
+
+        /**
+         * Faces [firstFace, firstFace + faceCount) were overwritten, the number of faces has not changed.
+         */
+        virtual void overwrite(const FaceList &faceList, Size firstFace, Size faceCount) = 0;
+
+        /**
+         * Draws faces [firstFace, firstFace + faceCount).
+         */
+        virtual void render(const Material &material, Size firstFace, Size faceCount) = 0;
     };
 }
 
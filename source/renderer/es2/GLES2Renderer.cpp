@@ -42,10 +42,13 @@ namespace Duel6 {
             "uniform mat4 mvp;"
                     "attribute vec3 vp;"
                     "attribute vec2 uvIn;"
+                    "attribute vec4 colorIn;"
                     "varying vec2 uvFrag;"
+                    "varying vec4 colorFrag;"
                     "void main() {"
                     "  gl_Position = mvp * vec4(vp, 1.0);"
                     "  uvFrag = uvIn;"
+                    "  colorFrag = colorIn;"
                     "}";
 
 
@@ -58,13 +61,14 @@ namespace Duel6 {
     static const char *textureFragmentShader =
             "precision highp float;"
                     "varying vec2 uvFrag;"
+                    "varying vec4 colorFrag;"
                     "uniform sampler2D textureUnit;"
                     "uniform bool alphaTest;"
                     "uniform vec4 modulateColor;"
                     "void main() {"
                     "  vec4 color = texture2D(textureUnit, uvFrag);"
                     "  if (alphaTest && color.w < 1.0) discard;"
-                    "  gl_FragColor = color * modulateColor;"
+                    "  gl_FragColor = color * modulateColor * colorFrag;"
                     "}";
 
 
@@ -99,10 +103,12 @@ namespace Duel6 {
         glAttachShader(textureProgram, tvs);
         glBindAttribLocation(textureProgram, 0, "vp");
         glBindAttribLocation(textureProgram, 1, "uvIn");
+        glBindAttribLocation(textureProgram, 2, "colorIn");
         glLinkProgram(textureProgram);
 
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, points);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, &points[9]);
+        glVertexAttrib4f(2, 1.0f, 1.0f, 1.0f, 1.0f);
     }
 
     Renderer::Info GLES2Renderer::getInfo() {
@@ -156,15 +162,21 @@ namespace Duel6 {
     }
 
     void GLES2Renderer::freeTexture(Texture::Id textureId) {
+        flushBatch();
+
         GLuint id = textureId;
         glDeleteTextures(1, &id);
     }
 
     void GLES2Renderer::readScreenData(Int32 width, Int32 height, Image &image) {
+        flushBatch();
+
         glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &image.at(0));
     }
 
     void GLES2Renderer::setViewport(Int32 x, Int32 y, Int32 width, Int32 height) {
+        flushBatch();
+
         glViewport(x, y, width, height);
     }
 
@@ -172,14 +184,18 @@ namespace Duel6 {
     }
 
     void GLES2Renderer::enableDepthTest(bool enable) {
+        flushBatch();
+
         enableOption(GL_DEPTH_TEST, enable);
     }
 
     void GLES2Renderer::enableDepthWrite(bool enable) {
+        flushBatch();
+
         glDepthMask(GLboolean(enable ? GL_TRUE : GL_FALSE));
     }
 
-    void GLES2Renderer::setBlendFunc(BlendFunc func) {
+    void GLES2Renderer::applyBlendFunc(BlendFunc func) {
         switch (func) {
             case BlendFunc::None:
                 glDisable(GL_BLEND);
@@ -196,10 +212,14 @@ namespace Duel6 {
     }
 
     void GLES2Renderer::clearBuffers() {
+        flushBatch();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
     void GLES2Renderer::point(const Vector &position, Float32 size, const Color &color) {
+        flushBatch();
+
         glUseProgram(colorProgram);
         glEnableVertexAttribArray(0);
         glDisableVertexAttribArray(1);
@@ -220,6 +240,8 @@ namespace Duel6 {
     }
 
     void GLES2Renderer::line(const Vector &from, const Vector &to, Float32 width, const Color &color) {
+        flushBatch();
+
         glLineWidth(width);
 
         glUseProgram(colorProgram);
@@ -245,6 +267,8 @@ namespace Duel6 {
     }
 
     void GLES2Renderer::triangle(const Vector &p1, const Vector &p2, const Vector &p3, const Color &color) {
+        flushBatch();
+
         glUseProgram(colorProgram);
         glEnableVertexAttribArray(0);
         glDisableVertexAttribArray(1);
@@ -274,6 +298,8 @@ namespace Duel6 {
                                  const Vector &p2, const Vector &t2,
                                  const Vector &p3, const Vector &t3,
                                  const Material &material) {
+        flushBatch();
+
         glUseProgram(textureProgram);
         glEnableVertexAttribArray(0);
         glEnableVertexAttribArray(1);
@@ -310,6 +336,35 @@ namespace Duel6 {
         glDrawArrays(GL_TRIANGLES, 0, 3);
     }
 
+    void GLES2Renderer::drawBatch(const QuadBatch &batch) {
+        const std::vector<QuadBatch::Vertex> &vertices = batch.getVertices();
+
+        glUseProgram(textureProgram);
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QuadBatch::Vertex), &vertices[0].xyz);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(QuadBatch::Vertex), &vertices[0].str);
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuadBatch::Vertex), &vertices[0].color);
+
+        glUniformMatrix4fv(glGetUniformLocation(textureProgram, "mvp"), 1, GL_FALSE, mvpMatrix.getStorage());
+        glUniform1i(glGetUniformLocation(textureProgram, "textureUnit"), 0);
+        Float32 colorData[] = {1.0f, 1.0f, 1.0f, 1.0f};
+        glUniform4fv(glGetUniformLocation(textureProgram, "modulateColor"), 1, colorData);
+
+        for (const QuadBatch::Command &command : batch.getCommands()) {
+            useBlendFunc(command.key.blendFunc);
+            glBindTexture(GL_TEXTURE_2D, command.key.texture);
+            glUniform1i(glGetUniformLocation(textureProgram, "alphaTest"), command.key.masked ? 1 : 0);
+            glDrawArrays(GL_TRIANGLES, GLint(command.first), GLsizei(command.count));
+        }
+
+        glDisableVertexAttribArray(2);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, points);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, &points[9]);
+        glVertexAttrib4f(2, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
     void GLES2Renderer::enableOption(GLenum option, bool enable) {
         if (enable) {
             glEnable(option);
@@ -61,8 +61,6 @@ namespace Duel6 {
 
         void enableDepthWrite(bool enable) override;
 
-        void setBlendFunc(BlendFunc func) override;
-
         void clearBuffers() override;
 
         void point(const Vector &position, Float32 size, const Color &color) override;
@@ -76,6 +74,11 @@ namespace Duel6 {
                       const Vector &p3, const Vector &t3,
                       const Material &material) override;
 
+    protected:
+        void applyBlendFunc(BlendFunc func) override;
+
+        void drawBatch(const QuadBatch &batch) override;
+
     private:
         void enableOption(GLenum option, bool enable);
     };
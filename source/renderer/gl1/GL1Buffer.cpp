@@ -45,11 +45,18 @@ namespace Duel6 {
     void GL1Buffer::update(const FaceList &faceList) {
     }
 
-    void GL1Buffer::render(const Material &material) {
+    void GL1Buffer::replace(const FaceList &faceList, Size firstFace) {
+    }
+
+    void GL1Buffer::overwrite(const FaceList &faceList, Size firstFace, Size faceCount) {
+    }
+
+    void GL1Buffer::render(const Material &material, Size firstFace, Size faceCount) {
         const auto &faces = faceList.getFaces();
-        const Vertex *vertex = faceList.getVertexes().data();
+        const Vertex *vertex = faceList.getVertexes().data() + 4 * firstFace;
 
-        for (const Face &face : faces) {
+        for (Size i = firstFace; i < firstFace + faceCount; i++) {
+            const Face &face = faces[i];
             const Vertex &v1 = vertex[0];
             const Vertex &v2 = vertex[1];
             const Vertex &v3 = vertex[2];
@@ -57,6 +64,12 @@ namespace Duel6 {
 
             Float32 currentTexture = face.getCurrentTexture();
 
+            if (v1.hasFlag(Vertex::Flag::Tile)) {
+                renderTiled(vertex, currentTexture, material);
+                vertex += 4;
+                continue;
+            }
+
             renderer.quad(getVertexPosition(v1), Vector(v1.u, v1.v, currentTexture),
                           getVertexPosition(v2), Vector(v2.u, v2.v, currentTexture),
                           getVertexPosition(v3), Vector(v3.u, v3.v, currentTexture),
@@ -67,9 +80,29 @@ namespace Duel6 {
         }
     }
 
+    void GL1Buffer::renderTiled(const Vertex *vertex, Float32 texture, const Material &material) {
+        // Fixed pipeline cannot repeat one layer of a clamped texture, so split the face back to blocks
+        Int32 columns = Int32(vertex[2].u + 0.5f);
+        Int32 rows = Int32(vertex[2].v + 0.5f);
+        Vector origin = getVertexPosition(vertex[0]);
+        Vector columnStep = (getVertexPosition(vertex[1]) - origin) / Float32(columns);
+        Vector rowStep = (getVertexPosition(vertex[3]) - origin) / Float32(rows);
+
+        for (Int32 row = 0; row < rows; row++) {
+            for (Int32 column = 0; column < columns; column++) {
+                Vector p = origin + columnStep * Float32(column) + rowStep * Float32(row);
+                renderer.quad(p, Vector(0.0f, 0.0f, texture),
+                              p + columnStep, Vector(0.99f, 0.0f, texture),
+                              p + columnStep + rowStep, Vector(0.99f, 0.99f, texture),
+                              p + rowStep, Vector(0.0f, 0.99f, texture),
+                              material);
+            }
+        }
+    }
+
     Vector GL1Buffer::getVertexPosition(const Duel6::Vertex &vertex) const {
         Float32 y = vertex.y;
-        if (vertex.getFlag() == Vertex::Flow) {
+        if (vertex.hasFlag(Vertex::Flag::Flow)) {
             y = y - waveHeight + Math::radianSin(renderer.getGlobalTime() * 2.13f + 1.05f * vertex.x) * waveHeight;
         }
         return Vector(vertex.x, y, vertex.z);
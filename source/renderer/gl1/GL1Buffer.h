@@ -48,9 +48,15 @@ namespace Duel6 {
 
         void update(const FaceList &faceList) override;
 
-        void render(const Material &material) override;
+        void replace(const FaceList &faceList, Size firstFace) override;
+
+        void overwrite(const FaceList &faceList, Size firstFace, Size faceCount) override;
+
+        void render(const Material &material, Size firstFace, Size faceCount) override;
 
     private:
+        void renderTiled(const Vertex *vertex, Float32 texture, const Material &material);
+
         Vector getVertexPosition(const Vertex &vertex) const;
     };
 }
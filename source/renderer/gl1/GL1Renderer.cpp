@@ -112,6 +112,8 @@ namespace Duel6 {
     }
 
     void GL1Renderer::freeTexture(Texture textureId) {
+        flushBatch();
+
         auto iterator = textureIdMap.find(textureId);
         if (iterator == textureIdMap.end()) {
             return;
@@ -124,6 +126,8 @@ namespace Duel6 {
     }
 
     Image GL1Renderer::makeScreenshot() {
+        flushBatch();
+
         GLint dimensions[4];
         glGetIntegerv(GL_VIEWPORT, dimensions);
 
@@ -137,22 +141,30 @@ namespace Duel6 {
     }
 
     void GL1Renderer::setViewport(Int32 x, Int32 y, Int32 width, Int32 height) {
+        flushBatch();
+
         glViewport(x, y, width, height);
     }
 
     void GL1Renderer::enableWireframe(bool enable) {
+        flushBatch();
+
         glPolygonMode(GL_FRONT_AND_BACK, enable ? GL_LINE : GL_FILL);
     }
 
     void GL1Renderer::enableDepthTest(bool enable) {
+        flushBatch();
+
         enableOption(GL_DEPTH_TEST, enable);
     }
 
     void GL1Renderer::enableDepthWrite(bool enable) {
+        flushBatch();
+
         glDepthMask(GLboolean(enable ? GL_TRUE : GL_FALSE));
     }
 
-    void GL1Renderer::setBlendFunc(BlendFunc func) {
+    void GL1Renderer::applyBlendFunc(BlendFunc func) {
         switch (func) {
             case BlendFunc::None:
                 glDisable(GL_BLEND);
@@ -177,6 +189,8 @@ namespace Duel6 {
     }
 
     void GL1Renderer::clearBuffers() {
+        flushBatch();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
@@ -201,6 +215,8 @@ namespace Duel6 {
     }
 
     void GL1Renderer::point(const Vector &position, Float32 size, const Color &color) {
+        flushBatch();
+
         glColor4ub(color.getRed(), color.getGreen(), color.getBlue(), color.getAlpha());
         glPointSize(size);
 
@@ -213,6 +229,8 @@ namespace Duel6 {
     }
 
     void GL1Renderer::line(const Vector &from, const Vector &to, Float32 width, const Color &color) {
+        flushBatch();
+
         glColor4ub(color.getRed(), color.getGreen(), color.getBlue(), color.getAlpha());
         glLineWidth(width);
 
@@ -226,6 +244,8 @@ namespace Duel6 {
     }
 
     void GL1Renderer::triangle(const Vector &p1, const Vector &p2, const Vector &p3, const Color &color) {
+        flushBatch();
+
         glColor4ub(color.getRed(), color.getGreen(), color.getBlue(), color.getAlpha());
 
         glBegin(GL_TRIANGLES);
@@ -241,6 +261,8 @@ namespace Duel6 {
                                const Vector &p2, const Vector &t2,
                                const Vector &p3, const Vector &t3,
                                const Material &material) {
+        flushBatch();
+
         auto textureIterator = textureIdMap.find(material.getTexture());
         if (textureIterator == textureIdMap.end()) {
             return;
@@ -281,6 +303,8 @@ namespace Duel6 {
     }
 
     void GL1Renderer::quad(const Vector &p1, const Vector &p2, const Vector &p3, const Vector &p4, const Color &color) {
+        flushBatch();
+
         glColor4ub(color.getRed(), color.getGreen(), color.getBlue(), color.getAlpha());
 
         glBegin(GL_TRIANGLE_FAN);
@@ -298,6 +322,10 @@ namespace Duel6 {
                            const Vector &p3, const Vector &t3,
                            const Vector &p4, const Vector &t4,
                            const Material &material) {
+        if (submitQuad(p1, t1, p2, t2, p3, t3, p4, t4, material)) {
+            return;
+        }
+
         auto textureIterator = textureIdMap.find(material.getTexture());
         if (textureIterator == textureIdMap.end()) {
             return;
@@ -339,6 +367,56 @@ namespace Duel6 {
         }
     }
 
+    void GL1Renderer::drawBatch(const QuadBatch &batch) {
+        const std::vector<QuadBatch::Vertex> &vertices = batch.getVertices();
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(QuadBatch::Vertex), &vertices[0].xyz);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(QuadBatch::Vertex), &vertices[0].str);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(QuadBatch::Vertex), &vertices[0].color);
+        glEnable(GL_TEXTURE_2D);
+
+        for (const QuadBatch::Command &command : batch.getCommands()) {
+            auto textureIterator = textureIdMap.find(command.key.texture);
+            if (textureIterator == textureIdMap.end()) {
+                continue;
+            }
+
+            useBlendFunc(command.key.blendFunc);
+            if (command.key.masked) {
+                glEnable(GL_ALPHA_TEST);
+                glAlphaFunc(GL_GEQUAL, 1.0f);
+            }
+
+            // Texture layers are separate textures here, so split the command wherever the layer changes
+            Size end = command.first + command.count;
+            Size first = command.first;
+            while (first < end) {
+                GLuint layer = GLuint(vertices[first].str.z);
+                Size last = first + QuadBatch::VERTICES_PER_QUAD;
+                while (last < end && GLuint(vertices[last].str.z) == layer) {
+                    last += QuadBatch::VERTICES_PER_QUAD;
+                }
+
+                glBindTexture(GL_TEXTURE_2D, textureIterator->second[layer]);
+                glDrawArrays(GL_TRIANGLES, GLint(first), GLsizei(last - first));
+                first = last;
+            }
+
+            if (command.key.masked) {
+                glDisable(GL_ALPHA_TEST);
+            }
+        }
+
+        glDisable(GL_TEXTURE_2D);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
     std::unique_ptr<RendererBuffer> GL1Renderer::makeBuffer(const FaceList &faceList) {
         return std::make_unique<GL1Buffer>(*this, faceList);
     }
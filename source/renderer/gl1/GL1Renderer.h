@@ -58,8 +58,6 @@ namespace Duel6 {
 
         void enableDepthWrite(bool enable) override;
 
-        void setBlendFunc(BlendFunc func) override;
-
         void setGlobalTime(Float32 time) override;
 
         Float32 getGlobalTime() const;
@@ -93,6 +91,11 @@ namespace Duel6 {
 
         std::unique_ptr<RendererBuffer> makeBuffer(const FaceList &faceList) override;
 
+    protected:
+        void applyBlendFunc(BlendFunc func) override;
+
+        void drawBatch(const QuadBatch &batch) override;
+
     private:
         void enableOption(GLenum option, bool enable);
     };
@@ -25,19 +25,20 @@
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
 #include <vector>
 #include "GL4Buffer.h"
+#include "GL4Renderer.h"
 #include "../../Vertex.h"
 #include "../../FaceList.h"
 
 namespace Duel6 {
-    GL4Buffer::GL4Buffer(GL4Program &program, const FaceList &faceList)
-            : program(program), elements(6 * faceList.getFaces().size()) {
+    GL4Buffer::GL4Buffer(GL4Renderer &renderer, GL4Program &program, const FaceList &faceList)
+            : renderer(renderer), program(program), capacity(faceList.getFaces().size()) {
         std::vector<Vertex> vertexBuffer;
-        createFaceListVertexBuffer(faceList, vertexBuffer);
+        createFaceListVertexBuffer(faceList, 0, faceList.getFaces().size(), vertexBuffer);
 
-        std::vector<Float32> textureIndexBuffer;
-        createFaceListTextureIndexBuffer(faceList, textureIndexBuffer);
+        createFaceListTextureIndexBuffer(faceList, textureIndexes);
 
         glGenVertexArrays(1, &vao);
         glBindVertexArray(vao);
@@ -45,6 +46,7 @@ namespace Duel6 {
         glGenBuffers(1, &vertexVbo);
         glBindBuffer(GL_ARRAY_BUFFER, vertexVbo);
         glBufferData(GL_ARRAY_BUFFER, vertexBuffer.size() * sizeof(Vertex), vertexBuffer.data(), GL_STATIC_DRAW);
+        renderer.countUpload(vertexBuffer.size() * sizeof(Vertex));
         //glNamedBufferStorage(vertexVbo, vertexBuffer.size() * sizeof(Float32), vertexBuffer.data(), 0); // GL 4.5
 
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
@@ -56,9 +58,9 @@ namespace Duel6 {
 
         glGenBuffers(1, &textureIndexVbo);
         glBindBuffer(GL_ARRAY_BUFFER, textureIndexVbo);
-        glBufferData(GL_ARRAY_BUFFER, textureIndexBuffer.size() * sizeof(Float32), textureIndexBuffer.data(),
-                     GL_STATIC_DRAW);
-        //glNamedBufferStorage(textureIndexVbo, textureIndexBuffer.size() * sizeof(Float32), textureIndexBuffer.data(), 0); // GL 4.5
+        glBufferData(GL_ARRAY_BUFFER, textureIndexes.size() * sizeof(Float32), textureIndexes.data(),
+                     faceList.getAnimatedRanges().empty() ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+        renderer.countUpload(textureIndexes.size() * sizeof(Float32));
 
         glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
         glEnableVertexAttribArray(2);
@@ -74,17 +76,79 @@ namespace Duel6 {
     }
 
     void GL4Buffer::update(const FaceList &faceList) {
-        std::vector<Float32> textureIndexBuffer;
-        createFaceListTextureIndexBuffer(faceList, textureIndexBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, textureIndexVbo);
+        for (const FaceList::Range &range : faceList.getAnimatedRanges()) {
+            updateTextureIndexes(faceList, range.first, range.count);
+
+            GLintptr offset = range.first * 6 * sizeof(Float32);
+            GLsizeiptr size = range.count * 6 * sizeof(Float32);
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, &textureIndexes[range.first * 6]);
+            renderer.countUpload(size);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void GL4Buffer::replace(const FaceList &faceList, Size firstFace) {
+        Size faceCount = faceList.getFaces().size();
+
+        if (faceCount > capacity) {
+            // Grow with some headroom, the list usually keeps growing (e.g. rising water)
+            capacity = std::max(faceCount, capacity + capacity / 2);
+            firstFace = 0;
+
+            glBindBuffer(GL_ARRAY_BUFFER, vertexVbo);
+            glBufferData(GL_ARRAY_BUFFER, 6 * capacity * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, textureIndexVbo);
+            glBufferData(GL_ARRAY_BUFFER, 6 * capacity * sizeof(Float32), nullptr, GL_DYNAMIC_DRAW);
+        }
+
+        textureIndexes.resize(6 * faceCount);
+        updateTextureIndexes(faceList, firstFace, faceCount - firstFace);
+
+        if (firstFace < faceCount) {
+            std::vector<Vertex> vertexBuffer;
+            createFaceListVertexBuffer(faceList, firstFace, faceCount - firstFace, vertexBuffer);
+
+            glBindBuffer(GL_ARRAY_BUFFER, vertexVbo);
+            glBufferSubData(GL_ARRAY_BUFFER, 6 * firstFace * sizeof(Vertex), vertexBuffer.size() * sizeof(Vertex),
+                            vertexBuffer.data());
+            renderer.countUpload(vertexBuffer.size() * sizeof(Vertex));
+
+            Size indexCount = 6 * (faceCount - firstFace);
+            glBindBuffer(GL_ARRAY_BUFFER, textureIndexVbo);
+            glBufferSubData(GL_ARRAY_BUFFER, 6 * firstFace * sizeof(Float32), indexCount * sizeof(Float32),
+                            &textureIndexes[6 * firstFace]);
+            renderer.countUpload(indexCount * sizeof(Float32));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
 
+    void GL4Buffer::overwrite(const FaceList &faceList, Size firstFace, Size faceCount) {
+        if (faceCount == 0) {
+            return;
+        }
+
+        updateTextureIndexes(faceList, firstFace, faceCount);
+
+        std::vector<Vertex> vertexBuffer;
+        createFaceListVertexBuffer(faceList, firstFace, faceCount, vertexBuffer);
+
+        glBindBuffer(GL_ARRAY_BUFFER, vertexVbo);
+        glBufferSubData(GL_ARRAY_BUFFER, 6 * firstFace * sizeof(Vertex), vertexBuffer.size() * sizeof(Vertex),
+                        vertexBuffer.data());
+        renderer.countUpload(vertexBuffer.size() * sizeof(Vertex));
+
+        Size indexCount = 6 * faceCount;
         glBindBuffer(GL_ARRAY_BUFFER, textureIndexVbo);
-        glBufferData(GL_ARRAY_BUFFER, textureIndexBuffer.size() * sizeof(Float32), textureIndexBuffer.data(),
-                     GL_STATIC_DRAW);
-        // glBufferSubData(GL_ARRAY_BUFFER, 0, elements * sizeof(Float32), textureIndexBuffer.data());
-        // glNamedBufferSubData(textureIndexVbo, 0, elements * sizeof(Float32), textureIndexBuffer.data()); // GL 4.5
+        glBufferSubData(GL_ARRAY_BUFFER, 6 * firstFace * sizeof(Float32), indexCount * sizeof(Float32),
+                        &textureIndexes[6 * firstFace]);
+        renderer.countUpload(indexCount * sizeof(Float32));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
-    void GL4Buffer::render(const Material &material) {
+    void GL4Buffer::render(const Material &material, Size firstFace, Size faceCount) {
+        renderer.flushBatch();
+
         glBindVertexArray(vao);
         program.bind();
 
@@ -96,15 +160,13 @@ namespace Duel6 {
                                 color.getAlpha() / 255.0f};
         program.setUniform("color", colorData);
 
-        glDrawArrays(GL_TRIANGLES, 0, elements);
+        glDrawArrays(GL_TRIANGLES, GLint(firstFace * 6), GLsizei(faceCount * 6));
     }
 
 
-    void GL4Buffer::createFaceListVertexBuffer(const FaceList &faceList, std::vector<Vertex> &vertexBuffer) {
-        const Vertex *vertex = faceList.getVertexes().data();
-        const auto &faces = faceList.getFaces();
-
-        const auto faceCount = faces.size();
+    void GL4Buffer::createFaceListVertexBuffer(const FaceList &faceList, Size firstFace, Size faceCount,
+                                               std::vector<Vertex> &vertexBuffer) {
+        const Vertex *vertex = faceList.getVertexes().data() + 4 * firstFace;
         vertexBuffer.reserve(faceCount * 6);
 
         for (Size i = 0; i < faceCount; i++, vertex += 4) {
@@ -137,4 +199,13 @@ namespace Duel6 {
             textureIndexBuffer.push_back(textureIndex);
         }
     }
+
+    void GL4Buffer::updateTextureIndexes(const FaceList &faceList, Size first, Size count) {
+        const Face *face = &faceList.getFaces()[first];
+        Float32 *textureIndex = &textureIndexes[first * 6];
+
+        for (Size i = 0; i < count; i++, face++, textureIndex += 6) {
+            std::fill(textureIndex, textureIndex + 6, Float32(face->getCurrentTexture()));
+        }
+    }
 }
\ No newline at end of file
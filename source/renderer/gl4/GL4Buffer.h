@@ -28,33 +28,45 @@
 #ifndef DUEL6_RENDERER_GL4_GL4BUFFER_H
 #define DUEL6_RENDERER_GL4_GL4BUFFER_H
 
+#include <vector>
 #include <GL/glew.h>
 #include "../RendererBuffer.h"
 #include "../../Vertex.h"
 #include "GL4Program.h"
 
 namespace Duel6 {
+    class GL4Renderer;
+
     class GL4Buffer : public RendererBuffer {
     private:
+        GL4Renderer &renderer;
         GL4Program &program;
         Uint32 vao;
         Uint32 vertexVbo;
         Uint32 textureIndexVbo;
-        Size elements;
+        Size capacity;
+        std::vector<Float32> textureIndexes;
 
     public:
-        explicit GL4Buffer(GL4Program &program, const FaceList &faceList);
+        GL4Buffer(GL4Renderer &renderer, GL4Program &program, const FaceList &faceList);
 
         ~GL4Buffer() override;
 
         void update(const FaceList &faceList) override;
 
-        void render(const Material &material) override;
+        void replace(const FaceList &faceList, Size firstFace) override;
+
+        void overwrite(const FaceList &faceList, Size firstFace, Size faceCount) override;
+
+        void render(const Material &material, Size firstFace, Size faceCount) override;
 
     private:
-        void createFaceListVertexBuffer(const FaceList &faceList, std::vector<Vertex> &vertexBuffer);
+        void createFaceListVertexBuffer(const FaceList &faceList, Size firstFace, Size faceCount,
+                                        std::vector<Vertex> &vertexBuffer);
 
         void createFaceListTextureIndexBuffer(const FaceList &faceList, std::vector<Float32> &textureIndexBuffer);
+
+        void updateTextureIndexes(const FaceList &faceList, Size first, Size count);
     };
 }
 
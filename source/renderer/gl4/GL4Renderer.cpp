@@ -87,7 +87,26 @@ namespace Duel6 {
         glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(MaterialVertex), (const GLvoid *) (6 * sizeof(Float32)));
         glEnableVertexAttribArray(3);
 
+        glGenVertexArrays(1, &batchVao);
+        glBindVertexArray(batchVao);
+
+        glGenBuffers(1, &batchVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, batchVbo);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QuadBatch::Vertex), nullptr);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(QuadBatch::Vertex), (const GLvoid *) (3 * sizeof(Float32)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(QuadBatch::Vertex), (const GLvoid *) (5 * sizeof(Float32)));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuadBatch::Vertex), (const GLvoid *) (6 * sizeof(Float32)));
+        glEnableVertexAttribArray(4);
+
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+
+        // Vertex color used by all draws that do not come from a batch
+        glVertexAttrib4f(4, 1.0f, 1.0f, 1.0f, 1.0f);
     }
 
     Renderer::Info GL4Renderer::getInfo() {
@@ -130,11 +149,15 @@ namespace Duel6 {
     }
 
     void GL4Renderer::freeTexture(Texture textureId) {
+        flushBatch();
+
         GLuint id = textureId;
         glDeleteTextures(1, &id);
     }
 
     Image GL4Renderer::makeScreenshot() {
+        flushBatch();
+
         GLint dimensions[4];
         glGetIntegerv(GL_VIEWPORT, dimensions);
 
@@ -148,22 +171,30 @@ namespace Duel6 {
     }
 
     void GL4Renderer::setViewport(Int32 x, Int32 y, Int32 width, Int32 height) {
+        flushBatch();
+
         glViewport(x, y, width, height);
     }
 
     void GL4Renderer::enableWireframe(bool enable) {
+        flushBatch();
+
         glPolygonMode(GL_FRONT_AND_BACK, enable ? GL_LINE : GL_FILL);
     }
 
     void GL4Renderer::enableDepthTest(bool enable) {
+        flushBatch();
+
         enableOption(GL_DEPTH_TEST, enable);
     }
 
     void GL4Renderer::enableDepthWrite(bool enable) {
+        flushBatch();
+
         glDepthMask(GLboolean(enable ? GL_TRUE : GL_FALSE));
     }
 
-    void GL4Renderer::setBlendFunc(BlendFunc func) {
+    void GL4Renderer::applyBlendFunc(BlendFunc func) {
         switch (func) {
             case BlendFunc::None:
                 glDisable(GL_BLEND);
@@ -180,11 +211,15 @@ namespace Duel6 {
     }
 
     void GL4Renderer::setGlobalTime(Float32 time) {
+        flushBatch();
+
         materialProgram.bind(); // Required for INTEL
         materialProgram.setUniform("globalTime", time);
     }
 
     void GL4Renderer::clearBuffers() {
+        flushBatch();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
@@ -204,6 +239,8 @@ namespace Duel6 {
     }
 
     void GL4Renderer::point(const Vector &position, Float32 size, const Color &color) {
+        flushBatch();
+
         glBindVertexArray(colorVao);
         colorProgram.bind();
 
@@ -220,6 +257,8 @@ namespace Duel6 {
     }
 
     void GL4Renderer::line(const Vector &from, const Vector &to, Float32 width, const Color &color) {
+        flushBatch();
+
         glBindVertexArray(colorVao);
         colorProgram.bind();
 
@@ -237,6 +276,8 @@ namespace Duel6 {
     }
 
     void GL4Renderer::triangle(const Vector &p1, const Vector &p2, const Vector &p3, const Color &color) {
+        flushBatch();
+
         glBindVertexArray(colorVao);
         colorProgram.bind();
 
@@ -256,6 +297,8 @@ namespace Duel6 {
                                const Vector &p2, const Vector &t2,
                                const Vector &p3, const Vector &t3,
                                const Material &material) {
+        flushBatch();
+
         glBindVertexArray(materialVao);
         materialProgram.bind();
 
@@ -280,6 +323,8 @@ namespace Duel6 {
     }
 
     void GL4Renderer::quad(const Vector &p1, const Vector &p2, const Vector &p3, const Vector &p4, const Color &color) {
+        flushBatch();
+
         glBindVertexArray(colorVao);
         colorProgram.bind();
 
@@ -301,6 +346,10 @@ namespace Duel6 {
                            const Vector &p3, const Vector &t3,
                            const Vector &p4, const Vector &t4,
                            const Material &material) {
+        if (submitQuad(p1, t1, p2, t2, p3, t3, p4, t4, material)) {
+            return;
+        }
+
         glBindVertexArray(materialVao);
         materialProgram.bind();
 
@@ -326,8 +375,38 @@ namespace Duel6 {
         glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
     }
 
+    void GL4Renderer::drawBatch(const QuadBatch &batch) {
+        const std::vector<QuadBatch::Vertex> &vertices = batch.getVertices();
+
+        glBindVertexArray(batchVao);
+        materialProgram.bind();
+
+        glBindBuffer(GL_ARRAY_BUFFER, batchVbo);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(QuadBatch::Vertex), vertices.data(), GL_STREAM_DRAW);
+
+        // Colors come with the vertices
+        Float32 colorData[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        materialProgram.setUniform("modulateColor", colorData);
+
+        const QuadBatch::Command *previous = nullptr;
+        for (const QuadBatch::Command &command : batch.getCommands()) {
+            useBlendFunc(command.key.blendFunc);
+            if (previous == nullptr || previous->key.texture != command.key.texture) {
+                glBindTexture(GL_TEXTURE_2D_ARRAY, command.key.texture);
+            }
+            if (previous == nullptr || previous->key.masked != command.key.masked) {
+                materialProgram.setUniform("alphaTest", command.key.masked ? 1 : 0);
+            }
+
+            glDrawArrays(GL_TRIANGLES, GLint(command.first), GLsizei(command.count));
+            previous = &command;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
     std::unique_ptr<RendererBuffer> GL4Renderer::makeBuffer(const FaceList &faceList) {
-        return std::make_unique<GL4Buffer>(materialProgram, faceList);
+        return std::make_unique<GL4Buffer>(*this, materialProgram, faceList);
     }
 
     void GL4Renderer::enableOption(GLenum option, bool enable) {
@@ -42,6 +42,8 @@ namespace Duel6 {
         GLuint colorVbo;
         GLuint materialVbo;
         GLuint materialVao;
+        GLuint batchVbo;
+        GLuint batchVao;
 
         GL4Shader colorVertexShader;
         GL4Shader colorFragmentShader;
@@ -72,8 +74,6 @@ namespace Duel6 {
 
         void enableDepthWrite(bool enable) override;
 
-        void setBlendFunc(BlendFunc func) override;
-
         void setGlobalTime(Float32 time) override;
 
         void clearBuffers() override;
@@ -105,6 +105,11 @@ namespace Duel6 {
 
         std::unique_ptr<RendererBuffer> makeBuffer(const FaceList &faceList) override;
 
+    protected:
+        void applyBlendFunc(BlendFunc func) override;
+
+        void drawBatch(const QuadBatch &batch) override;
+
     private:
         void enableOption(GLenum option, bool enable);
 
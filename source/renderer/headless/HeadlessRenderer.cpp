@@ -0,0 +1,204 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HeadlessRenderer.h"
+#include "../../FaceList.h"
+
+namespace Duel6 {
+    namespace {
+        class HeadlessBuffer : public RendererBuffer {
+        private:
+            HeadlessRenderer &renderer;
+
+        public:
+            HeadlessBuffer(HeadlessRenderer &renderer, const FaceList &faceList)
+                    : renderer(renderer) {
+                Size faces = faceList.getFaces().size();
+                renderer.countUpload(faces * 6 * (sizeof(Vertex) + sizeof(Float32)));
+            }
+
+            void update(const FaceList &faceList) override {
+                // Count what a buffer backed by graphics memory would have to upload
+                for (const FaceList::Range &range : faceList.getAnimatedRanges()) {
+                    renderer.countUpload(range.count * 6 * sizeof(Float32));
+                }
+            }
+
+            void replace(const FaceList &faceList, Size firstFace) override {
+                Size faces = faceList.getFaces().size() - firstFace;
+                renderer.countUpload(faces * 6 * (sizeof(Vertex) + sizeof(Float32)));
+            }
+
+            void overwrite(const FaceList &faceList, Size firstFace, Size faceCount) override {
+                renderer.countUpload(faceCount * 6 * (sizeof(Vertex) + sizeof(Float32)));
+            }
+
+            void render(const Material &material, Size firstFace, Size faceCount) override {
+                renderer.flushBatch();
+                renderer.countDrawCall(material.getTexture());
+            }
+        };
+    }
+
+    HeadlessRenderer::HeadlessRenderer()
+            : RendererBase(), nextTexture(1), boundTexture(0) {}
+
+    Renderer::Info HeadlessRenderer::getInfo() {
+        Info info;
+        info.vendor = "Duel 6 Reloaded";
+        info.renderer = "Headless";
+        info.version = "1.0";
+        return info;
+    }
+
+    Renderer::Extensions HeadlessRenderer::getExtensions() {
+        return Extensions();
+    }
+
+    Texture HeadlessRenderer::createTexture(const Image &image, TextureFilter filtering, bool clamp) {
+        Texture texture = nextTexture;
+        nextTexture += Texture(image.getDepth());
+        counters.createdTextures++;
+        return texture;
+    }
+
+    void HeadlessRenderer::freeTexture(Texture textureId) {
+        flushBatch();
+    }
+
+    Image HeadlessRenderer::makeScreenshot() {
+        flushBatch();
+        return Image();
+    }
+
+    void HeadlessRenderer::setViewport(Int32 x, Int32 y, Int32 width, Int32 height) {
+        flushBatch();
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::enableWireframe(bool enable) {
+        flushBatch();
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::enableDepthTest(bool enable) {
+        flushBatch();
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::enableDepthWrite(bool enable) {
+        flushBatch();
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::setGlobalTime(Float32 time) {}
+
+    void HeadlessRenderer::clearBuffers() {
+        flushBatch();
+    }
+
+    void HeadlessRenderer::setProjectionMatrix(const Matrix &m) {
+        RendererBase::setProjectionMatrix(m);
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::setViewMatrix(const Matrix &m) {
+        RendererBase::setViewMatrix(m);
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::setModelMatrix(const Matrix &m) {
+        RendererBase::setModelMatrix(m);
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::point(const Vector &position, Float32 size, const Color &color) {
+        flushBatch();
+        countDrawCall(0);
+    }
+
+    void HeadlessRenderer::line(const Vector &from, const Vector &to, Float32 width, const Color &color) {
+        flushBatch();
+        countDrawCall(0);
+    }
+
+    void HeadlessRenderer::triangle(const Vector &p1, const Vector &p2, const Vector &p3, const Color &color) {
+        flushBatch();
+        countDrawCall(0);
+    }
+
+    void HeadlessRenderer::triangle(const Vector &p1, const Vector &t1,
+                                    const Vector &p2, const Vector &t2,
+                                    const Vector &p3, const Vector &t3,
+                                    const Material &material) {
+        flushBatch();
+        countDrawCall(material.getTexture());
+    }
+
+    void HeadlessRenderer::quad(const Vector &p1, const Vector &p2, const Vector &p3, const Vector &p4,
+                                const Color &color) {
+        flushBatch();
+        countDrawCall(0);
+        counters.quads++;
+    }
+
+    void HeadlessRenderer::quad(const Vector &p1, const Vector &t1,
+                                const Vector &p2, const Vector &t2,
+                                const Vector &p3, const Vector &t3,
+                                const Vector &p4, const Vector &t4,
+                                const Material &material) {
+        counters.quads++;
+        if (submitQuad(p1, t1, p2, t2, p3, t3, p4, t4, material)) {
+            counters.batchedQuads++;
+            return;
+        }
+        countDrawCall(material.getTexture());
+    }
+
+    std::unique_ptr<RendererBuffer> HeadlessRenderer::makeBuffer(const FaceList &faceList) {
+        return std::make_unique<HeadlessBuffer>(*this, faceList);
+    }
+
+    void HeadlessRenderer::countDrawCall(Texture texture) {
+        if (texture != boundTexture) {
+            boundTexture = texture;
+            counters.stateChanges++;
+        }
+        counters.drawCalls++;
+    }
+
+    void HeadlessRenderer::applyBlendFunc(BlendFunc func) {
+        counters.stateChanges++;
+    }
+
+    void HeadlessRenderer::drawBatch(const QuadBatch &batch) {
+        for (const QuadBatch::Command &command : batch.getCommands()) {
+            useBlendFunc(command.key.blendFunc);
+            countDrawCall(command.key.texture);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ScriptedInput.h"
+
+namespace Duel6 {
+    ScriptedInput::ScriptedInput(Uint32 seed) {
+        reset(seed);
+    }
+
+    void ScriptedInput::reset(Uint32 seed) {
+        engine.seed(seed);
+        state = 0;
+        heldButtons = 0;
+        holdTicks = 0;
+    }
+
+    void ScriptedInput::tick() {
+        if (--holdTicks > 0) {
+            return;
+        }
+
+        state = 0;
+        Int32 move = std::uniform_int_distribution<Int32>(0, 4)(engine);
+        if (move == 1 || move == 2) {
+            state |= Left;
+        } else if (move == 3 || move == 4) {
+            state |= Right;
+        }
+
+        if (chance(25)) {
+            state |= Up;
+        }
+        if (chance(10)) {
+            state |= Down;
+        }
+        if (chance(50)) {
+            state |= Shoot;
+        }
+        if (chance(5)) {
+            state |= Pick;
+        }
+
+        holdTicks = std::uniform_int_distribution<Int32>(5, 45)(engine);
+    }
+
+    std::unique_ptr<PlayerControls> ScriptedInput::makeControls(const std::string &description) const {
+        return std::make_unique<PlayerControls>(description,
+                                                new ScriptedControl(*this, Left),
+                                                new ScriptedControl(*this, Right),
+                                                new ScriptedControl(*this, Up),
+                                                new ScriptedControl(*this, Down),
+                                                new ScriptedControl(*this, Shoot),
+                                                new ScriptedControl(*this, Pick),
+                                                new ScriptedControl(*this, Status));
+    }
+
+    bool ScriptedInput::chance(Int32 percent) {
+        return std::uniform_int_distribution<Int32>(0, 99)(engine) < percent;
+    }
+}
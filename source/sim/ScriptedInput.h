@@ -0,0 +1,98 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_SIM_SCRIPTEDINPUT_H
+#define DUEL6_SIM_SCRIPTEDINPUT_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include "../Type.h"
+#include "../input/PlayerControls.h"
+
+namespace Duel6 {
+    /**
+     * Deterministic pseudo-random button presses for a single simulated player.
+     * The pressed state changes only when tick() or hold() is called.
+     */
+    class ScriptedInput {
+    public:
+        enum Button : Uint32 {
+            Left = 0x01,
+            Right = 0x02,
+            Up = 0x04,
+            Down = 0x08,
+            Shoot = 0x10,
+            Pick = 0x20,
+            Status = 0x40
+        };
+
+    private:
+        std::minstd_rand engine;
+        Uint32 state;
+        Uint32 heldButtons;
+        Int32 holdTicks;
+
+    public:
+        explicit ScriptedInput(Uint32 seed);
+
+        void reset(Uint32 seed);
+
+        void tick();
+
+        /** Keeps the buttons pressed on top of the scripted ones until the next reset. */
+        void hold(Uint32 buttons) {
+            heldButtons = buttons;
+        }
+
+        bool isPressed(Button button) const {
+            return ((state | heldButtons) & button) != 0;
+        }
+
+        std::unique_ptr<PlayerControls> makeControls(const std::string &description) const;
+
+    private:
+        bool chance(Int32 percent);
+    };
+
+    class ScriptedControl
+            : public Control {
+    private:
+        const ScriptedInput &input;
+        ScriptedInput::Button button;
+
+    public:
+        ScriptedControl(const ScriptedInput &input, ScriptedInput::Button button)
+                : input(input), button(button) {}
+
+        bool isPressed() const override {
+            return input.isPressed(button);
+        }
+    };
+}
+
+#endif
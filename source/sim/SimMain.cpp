@@ -0,0 +1,348 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../Exception.h"
+#include "Simulator.h"
+
+static void printUsage() {
+    printf("Usage: duel6r-sim [-p players] [-r rounds] [-s seed] [-l level.json] [-w record] [-R replay]"
+           " [-g] [-c] [-m] [-n] [-k] [-S] [-F] [-M] [-D] [-T] [-P]\n");
+    printf("  -w  record each match to a file, suffixed with the level index when playing more levels\n");
+    printf("  -R  play a recorded match again and check that it ends the same way instead of playing\n");
+    printf("  -g  render every tick with the counting headless renderer and HUD texts on, report draw calls"
+           " and textures created during the match, fail when any texture is created after the game started\n");
+    printf("  -c  compare level load times from JSON and from the level cache instead of playing\n");
+    printf("  -m  compare wall face counts with and without wall merging instead of playing\n");
+    printf("  -n  check that level chunks and monolithic level meshes have the same faces, also as water rises"
+           " and with merged walls\n");
+    printf("  -k  benchmark player skin compositing kernels over man.ase instead of playing\n");
+    printf("  -F  benchmark formatting of per-frame HUD texts with Format and with pre-parsed patterns\n");
+    printf("  -M  stress shots with every player firing a machine gun all the time instead of playing\n");
+    printf("  -D  play each level with shots updated one by one and in batches and check that it plays the same\n");
+    printf("  -T  measure game update time per second of game time at tick rates from 30 to 120 Hz\n");
+    printf("  -P  update each level on the simulation thread while drawing slow frames and check that no update"
+           " is lost\n");
+    printf("  -S  measure size and save/restore time of round snapshots and check replays from them\n");
+}
+
+int main(int argc, char **argv) {
+    Duel6::Simulator::Options options;
+    std::vector<std::string> levels;
+    bool compareLoading = false;
+    bool compareMerging = false;
+    bool compareChunks = false;
+    bool benchmarkKernels = false;
+    bool benchmarkSnapshots = false;
+    bool benchmarkFormatting = false;
+    bool benchmarkShots = false;
+    bool compareShotUpdates = false;
+    bool benchmarkTickRates = false;
+    bool checkThreadedTicks = false;
+    std::string recordPath;
+    std::string replayPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-g") {
+            options.render = true;
+            continue;
+        }
+        if (arg == "-c") {
+            compareLoading = true;
+            continue;
+        }
+        if (arg == "-m") {
+            compareMerging = true;
+            continue;
+        }
+        if (arg == "-n") {
+            compareChunks = true;
+            continue;
+        }
+        if (arg == "-k") {
+            benchmarkKernels = true;
+            continue;
+        }
+        if (arg == "-S") {
+            benchmarkSnapshots = true;
+            continue;
+        }
+        if (arg == "-F") {
+            benchmarkFormatting = true;
+            continue;
+        }
+        if (arg == "-M") {
+            benchmarkShots = true;
+            continue;
+        }
+        if (arg == "-D") {
+            compareShotUpdates = true;
+            continue;
+        }
+        if (arg == "-T") {
+            benchmarkTickRates = true;
+            continue;
+        }
+        if (arg == "-P") {
+            checkThreadedTicks = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "-p") {
+            options.players = std::stoul(value);
+        } else if (arg == "-r") {
+            options.roundsPerLevel = std::stoi(value);
+        } else if (arg == "-s") {
+            options.seed = std::stoul(value);
+        } else if (arg == "-l") {
+            levels.push_back(value);
+        } else if (arg == "-w") {
+            recordPath = value;
+        } else if (arg == "-R") {
+            replayPath = value;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    try {
+        Duel6::Simulator simulator(options);
+        if (!replayPath.empty()) {
+            Duel6::InputLog log = Duel6::InputLog::load(replayPath);
+            Duel6::Simulator::Result result = simulator.replay(log);
+            printf("%-32s rounds: %3d  ticks: %8llu  ticks/s: %10.1f  seed: %u  %s\n", replayPath.c_str(),
+                   Duel6::Int32(log.getRounds().size()), (unsigned long long) result.ticks,
+                   result.getTicksPerSecond(), log.getSeed(), result.diverged ? "DIVERGED" : "identical");
+            return result.diverged ? 1 : 0;
+        }
+
+        if (levels.empty()) {
+            levels = simulator.listLevels();
+        }
+
+        if (benchmarkKernels) {
+            const Duel6::Size repeats = 64;
+            std::vector<Duel6::Simulator::CompositionTimes> results = simulator.measureSkinComposition(repeats);
+            Duel6::Float64 scalarSeconds = results.front().seconds;
+            bool identical = true;
+            for (const Duel6::Simulator::CompositionTimes &times : results) {
+                printf("%-8s skin: %8.3f ms  speedup: %5.2fx  %s\n",
+                       Duel6::SpriteBlender::getName(times.instructionSet), times.seconds * 1000,
+                       times.seconds > 0 ? scalarSeconds / times.seconds : 0,
+                       times.matchesScalar ? "identical" : "MISMATCH");
+                identical = identical && times.matchesScalar;
+            }
+            return identical ? 0 : 1;
+        }
+
+        if (benchmarkFormatting) {
+            const Duel6::Size frames = 100000;
+            Duel6::Simulator::FormattingTimes times = simulator.measureHudFormatting(frames);
+            printf("HUD of %u players per frame  Format: %8.3f us  pattern: %8.3f us  speedup: %5.2fx  %s\n",
+                   Duel6::Uint32(options.players), times.formatSeconds * 1000000, times.patternSeconds * 1000000,
+                   times.patternSeconds > 0 ? times.formatSeconds / times.patternSeconds : 0,
+                   times.identical ? "identical" : "MISMATCH");
+            return times.identical ? 0 : 1;
+        }
+
+        if (benchmarkShots) {
+            const Duel6::Uint64 ticks = 60 * D6_UPDATE_FREQUENCY;
+            for (const std::string &level : levels) {
+                Duel6::Simulator::ShotStress stress = simulator.measureShotStress(level, ticks);
+                printf("%-32s ticks: %8llu  ticks/s: %10.1f  shots fired: %6d  live avg: %7.1f  peak: %5llu"
+                       "  arena slots: %5llu\n", stress.level.c_str(), (unsigned long long) stress.ticks,
+                       stress.getTicksPerSecond(), stress.shotsFired, stress.averageShots,
+                       (unsigned long long) stress.peakShots, (unsigned long long) stress.arenaSlots);
+            }
+            return 0;
+        }
+
+        if (compareShotUpdates) {
+            const Duel6::Uint64 ticks = 60 * D6_UPDATE_FREQUENCY;
+            bool identical = true;
+            for (const std::string &level : levels) {
+                Duel6::Simulator::ShotUpdateCheck check = simulator.compareShotUpdates(level, ticks);
+                printf("%-32s ticks: %6llu  one by one: %8.3f ms  batched: %8.3f ms  %s",
+                       check.level.c_str(), (unsigned long long) check.ticks, check.referenceSeconds * 1000,
+                       check.batchedSeconds * 1000, check.firstMismatch == 0 ? "identical\n" : "DIVERGED");
+                if (check.firstMismatch != 0) {
+                    printf(" at tick %llu\n", (unsigned long long) check.firstMismatch);
+                }
+                identical = identical && check.firstMismatch == 0;
+            }
+            return identical ? 0 : 1;
+        }
+
+        if (benchmarkTickRates) {
+            const std::vector<Duel6::Int32> tickRates = {30, 45, 60, 90, 120};
+            const Duel6::Float64 gameSeconds = 60;
+            for (const std::string &level : levels) {
+                for (const Duel6::Simulator::TickRateCost &cost : simulator.measureTickRates(level, tickRates,
+                                                                                             gameSeconds)) {
+                    printf("%-32s %4d Hz  ticks: %6llu  updates: %8.3f ms  per tick: %7.1f us  load: %6.3f %%\n",
+                           cost.level.c_str(), cost.tickRate, (unsigned long long) cost.ticks, cost.seconds * 1000,
+                           cost.ticks > 0 ? cost.seconds * 1000000 / cost.ticks : 0, cost.getLoad() * 100);
+                }
+            }
+            return 0;
+        }
+
+        if (checkThreadedTicks) {
+            const Duel6::Float64 seconds = 3;
+            bool complete = true;
+            for (const std::string &level : levels) {
+                for (Duel6::Float64 frameSeconds : {0.005, 0.05, 0.2}) {
+                    Duel6::Simulator::ThreadedTicks ticks = simulator.measureThreadedTicks(level, frameSeconds,
+                                                                                           seconds);
+                    printf("%-32s frame: %5.0f ms  frames: %4llu  ticks: %5llu  due: %5llu  %s\n",
+                           ticks.level.c_str(), frameSeconds * 1000, (unsigned long long) ticks.frames,
+                           (unsigned long long) ticks.ticks, (unsigned long long) ticks.dueTicks,
+                           ticks.isComplete() ? "complete" : "TICKS LOST");
+                    complete = complete && ticks.isComplete();
+                }
+            }
+            return complete ? 0 : 1;
+        }
+
+        if (benchmarkSnapshots) {
+            bool matches = true;
+            for (const std::string &level : levels) {
+                Duel6::Simulator::SnapshotStats stats = simulator.measureSnapshots(level);
+                printf("%-32s snapshots: %4llu  avg: %7llu B  max: %7llu B  save: %7.3f ms  restore: %7.3f ms  %s\n",
+                       stats.level.c_str(), (unsigned long long) stats.snapshots,
+                       (unsigned long long) stats.averageBytes, (unsigned long long) stats.maxBytes,
+                       stats.saveSeconds * 1000, stats.restoreSeconds * 1000,
+                       stats.matches ? "identical" : "DIVERGED");
+                matches = matches && stats.matches;
+            }
+            return matches ? 0 : 1;
+        }
+
+        if (compareMerging) {
+            bool sameArea = true;
+            for (const std::string &level : levels) {
+                for (const Duel6::Simulator::WallFaceCounts &counts : simulator.countWallFaces(level)) {
+                    printf("%-32s %-6s %-6s faces: %6llu  merged: %6llu  ratio: %5.2fx  %s\n", counts.level.c_str(),
+                           counts.mirror ? "mirror" : "",
+                           counts.screenMode == Duel6::ScreenMode::SplitScreen ? "split" : "full",
+                           (unsigned long long) counts.faces, (unsigned long long) counts.mergedFaces,
+                           counts.mergedFaces > 0 ? Duel6::Float64(counts.faces) / counts.mergedFaces : 0,
+                           counts.sameArea ? "same area" : "AREA MISMATCH");
+                    sameArea = sameArea && counts.sameArea;
+                }
+            }
+            return sameArea ? 0 : 1;
+        }
+
+        if (compareChunks) {
+            bool same = true;
+            for (const std::string &level : levels) {
+                for (const Duel6::Simulator::ChunkedMeshCheck &check : simulator.compareChunkedMeshes(level)) {
+                    printf("%-32s %-6s %-6s %-6s chunks: %3llu  faces: %6llu  water rises: %3llu  %s\n",
+                           check.level.c_str(), check.mergeWalls ? "merged" : "",
+                           check.mirror ? "mirror" : "",
+                           check.screenMode == Duel6::ScreenMode::SplitScreen ? "split" : "full",
+                           (unsigned long long) check.chunks, (unsigned long long) check.faces,
+                           (unsigned long long) check.waterRises,
+                           !check.sameFaces ? "FACES DIFFER" : !check.sameWaterRises ? "WATER DIFFERS" : "identical");
+                    same = same && check.sameFaces && check.sameWaterRises;
+                }
+            }
+            return same ? 0 : 1;
+        }
+
+        if (compareLoading) {
+            const Duel6::Size repeats = 50;
+            for (const std::string &level : levels) {
+                Duel6::Simulator::LoadTimes times = simulator.measureLevelLoading(level, repeats);
+                printf("%-32s json: %8.3f ms  cache: %8.3f ms  speedup: %6.1fx\n", times.level.c_str(),
+                       times.sourceSeconds * 1000, times.cachedSeconds * 1000,
+                       times.cachedSeconds > 0 ? times.sourceSeconds / times.cachedSeconds : 0);
+            }
+            return 0;
+        }
+
+        printf("Players: %u, rounds per level: %d, seed: %u\n", Duel6::Uint32(options.players),
+               options.roundsPerLevel, options.seed);
+
+        Duel6::Uint64 totalTicks = 0;
+        Duel6::Int32 totalRounds = 0;
+        Duel6::Float64 totalSeconds = 0;
+        bool steadyTextures = true;
+        for (Duel6::Size i = 0; i < levels.size(); i++) {
+            std::string record = recordPath;
+            if (!record.empty() && levels.size() > 1) {
+                record += "." + std::to_string(i);
+            }
+            Duel6::Simulator::Result result = simulator.run(levels[i], record);
+            printf("%-32s rounds: %3d  ticks: %8llu  ticks/s: %10.1f  rounds/s: %8.2f  kills: %4d  deaths: %4d%s\n",
+                   result.level.c_str(), result.rounds, (unsigned long long) result.ticks,
+                   result.getTicksPerSecond(), result.getRoundsPerSecond(), result.kills, result.deaths,
+                   result.timedOut ? "  (timed out)" : "");
+            if (options.render) {
+                printf("%-32s frames: %8llu  draw calls/frame: %8.1f  state changes/frame: %8.1f  quads batched: %llu/%llu"
+                       "  uploaded B/s: %.0f  textures created: %llu\n",
+                       "", (unsigned long long) result.frames, result.getDrawCallsPerFrame(),
+                       result.getStateChangesPerFrame(), (unsigned long long) result.batchedQuads,
+                       (unsigned long long) result.quads, result.getUploadedBytesPerSecond(),
+                       (unsigned long long) result.createdTextures);
+                steadyTextures = steadyTextures && result.createdTextures == 0;
+            }
+            totalTicks += result.ticks;
+            totalRounds += result.rounds;
+            totalSeconds += result.seconds;
+        }
+
+        if (totalSeconds > 0) {
+            printf("Total: %d rounds, %llu ticks in %.3f s (%.1f ticks/s, %.2f rounds/s)\n", totalRounds,
+                   (unsigned long long) totalTicks, totalSeconds, totalTicks / totalSeconds,
+                   totalRounds / totalSeconds);
+        }
+        if (!steadyTextures) {
+            printf("Textures were created while the game was running\n");
+            return 1;
+        }
+        return 0;
+    }
+    catch (const Duel6::Exception &e) {
+        fprintf(stderr, "Error occured: %s\nAt: %s: %d\n", e.getMessage().c_str(), e.getFile().c_str(), e.getLine());
+    }
+    catch (const std::exception &e) {
+        fprintf(stderr, "Error occured: %s\n", e.what());
+    }
+
+    return 1;
+}
@@ -0,0 +1,742 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include "../Fire.h"
+#include "../LevelList.h"
+#include "../LevelCache.h"
+#include "../File.h"
+#include "../FontException.h"
+#include "../Weapon.h"
+#include "../PlayerAnimations.h"
+#include "../BinaryStream.h"
+#include "../SimulationThread.h"
+#include "../TimeHistogram.h"
+#include "../renderer/headless/HeadlessRenderer.h"
+#include "Simulator.h"
+
+namespace Duel6 {
+    namespace {
+        const Float32 updateTime = 1.0f / D6_UPDATE_FREQUENCY;
+
+        bool isSameImage(const Image &first, const Image &second) {
+            if (first.getWidth() != second.getWidth() || first.getHeight() != second.getHeight() ||
+                first.getDepth() != second.getDepth()) {
+                return false;
+            }
+            Size pixels = first.getWidth() * first.getHeight() * first.getDepth();
+            for (Size i = 0; i < pixels; i++) {
+                if (first.at(i) != second.at(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        Float32 getTotalArea(const FaceList &faceList) {
+            const std::vector<Vertex> &vertexes = faceList.getVertexes();
+            Float32 area = 0;
+            for (Size i = 0; i < vertexes.size(); i += 4) {
+                Vector origin(vertexes[i].x, vertexes[i].y, vertexes[i].z);
+                Vector right(vertexes[i + 1].x, vertexes[i + 1].y, vertexes[i + 1].z);
+                Vector down(vertexes[i + 3].x, vertexes[i + 3].y, vertexes[i + 3].z);
+                area += (right - origin).length() * (down - origin).length();
+            }
+            return area;
+        }
+
+        typedef std::vector<Float64> FaceKey;
+
+        void collectFaces(const FaceList &faceList, const std::vector<LevelRenderData::Chunk> &chunks,
+                          FaceList::Range LevelRenderData::Chunk::*range, std::vector<FaceKey> &faces) {
+            for (const LevelRenderData::Chunk &chunk : chunks) {
+                const FaceList::Range &faceRange = chunk.*range;
+                for (Size i = faceRange.first; i < faceRange.first + faceRange.count; i++) {
+                    const Face &face = faceList.getFaces()[i];
+                    FaceKey key = {Float64(face.getBlock().getIndex()), Float64(face.getCurrentTexture())};
+                    for (Size j = 4 * i; j < 4 * i + 4; j++) {
+                        const Vertex &vertex = faceList.getVertexes()[j];
+                        key.insert(key.end(), {vertex.x, vertex.y, vertex.z, vertex.u, vertex.v,
+                                               Float64(vertex.getFlag())});
+                    }
+                    faces.push_back(key);
+                }
+            }
+        }
+
+        /** Drawn faces in a canonical order, independent of how they are grouped to chunks. */
+        std::vector<FaceKey> collectFaces(const LevelRenderData &renderData, bool waterOnly) {
+            std::vector<FaceKey> faces;
+            if (!waterOnly) {
+                collectFaces(renderData.getWalls(), renderData.getChunks(), &LevelRenderData::Chunk::walls, faces);
+                collectFaces(renderData.getSprites(), renderData.getChunks(), &LevelRenderData::Chunk::sprites, faces);
+            }
+            collectFaces(renderData.getWater(), renderData.getChunks(), &LevelRenderData::Chunk::water, faces);
+            std::sort(faces.begin(), faces.end());
+            return faces;
+        }
+    }
+
+    Simulator::Simulator(const Options &options)
+            : options(options), console(Console::ExpandFlag), input(console), controlsManager(input),
+              sound(console), scriptContext(console, sound, gameSettings), scriptManager(scriptContext) {
+        console.printLine("\n===Headless simulator===");
+        auto headlessRenderer = std::make_unique<HeadlessRenderer>();
+        renderer = headlessRenderer.get();
+        video = std::make_unique<Video>(ScreenParameters(1280, 900, 32, 0, false), std::move(headlessRenderer));
+        textureManager = std::make_unique<TextureManager>(video->getRenderer());
+        font = std::make_unique<Font>(video->getRenderer());
+        if (options.render) {
+            if (TTF_Init() != 0) {
+                D6_THROW(FontException, Format("Unable to initialize font subsystem: {0}") << TTF_GetError());
+            }
+            font->load(D6_FILE_TTF_FONT, console);
+        }
+
+        service = std::make_unique<AppService>(*font, console, *textureManager, *video, input, controlsManager, sound,
+                                               scriptManager, profiler);
+        gameResources.load(console, sound, *textureManager);
+        game = std::make_unique<Game>(*service, gameResources, gameSettings);
+
+        FireList::initialize();
+        for (Weapon weapon : Weapon::values()) {
+            gameSettings.enableWeapon(weapon, true);
+        }
+        gameSettings.setQuickLiquid(true);
+        if (options.render) {
+            // Every frame then prints the changing HUD texts
+            gameSettings.setShowFps(true);
+            gameSettings.setShowRanking(true);
+            gameSettings.setShowProfiler(true);
+        }
+
+        playerSounds = PlayerSounds::makeDefault(sound);
+        for (Size i = 0; i < File::countFiles(D6_TEXTURE_BCG_PATH); i++) {
+            backgrounds.push_back(i);
+        }
+
+        for (Size i = 0; i < options.players; i++) {
+            inputs.push_back(ScriptedInput(options.seed + Uint32(i)));
+        }
+        for (Size i = 0; i < options.players; i++) {
+            controls.push_back(inputs[i].makeControls(Format("Scripted {0}") << i));
+        }
+    }
+
+    std::vector<std::string> Simulator::listLevels() const {
+        LevelList levelList;
+        levelList.initialize(D6_FILE_LEVEL, D6_LEVEL_EXTENSION);
+
+        std::vector<std::string> levels;
+        for (Size i = 0; i < levelList.getLength(); ++i) {
+            levels.push_back(levelList.getPath(i));
+        }
+        return levels;
+    }
+
+    void Simulator::startGame(const std::vector<std::string> &levels, Int32 rounds) {
+        Math::randomEngine.seed(options.seed);
+        for (Size i = 0; i < inputs.size(); i++) {
+            inputs[i].reset(options.seed + Uint32(i));
+        }
+
+        persons.clear();
+        for (Size i = 0; i < options.players; i++) {
+            persons.push_back(Person(Format("Bot {0}") << i, nullptr));
+        }
+
+        std::vector<Game::PlayerDefinition> playerDefinitions;
+        for (Size i = 0; i < options.players; i++) {
+            playerDefinitions.push_back(Game::PlayerDefinition(persons[i], PlayerSkinColors::makeRandom(),
+                                                               playerSounds, *controls[i]));
+        }
+        gameMode.initializePlayers(playerDefinitions);
+
+        gameSettings.setMaxRounds(rounds);
+        gameSettings.setSeed(options.seed);
+        game->setPlayedRounds(0);
+
+        renderer->resetCounters();
+        game->start(playerDefinitions, levels, backgrounds, ScreenMode::FullScreen, 13, gameMode);
+    }
+
+    void Simulator::collectResult(Result &result, Uint64 startCounter, Uint64 startUploadedBytes,
+                                  Uint64 startTextures) {
+        result.seconds = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+        result.rounds = game->getPlayedRounds();
+        const HeadlessRenderer::Counters &counters = renderer->getCounters();
+        result.drawCalls = counters.drawCalls;
+        result.stateChanges = counters.stateChanges;
+        result.quads = counters.quads;
+        result.batchedQuads = counters.batchedQuads;
+        result.uploadedBytes = renderer->getUploadedBytes() - startUploadedBytes;
+        result.createdTextures = counters.createdTextures - startTextures;
+        for (const Person &person : persons) {
+            result.kills += person.getKills();
+            result.deaths += person.getDeaths();
+        }
+    }
+
+    Simulator::Result Simulator::run(const std::string &levelPath, const std::string &recordPath) {
+        Result result;
+        result.level = levelPath;
+
+        gameSettings.setRecordPath(recordPath);
+        game->setReplay(nullptr);
+        Uint64 startUploadedBytes = renderer->getUploadedBytes();
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        startGame({levelPath}, options.roundsPerLevel);
+        Uint64 startTextures = renderer->getCounters().createdTextures;
+
+        Int32 currentRound = game->getCurrentRound();
+        Uint32 roundTicks = 0;
+        while (!game->isOver()) {
+            if (game->getCurrentRound() != currentRound) {
+                currentRound = game->getCurrentRound();
+                roundTicks = 0;
+            }
+            if (roundTicks >= options.maxTicksPerRound) {
+                result.timedOut = true;
+                break;
+            }
+
+            for (ScriptedInput &scriptedInput : inputs) {
+                scriptedInput.tick();
+            }
+            game->update(updateTime);
+            result.ticks++;
+            roundTicks++;
+
+            if (options.render) {
+                game->beforeRender();
+                game->render();
+                result.frames++;
+            }
+        }
+
+        // Closes the last round so that it gets into the recording
+        game->endRound();
+        collectResult(result, startCounter, startUploadedBytes, startTextures);
+        return result;
+    }
+
+    Simulator::Result Simulator::replay(const InputLog &log) {
+        if (log.getPlayers() != options.players) {
+            D6_THROW(Exception, Format("Replay needs {0} players, simulator has {1}") << log.getPlayers()
+                                                                                       << options.players);
+        }
+        if (log.getRounds().empty()) {
+            D6_THROW(Exception, "Replay has no rounds");
+        }
+
+        Result result;
+        result.level = log.getRounds().front().level;
+
+        Uint64 maxTicks = 0;
+        for (const InputLog::Round &round : log.getRounds()) {
+            maxTicks += round.ticks + 1;
+        }
+
+        // The game takes the seed and levels from the log
+        gameSettings.setRecordPath("");
+        game->setReplay(&log);
+        Uint64 startUploadedBytes = renderer->getUploadedBytes();
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        startGame({result.level}, Int32(log.getRounds().size()));
+        Uint64 startTextures = renderer->getCounters().createdTextures;
+
+        // A diverged round may end on its own before the recorded tick count and freeze the last one
+        while (!game->isReplayFinished() && !game->isOver()) {
+            if (result.ticks >= maxTicks) {
+                result.timedOut = true;
+                break;
+            }
+            game->update(updateTime);
+            result.ticks++;
+
+            if (options.render) {
+                game->beforeRender();
+                game->render();
+                result.frames++;
+            }
+        }
+
+        game->endRound();
+        result.diverged = game->isReplayDiverged() || result.timedOut;
+        game->setReplay(nullptr);
+        collectResult(result, startCounter, startUploadedBytes, startTextures);
+        return result;
+    }
+
+    Simulator::SnapshotStats Simulator::measureSnapshots(const std::string &levelPath) {
+        SnapshotStats stats;
+        stats.level = levelPath;
+
+        gameSettings.setRecordPath("");
+        game->setReplay(nullptr);
+        startGame({levelPath}, 1);
+
+        Round &round = game->getRound();
+        InputLog log(options.seed, options.players);
+        log.startRound(levelPath, false, 0);
+        round.record(&log);
+
+        std::vector<std::vector<Uint8>> snapshots;
+        Uint64 saveCounter = 0;
+        while (!game->isOver() && round.getTicks() < options.maxTicksPerRound) {
+            if (round.getTicks() % D6_UPDATE_FREQUENCY == 0) {
+                Uint64 startCounter = SDL_GetPerformanceCounter();
+                BinaryWriter writer;
+                round.saveState(writer);
+                saveCounter += SDL_GetPerformanceCounter() - startCounter;
+                snapshots.push_back(writer.getData());
+            }
+
+            for (ScriptedInput &scriptedInput : inputs) {
+                scriptedInput.tick();
+            }
+            game->update(updateTime);
+        }
+        log.endRound(round.getTicks(), round.getChecksum());
+        round.record(nullptr);
+
+        // The rest of the round is played from the log, so restored rounds don't depend on the scripted inputs
+        const InputLog::Round &recordedRound = log.getRounds().back();
+        Uint64 restoreCounter = 0;
+        for (const std::vector<Uint8> &snapshot : snapshots) {
+            Uint64 startCounter = SDL_GetPerformanceCounter();
+            BinaryReader reader(snapshot);
+            round.restoreState(reader);
+            restoreCounter += SDL_GetPerformanceCounter() - startCounter;
+
+            round.replay(recordedRound);
+            while (!round.isReplayOver()) {
+                game->update(updateTime);
+            }
+            stats.matches = stats.matches && round.getChecksum() == recordedRound.checksum;
+
+            stats.averageBytes += snapshot.size();
+            stats.maxBytes = std::max(stats.maxBytes, snapshot.size());
+        }
+
+        stats.snapshots = snapshots.size();
+        if (stats.snapshots > 0) {
+            Float64 frequency = Float64(SDL_GetPerformanceFrequency()) * stats.snapshots;
+            stats.averageBytes /= stats.snapshots;
+            stats.saveSeconds = saveCounter / frequency;
+            stats.restoreSeconds = restoreCounter / frequency;
+        }
+        return stats;
+    }
+
+    Simulator::ShotStress Simulator::measureShotStress(const std::string &levelPath, Uint64 ticks) {
+        ShotStress stress;
+        stress.level = levelPath;
+
+        Weapon machineGun;
+        for (Weapon weapon : Weapon::values()) {
+            if (weapon.getName() == "machine gun") {
+                machineGun = weapon;
+            }
+        }
+
+        gameSettings.setRecordPath("");
+        game->setReplay(nullptr);
+        // Rounds can still end when more hits come in one tick, the game then goes on with the next one
+        startGame({levelPath}, std::numeric_limits<Int32>::max());
+        for (ScriptedInput &scriptedInput : inputs) {
+            scriptedInput.hold(ScriptedInput::Shoot);
+        }
+
+        Uint64 updateCounter = 0;
+        Uint64 liveShots = 0;
+        while (stress.ticks < ticks && !game->isOver()) {
+            for (Player &player : game->getPlayers()) {
+                if (player.isAlive()) {
+                    if (player.getWeapon() != machineGun) {
+                        player.pickWeapon(machineGun, 0, 0);
+                    }
+                    if (player.getAmmo() < 1) {
+                        player.pickAmmo(100);
+                    }
+                    player.setFullLife();
+                }
+            }
+            for (ScriptedInput &scriptedInput : inputs) {
+                scriptedInput.tick();
+            }
+
+            Uint64 startCounter = SDL_GetPerformanceCounter();
+            game->update(updateTime);
+            updateCounter += SDL_GetPerformanceCounter() - startCounter;
+            stress.ticks++;
+
+            Size shots = game->getRound().getWorld().getShotList().getSize();
+            liveShots += shots;
+            stress.peakShots = std::max(stress.peakShots, shots);
+            stress.arenaSlots = game->getRound().getWorld().getShotList().getArena().getAllocatedSlots();
+        }
+        game->endRound();
+
+        stress.seconds = Float64(updateCounter) / SDL_GetPerformanceFrequency();
+        stress.averageShots = stress.ticks > 0 ? Float64(liveShots) / stress.ticks : 0;
+        for (const Person &person : persons) {
+            stress.shotsFired += person.getShots();
+        }
+        return stress;
+    }
+
+    Float64 Simulator::playShootingRound(const std::string &levelPath, Uint64 ticks,
+                                         std::vector<Uint64> &stateHashes) {
+        gameSettings.setRecordPath("");
+        game->setReplay(nullptr);
+        startGame({levelPath}, 1);
+        for (ScriptedInput &scriptedInput : inputs) {
+            scriptedInput.hold(ScriptedInput::Shoot);
+        }
+
+        Uint64 updateCounter = 0;
+        while (stateHashes.size() < ticks && !game->isOver()) {
+            for (ScriptedInput &scriptedInput : inputs) {
+                scriptedInput.tick();
+            }
+
+            Uint64 startCounter = SDL_GetPerformanceCounter();
+            game->update(updateTime);
+            updateCounter += SDL_GetPerformanceCounter() - startCounter;
+
+            BinaryWriter writer;
+            game->getRound().saveState(writer);
+            stateHashes.push_back(File::hash(writer.getData().data(), writer.getData().size()));
+        }
+        game->endRound();
+        return Float64(updateCounter) / SDL_GetPerformanceFrequency();
+    }
+
+    Simulator::ShotUpdateCheck Simulator::compareShotUpdates(const std::string &levelPath, Uint64 ticks) {
+        ShotUpdateCheck check;
+        check.level = levelPath;
+
+        std::vector<Uint64> referenceStates;
+        gameSettings.setBatchedShotUpdate(false);
+        check.referenceSeconds = playShootingRound(levelPath, ticks, referenceStates);
+
+        std::vector<Uint64> batchedStates;
+        gameSettings.setBatchedShotUpdate(true);
+        check.batchedSeconds = playShootingRound(levelPath, ticks, batchedStates);
+
+        check.ticks = std::max(referenceStates.size(), batchedStates.size());
+        for (Size i = 0; i < check.ticks; i++) {
+            if (i >= referenceStates.size() || i >= batchedStates.size() || referenceStates[i] != batchedStates[i]) {
+                check.firstMismatch = i + 1;
+                break;
+            }
+        }
+        return check;
+    }
+
+    std::vector<Simulator::TickRateCost> Simulator::measureTickRates(const std::string &levelPath,
+                                                                     const std::vector<Int32> &tickRates,
+                                                                     Float64 gameSeconds) {
+        std::vector<TickRateCost> costs;
+        for (Int32 tickRate : tickRates) {
+            TickRateCost cost;
+            cost.level = levelPath;
+            cost.tickRate = tickRate;
+
+            gameSettings.setRecordPath("");
+            game->setReplay(nullptr);
+            startGame({levelPath}, std::numeric_limits<Int32>::max());
+
+            Uint64 ticks = Uint64(gameSeconds * tickRate);
+            Uint64 updateCounter = 0;
+            while (cost.ticks < ticks && !game->isOver()) {
+                for (ScriptedInput &scriptedInput : inputs) {
+                    scriptedInput.tick();
+                }
+
+                Uint64 startCounter = SDL_GetPerformanceCounter();
+                game->update(1.0f / tickRate);
+                updateCounter += SDL_GetPerformanceCounter() - startCounter;
+                cost.ticks++;
+            }
+            game->endRound();
+
+            cost.seconds = Float64(updateCounter) / SDL_GetPerformanceFrequency();
+            costs.push_back(cost);
+        }
+        return costs;
+    }
+
+    Simulator::ThreadedTicks Simulator::measureThreadedTicks(const std::string &levelPath, Float64 frameSeconds,
+                                                             Float64 seconds) {
+        ThreadedTicks result;
+        result.level = levelPath;
+
+        gameSettings.setRecordPath("");
+        game->setReplay(nullptr);
+        startGame({levelPath}, 1);
+
+        TimeHistogram tickTimes;
+        SimulationThread simulation(tickTimes);
+        Context::push(*game);
+        simulation.start();
+
+        Uint64 frequency = SDL_GetPerformanceFrequency();
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        Uint64 endCounter = startCounter;
+        bool playing = true;
+        while (playing && endCounter - startCounter < Uint64(seconds * frequency)) {
+            {
+                std::lock_guard<TicketMutex> lock(simulation.getWorldMutex());
+                game->beforeRender();
+                playing = game->canUpdateConcurrently();
+            }
+            game->render();
+            // Stands in for a frame that takes long to draw
+            std::this_thread::sleep_for(std::chrono::microseconds(Int64(frameSeconds * 1000000)));
+            endCounter = SDL_GetPerformanceCounter();
+            result.frames++;
+        }
+
+        // Lets the simulation thread run the updates that got due during the last frame
+        std::this_thread::sleep_for(std::chrono::microseconds(2000000 / D6_UPDATE_FREQUENCY));
+        simulation.stop();
+        Context::pop();
+
+        result.ticks = tickTimes.getCount();
+        result.seconds = Float64(endCounter - startCounter) / frequency;
+        result.dueTicks = Uint64(result.seconds * D6_UPDATE_FREQUENCY);
+        return result;
+    }
+
+    Simulator::FormattingTimes Simulator::measureHudFormatting(Size frames) {
+        static constexpr FormatPattern rankingPattern("|{0,3}|{1,3}|{2,3}|{3,5}|{4,4}");
+        static constexpr FormatPattern bulletPattern("{0}");
+        static constexpr FormatPattern messagePattern("{0}: {1}");
+        static constexpr FormatPattern roundsPattern("Rounds: {0,3}|{1,3}");
+        static constexpr FormatPattern fpsPattern("FPS - {0}");
+
+        const std::string killsToDeaths = "1.50";
+        const std::string name = "Player";
+        const std::string message = "Picked up a bazooka";
+
+        FormattingTimes times;
+        std::vector<std::string> formatted;
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        for (Size frame = 0; frame < frames; frame++) {
+            formatted.clear();
+            Int32 value = Int32(frame % 1000);
+            for (Size i = 0; i < options.players; i++) {
+                formatted.push_back(Format("|{0,3}|{1,3}|{2,3}|{3,5}|{4,4}") << value << value / 2 << value / 3
+                                                                            << killsToDeaths << value * 4);
+                formatted.push_back(Format("{0}") << value);
+                formatted.push_back(Format("{0}: {1}") << name << message);
+            }
+            formatted.push_back(Format("Rounds: {0,3}|{1,3}") << value << 30);
+            formatted.push_back(Format("FPS - {0}") << value);
+        }
+        times.formatSeconds = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency() / frames;
+
+        std::vector<FormatBuffer<64>> buffers((options.players * 3) + 2);
+        startCounter = SDL_GetPerformanceCounter();
+        for (Size frame = 0; frame < frames; frame++) {
+            Size buffer = 0;
+            Int32 value = Int32(frame % 1000);
+            for (Size i = 0; i < options.players; i++) {
+                buffers[buffer].clear();
+                rankingPattern.format(buffers[buffer++], value, value / 2, value / 3, killsToDeaths, value * 4);
+                buffers[buffer].clear();
+                bulletPattern.format(buffers[buffer++], value);
+                buffers[buffer].clear();
+                messagePattern.format(buffers[buffer++], name, message);
+            }
+            buffers[buffer].clear();
+            roundsPattern.format(buffers[buffer++], value, 30);
+            buffers[buffer].clear();
+            fpsPattern.format(buffers[buffer++], value);
+        }
+        times.patternSeconds = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency() / frames;
+
+        // Both loops leave the texts of the last frame behind
+        for (Size i = 0; i < buffers.size(); i++) {
+            times.identical = times.identical && buffers[i].str() == formatted[i];
+        }
+        return times;
+    }
+
+    std::vector<Simulator::WallFaceCounts> Simulator::countWallFaces(const std::string &levelPath) {
+        const Block::Meta &blockMeta = gameResources.getBlockMeta();
+        std::shared_ptr<const CompiledLevel> compiledLevel = gameResources.getLevelCache().get(levelPath);
+
+        Random random(options.seed);
+        std::vector<WallFaceCounts> results;
+        for (bool mirror : {false, true}) {
+            for (ScreenMode screenMode : {ScreenMode::FullScreen, ScreenMode::SplitScreen}) {
+                Level level(*compiledLevel, mirror, Level::randomWaterBlock(random), blockMeta);
+                const LevelRenderData::WallFace *wallFaces = compiledLevel->getWallFaces(mirror, screenMode);
+                Size wallFaceCount = compiledLevel->getWallFaceCount(mirror, screenMode);
+
+                LevelRenderData separate(level, *renderer, screenMode, D6_ANM_SPEED, D6_WAVE_HEIGHT);
+                separate.prepareFaces(wallFaces, wallFaceCount, false);
+                LevelRenderData merged(level, *renderer, screenMode, D6_ANM_SPEED, D6_WAVE_HEIGHT);
+                merged.prepareFaces(wallFaces, wallFaceCount, true);
+
+                WallFaceCounts counts;
+                counts.level = levelPath;
+                counts.mirror = mirror;
+                counts.screenMode = screenMode;
+                counts.faces = separate.getWalls().getFaces().size();
+                counts.mergedFaces = merged.getWalls().getFaces().size();
+                counts.sameArea = getTotalArea(separate.getWalls()) == getTotalArea(merged.getWalls());
+                results.push_back(counts);
+            }
+        }
+        return results;
+    }
+
+    std::vector<Simulator::ChunkedMeshCheck> Simulator::compareChunkedMeshes(const std::string &levelPath) {
+        const Block::Meta &blockMeta = gameResources.getBlockMeta();
+        std::shared_ptr<const CompiledLevel> compiledLevel = gameResources.getLevelCache().get(levelPath);
+
+        Random random(options.seed);
+        std::vector<ChunkedMeshCheck> results;
+        for (bool mergeWalls : {false, true}) {
+            for (bool mirror : {false, true}) {
+                for (ScreenMode screenMode : {ScreenMode::FullScreen, ScreenMode::SplitScreen}) {
+                    Level level(*compiledLevel, mirror, Level::randomWaterBlock(random), blockMeta);
+                    const LevelRenderData::WallFace *wallFaces = compiledLevel->getWallFaces(mirror, screenMode);
+                    Size wallFaceCount = compiledLevel->getWallFaceCount(mirror, screenMode);
+
+                    LevelRenderData chunked(level, *renderer, screenMode, D6_ANM_SPEED, D6_WAVE_HEIGHT);
+                    chunked.prepareFaces(wallFaces, wallFaceCount, mergeWalls, true);
+                    LevelRenderData monolithic(level, *renderer, screenMode, D6_ANM_SPEED, D6_WAVE_HEIGHT);
+                    monolithic.prepareFaces(wallFaces, wallFaceCount, mergeWalls, false);
+
+                    ChunkedMeshCheck check;
+                    check.level = levelPath;
+                    check.mergeWalls = mergeWalls;
+                    check.mirror = mirror;
+                    check.screenMode = screenMode;
+                    check.chunks = chunked.getChunks().size();
+                    std::vector<FaceKey> faces = collectFaces(chunked, false);
+                    check.faces = faces.size();
+                    check.sameFaces = faces == collectFaces(monolithic, false);
+
+                    while (true) {
+                        Int32 waterLevel = level.getWaterLevel();
+                        level.raiseWater();
+                        if (level.getWaterLevel() == waterLevel) {
+                            break;
+                        }
+
+                        chunked.updateWaterRows(level.getWaterLevel() - 1, level.getWaterLevel() + 1);
+                        LevelRenderData rebuilt(level, *renderer, screenMode, D6_ANM_SPEED, D6_WAVE_HEIGHT);
+                        rebuilt.prepareFaces(wallFaces, wallFaceCount, mergeWalls, false);
+                        // Only water follows the rising level, sprites stay as they were when the level was loaded
+                        check.sameWaterRises = check.sameWaterRises &&
+                                               collectFaces(chunked, true) == collectFaces(rebuilt, true);
+                        check.waterRises++;
+                    }
+                    results.push_back(check);
+                }
+            }
+        }
+        return results;
+    }
+
+    Simulator::LoadTimes Simulator::measureLevelLoading(const std::string &levelPath, Size repeats) {
+        const Block::Meta &blockMeta = gameResources.getBlockMeta();
+        LevelCache &levelCache = gameResources.getLevelCache();
+        CompiledLevel::Source source = {File::getSize(levelPath), File::getModificationTime(levelPath), 0, 0};
+
+        Random random(options.seed);
+        LoadTimes times;
+        times.level = levelPath;
+        levelCache.get(levelPath);
+
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        for (Size i = 0; i < repeats; i++) {
+            CompiledLevel compiledLevel(CompiledLevel::compile(levelPath, source, blockMeta));
+            Level level(compiledLevel, false, Level::randomWaterBlock(random), blockMeta);
+        }
+        times.sourceSeconds = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency() / repeats;
+
+        startCounter = SDL_GetPerformanceCounter();
+        for (Size i = 0; i < repeats; i++) {
+            levelCache.clear();
+            Level level(*levelCache.get(levelPath), false, Level::randomWaterBlock(random), blockMeta);
+        }
+        times.cachedSeconds = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency() / repeats;
+
+        return times;
+    }
+
+    std::vector<Simulator::CompositionTimes> Simulator::measureSkinComposition(Size repeats) {
+        PlayerAnimations animations(gameResources.getPlayerAnimation());
+        std::vector<PlayerSkinColors> skinColors;
+        for (Size i = 0; i < repeats; i++) {
+            skinColors.push_back(PlayerSkinColors::makeRandom());
+        }
+
+        SpriteBlender::InstructionSet defaultInstructionSet = SpriteBlender::getInstructionSet();
+        std::vector<Image> scalarImages;
+        std::vector<CompositionTimes> results;
+        for (SpriteBlender::InstructionSet instructionSet : {SpriteBlender::InstructionSet::Scalar,
+                                                             SpriteBlender::InstructionSet::SSE2,
+                                                             SpriteBlender::InstructionSet::AVX2}) {
+            if (!SpriteBlender::isSupported(instructionSet)) {
+                continue;
+            }
+            SpriteBlender::setInstructionSet(instructionSet);
+
+            CompositionTimes times;
+            times.instructionSet = instructionSet;
+            std::vector<Image> images;
+            Uint64 startCounter = SDL_GetPerformanceCounter();
+            for (const PlayerSkinColors &colors : skinColors) {
+                images.push_back(animations.generateAnimationImage(*textureManager, colors));
+            }
+            times.seconds = Float64(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency() / repeats;
+
+            if (scalarImages.empty()) {
+                scalarImages = std::move(images);
+            } else {
+                for (Size i = 0; i < repeats; i++) {
+                    times.matchesScalar = times.matchesScalar && isSameImage(images[i], scalarImages[i]);
+                }
+            }
+            results.push_back(times);
+        }
+
+        SpriteBlender::setInstructionSet(defaultInstructionSet);
+        return results;
+    }
+}
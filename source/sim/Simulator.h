@@ -0,0 +1,316 @@
+/*
+* Copyright (c) 2006, Ondrej Danek (www.ondrej-danek.net)
+* All rights reserved.
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Ondrej Danek nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+* GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DUEL6_SIM_SIMULATOR_H
+#define DUEL6_SIM_SIMULATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Type.h"
+#include "../AppService.h"
+#include "../Font.h"
+#include "../Game.h"
+#include "../GameSettings.h"
+#include "../GameResources.h"
+#include "../InputLog.h"
+#include "../Person.h"
+#include "../SpriteBlender.h"
+#include "../gamemodes/DeathMatch.h"
+#include "../script/ScriptManager.h"
+#include "ScriptedInput.h"
+
+namespace Duel6 {
+    class HeadlessRenderer;
+
+    /**
+     * Runs complete matches without a window, a graphics context or an audio device.
+     * Players are driven by ScriptedInput and the game is stepped with the fixed update frequency,
+     * so a run with the same seed always plays out the same way.
+     */
+    class Simulator {
+    public:
+        struct Options {
+            Size players = 4;
+            Int32 roundsPerLevel = 5;
+            Uint32 seed = 1;
+            Uint32 maxTicksPerRound = 180 * D6_UPDATE_FREQUENCY;
+            bool render = false;
+        };
+
+        struct Result {
+            std::string level;
+            Int32 rounds = 0;
+            Uint64 ticks = 0;
+            Float64 seconds = 0;
+            Int32 kills = 0;
+            Int32 deaths = 0;
+            bool timedOut = false;
+            bool diverged = false;
+            Uint64 frames = 0;
+            Uint64 drawCalls = 0;
+            Uint64 stateChanges = 0;
+            Uint64 quads = 0;
+            Uint64 batchedQuads = 0;
+            Uint64 uploadedBytes = 0;
+            Uint64 createdTextures = 0; // Created after the game started, stays zero when text rendering is steady
+
+            Float64 getTicksPerSecond() const {
+                return seconds > 0 ? ticks / seconds : 0;
+            }
+
+            Float64 getRoundsPerSecond() const {
+                return seconds > 0 ? rounds / seconds : 0;
+            }
+
+            Float64 getDrawCallsPerFrame() const {
+                return frames > 0 ? Float64(drawCalls) / frames : 0;
+            }
+
+            Float64 getStateChangesPerFrame() const {
+                return frames > 0 ? Float64(stateChanges) / frames : 0;
+            }
+
+            /** Bytes face buffers sent to graphics memory per second of game time. */
+            Float64 getUploadedBytesPerSecond() const {
+                return ticks > 0 ? Float64(uploadedBytes) * D6_UPDATE_FREQUENCY / ticks : 0;
+            }
+        };
+
+        struct LoadTimes {
+            std::string level;
+            Float64 sourceSeconds = 0;
+            Float64 cachedSeconds = 0;
+        };
+
+        struct WallFaceCounts {
+            std::string level;
+            bool mirror = false;
+            ScreenMode screenMode = ScreenMode::FullScreen;
+            Size faces = 0;
+            Size mergedFaces = 0;
+            bool sameArea = true;
+        };
+
+        struct ChunkedMeshCheck {
+            std::string level;
+            bool mergeWalls = false;
+            bool mirror = false;
+            ScreenMode screenMode = ScreenMode::FullScreen;
+            Size chunks = 0;
+            Size faces = 0;
+            Size waterRises = 0;
+            bool sameFaces = true;
+            bool sameWaterRises = true;
+        };
+
+        struct SnapshotStats {
+            std::string level;
+            Size snapshots = 0;
+            Size averageBytes = 0;
+            Size maxBytes = 0;
+            Float64 saveSeconds = 0;
+            Float64 restoreSeconds = 0;
+            bool matches = true;
+        };
+
+        struct ShotStress {
+            std::string level;
+            Uint64 ticks = 0;
+            Float64 seconds = 0;
+            Int32 shotsFired = 0;
+            Float64 averageShots = 0;
+            Size peakShots = 0;
+            Size arenaSlots = 0;
+
+            Float64 getTicksPerSecond() const {
+                return seconds > 0 ? ticks / seconds : 0;
+            }
+        };
+
+        struct ShotUpdateCheck {
+            std::string level;
+            Uint64 ticks = 0;
+            Float64 referenceSeconds = 0;
+            Float64 batchedSeconds = 0;
+            Uint64 firstMismatch = 0; // Tick the world states differ first, zero when identical
+        };
+
+        struct TickRateCost {
+            std::string level;
+            Int32 tickRate = 0;
+            Uint64 ticks = 0;
+            Float64 seconds = 0;
+
+            // Seconds of game updates per second of game time
+            Float64 getLoad() const {
+                return ticks > 0 ? seconds * tickRate / ticks : 0;
+            }
+        };
+
+        struct ThreadedTicks {
+            std::string level;
+            Uint64 frames = 0;
+            Uint64 ticks = 0;
+            Uint64 dueTicks = 0; // Updates that got due while the frames were drawn
+            Float64 seconds = 0;
+
+            bool isComplete() const {
+                return ticks >= dueTicks;
+            }
+        };
+
+        struct FormattingTimes {
+            Float64 formatSeconds = 0;
+            Float64 patternSeconds = 0;
+            bool identical = true;
+        };
+
+        struct CompositionTimes {
+            SpriteBlender::InstructionSet instructionSet;
+            Float64 seconds = 0;
+            bool matchesScalar = true;
+        };
+
+    private:
+        Options options;
+        Console console;
+        Input input;
+        PlayerControlsManager controlsManager;
+        Sound sound;
+        GameSettings gameSettings;
+        GameResources gameResources;
+        Script::ScriptContext scriptContext;
+        Script::ScriptManager scriptManager;
+        Profiler profiler;
+        HeadlessRenderer *renderer;
+        std::unique_ptr<Video> video;
+        std::unique_ptr<TextureManager> textureManager;
+        std::unique_ptr<Font> font;
+        std::unique_ptr<AppService> service;
+        std::unique_ptr<Game> game;
+        DeathMatch gameMode;
+        PlayerSounds playerSounds;
+        std::vector<Size> backgrounds;
+        std::vector<Person> persons;
+        std::vector<ScriptedInput> inputs;
+        std::vector<std::unique_ptr<PlayerControls>> controls;
+
+    public:
+        explicit Simulator(const Options &options);
+
+        std::vector<std::string> listLevels() const;
+
+        /**
+         * Plays a match on the level.
+         * @param recordPath file to record the match to, empty for no recording
+         */
+        Result run(const std::string &levelPath, const std::string &recordPath = "");
+
+        /**
+         * Plays a recorded match again and checks that every round ends in the recorded state.
+         */
+        Result replay(const InputLog &log);
+
+        /**
+         * Measures average time to get a level ready from its JSON source and from the level cache.
+         */
+        LoadTimes measureLevelLoading(const std::string &levelPath, Size repeats);
+
+        /**
+         * Builds wall faces of every level variant with and without merging and checks
+         * that the merged faces cover exactly the same area.
+         */
+        std::vector<WallFaceCounts> countWallFaces(const std::string &levelPath);
+
+        /**
+         * Builds faces of every level variant, with and without wall merging, in chunks and as monolithic meshes
+         * and checks that the chunks draw exactly the same faces. Then raises the water row by row, updating only
+         * the affected chunks, and compares the water with monolithic meshes built from scratch after every rise.
+         */
+        std::vector<ChunkedMeshCheck> compareChunkedMeshes(const std::string &levelPath);
+
+        /**
+         * Measures average time to composite a player skin from man.ase with every supported sprite blender
+         * instruction set and checks that all of them produce the same images as the scalar one.
+         */
+        std::vector<CompositionTimes> measureSkinComposition(Size repeats);
+
+        /**
+         * Plays a round on the level taking a snapshot every second, then restores each snapshot,
+         * replays the rest of the round from it and checks that it ends in the same state.
+         * Times are averages per snapshot.
+         */
+        SnapshotStats measureSnapshots(const std::string &levelPath);
+
+        /**
+         * Plays the level with every player holding a machine gun with unlimited ammo, full life and
+         * the trigger pressed all the time. Only the game updates are timed.
+         */
+        ShotStress measureShotStress(const std::string &levelPath, Uint64 ticks);
+
+        /**
+         * Plays a round on the level twice with the same seed and every player holding the trigger, once
+         * updating shots one by one and once in batches, and compares the snapshots of the round after every tick.
+         */
+        ShotUpdateCheck compareShotUpdates(const std::string &levelPath, Uint64 ticks);
+
+        /**
+         * Plays the same game time on the level at every tick rate instead of D6_UPDATE_FREQUENCY, starting
+         * with the same seed. Only the game updates are timed.
+         */
+        std::vector<TickRateCost> measureTickRates(const std::string &levelPath, const std::vector<Int32> &tickRates,
+                                                   Float64 gameSeconds);
+
+        /**
+         * Updates the level on a simulation thread for the given time while this thread keeps drawing frames
+         * that take frameSeconds each from the published render state, like the application does, and counts
+         * the updates.
+         */
+        ThreadedTicks measureThreadedTicks(const std::string &levelPath, Float64 frameSeconds, Float64 seconds);
+
+        /**
+         * Measures average time to format the HUD texts of one frame (ranking, ammo, rounds, FPS and
+         * messages of every player) with Format and with pre-parsed patterns into fixed buffers.
+         */
+        FormattingTimes measureHudFormatting(Size frames);
+
+        Console &getConsole() {
+            return console;
+        }
+
+    private:
+        void startGame(const std::vector<std::string> &levels, Int32 rounds);
+
+        // Returns the time spent in game updates
+        Float64 playShootingRound(const std::string &levelPath, Uint64 ticks, std::vector<Uint64> &stateHashes);
+
+        void collectResult(Result &result, Uint64 startCounter, Uint64 startUploadedBytes, Uint64 startTextures);
+    };
+}
+
+#endif
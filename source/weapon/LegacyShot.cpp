@@ -28,6 +28,7 @@
 #include "../World.h"
 #include "../collision/Collision.h"
 #include "LegacyShot.h"
+#include "../BinaryStream.h"
 
 namespace Duel6 {
     LegacyShot::LegacyShot(Player &player, World &world, const LegacyWeapon &weapon, Animation shotAnimation,
@@ -52,7 +53,11 @@ namespace Duel6 {
     }
 
     void LegacyShot::move(Float32 elapsedTime) {
-        position += velocity * bulletSpeed * elapsedTime;
+        moveTo(position + velocity * bulletSpeed * elapsedTime);
+    }
+
+    void LegacyShot::moveTo(const Vector &position) {
+        this->position = position;
         sprite->setPosition(getSpritePosition());
     }
 
@@ -98,9 +103,17 @@ namespace Duel6 {
 
     bool LegacyShot::update(Float32 elapsedTime, World &world) {
         move(elapsedTime);
+        return resolveHit(world, checkWorldCollision(world.getLevel()).hit);
+    }
 
+    bool LegacyShot::update(const ShotStep &step, World &world) {
+        moveTo(step.position);
+        return resolveHit(world, step.hitsWall);
+    }
+
+    bool LegacyShot::resolveHit(World &world, bool hitsWall) {
         if (!shotHit.hit) {
-            shotHit = evaluateShotHit(world);
+            shotHit = evaluateShotHit(world, hitsWall);
         }
 
         if (shotHit.hit) {
@@ -176,10 +189,10 @@ namespace Duel6 {
         }
     }
 
-    ShotHit LegacyShot::evaluateShotHit(World &world) {
-        ShotHit hit = checkPlayerCollision(world.getPlayers());
+    ShotHit LegacyShot::evaluateShotHit(World &world, bool hitsWall) {
+        ShotHit hit = checkPlayerCollision(world);
         if (!hit.hit) {
-            hit = checkWorldCollision(world.getLevel());
+            hit = {hitsWall, nullptr, nullptr};
         }
         if (!hit.hit) {
             hit = checkShotCollision(world.getShotList(), world.getGameSettings().getShotCollision());
@@ -187,20 +200,23 @@ namespace Duel6 {
         return hit;
     }
 
-    ShotHit LegacyShot::checkPlayerCollision(std::vector<Player> &players) {
+    ShotHit LegacyShot::checkPlayerCollision(World &world) {
         const Rectangle shotBox = getCollisionRect();
+        ShotHit hit = {false, nullptr, nullptr};
 
-        for (Player &player : players) {
-            if (!player.isInGame() || player.getBonus() == BonusType::INVISIBILITY || player.is(getPlayer())) {
-                continue;
+        world.getPlayerGrid().forEach(shotBox, [this, &shotBox, &hit](SpatialGrid<Player *>::Key key, Player *player) -> bool {
+            if (!player->isInGame() || player->getBonus() == BonusType::INVISIBILITY || player->is(getPlayer())) {
+                return true;
             }
 
-            if (Collision::rectangles(player.getCollisionRect(), shotBox)) {
-                return {true, &player, nullptr};
+            if (Collision::rectangles(player->getCollisionRect(), shotBox)) {
+                hit = {true, player, nullptr};
+                return false;
             }
-        }
+            return true;
+        });
 
-        return {false, nullptr, nullptr};
+        return hit;
     }
 
     ShotHit LegacyShot::checkWorldCollision(const Level &level) {
@@ -223,7 +239,7 @@ namespace Duel6 {
 
         if (collisionSetting == ShotCollisionSetting::All ||
             (collisionSetting == ShotCollisionSetting::Large && isColliding())) {
-            shotList.forEach([this, &hit](Shot &otherShot) -> bool {
+            shotList.forEachInArea(getCollisionRect(), [this, &hit](Shot &otherShot) -> bool {
                 if (this != &otherShot && otherShot.requestCollision(*this)) {
                     hit.hit = true;
                     hit.collidingShotPlayer = &otherShot.getPlayer();
@@ -243,7 +259,7 @@ namespace Duel6 {
     void LegacyShot::addPlayerBlood(const Player &player, const Vector &point, World &world) {
         Rectangle rect = player.getCollisionRect();
         world.getExplosionList().add(
-                Vector(rect.left.x + (0.3f + (Math::random(40)) * 0.01f) * rect.getSize().x, point.y), 0.2f, 0.5f,
+                Vector(rect.left.x + (0.3f + (world.getRandom().random(40)) * 0.01f) * rect.getSize().x, point.y), 0.2f, 0.5f,
                 Color::RED);
     }
 
@@ -251,13 +267,13 @@ namespace Duel6 {
         return shotHit;
     }
 
-    SpriteList::Iterator LegacyShot::makeSprite(SpriteList &spriteList) {
+    SpriteList::Handle LegacyShot::makeSprite(SpriteList &spriteList) {
         sprite = spriteList.add(getShotAnimation(), textures.shot);
         sprite->setPosition(getSpritePosition(), 0.6f).setOrientation(this->orientation);
         return sprite;
     }
 
-    SpriteList::Iterator LegacyShot::makeBoomSprite(SpriteList &spriteList) {
+    SpriteList::Handle LegacyShot::makeBoomSprite(SpriteList &spriteList) {
         auto sprite = spriteList.add(getBoomAnimation(), textures.boom);
         sprite->setPosition(getCentre() - Vector(0.5f, 0.5f), 0.6f)
                 .setSpeed(0.5f)
@@ -266,4 +282,35 @@ namespace Duel6 {
                 .setAlpha(0.6f);
         return sprite;
     }
+
+    void LegacyShot::saveState(BinaryWriter &writer, const World &world) const {
+        const Player *players = world.getPlayers().data();
+        writer.write(orientation);
+        writer.write(position);
+        writer.write(velocity);
+        world.getSpriteList().saveHandle(writer, sprite);
+        writer.write(powerful);
+        writer.write(shotHit.hit);
+        writer.write(Int8(shotHit.collidingPlayer != nullptr ? shotHit.collidingPlayer - players : -1));
+        writer.write(Int8(shotHit.collidingShotPlayer != nullptr ? shotHit.collidingShotPlayer - players : -1));
+        writer.write(bulletSpeed);
+        writer.write(power);
+    }
+
+    void LegacyShot::restoreState(const Weapon &weapon, BinaryReader &reader, World &world) {
+        Player *players = world.getPlayers().data();
+        this->weapon = weapon;
+        reader.read(orientation);
+        reader.read(position);
+        reader.read(velocity);
+        sprite = world.getSpriteList().restoreHandle(reader);
+        reader.read(powerful);
+        reader.read(shotHit.hit);
+        Int8 collidingPlayer = reader.read<Int8>();
+        Int8 collidingShotPlayer = reader.read<Int8>();
+        shotHit.collidingPlayer = collidingPlayer >= 0 ? &players[collidingPlayer] : nullptr;
+        shotHit.collidingShotPlayer = collidingShotPlayer >= 0 ? &players[collidingShotPlayer] : nullptr;
+        reader.read(bulletSpeed);
+        reader.read(power);
+    }
 }
\ No newline at end of file
@@ -48,7 +48,7 @@ namespace Duel6 {
         Orientation orientation;
         Vector position;
         Vector velocity;
-        SpriteList::Iterator sprite;
+        SpriteList::Handle sprite;
         bool powerful;
         ShotHit shotHit;
         Float32 bulletSpeed;
@@ -58,35 +58,45 @@ namespace Duel6 {
         LegacyShot(Player &player, World &world, const LegacyWeapon &weapon, Animation shotAnimation,
                    Animation boomAnimation, Orientation orientation, const Rectangle &collisionRect);
 
-        bool update(Float32 elapsedTime, World &world) override;
+        ShotMotion getMotion() const final {
+            return {position, getDimensions(), getVelocity()};
+        }
+
+        bool update(Float32 elapsedTime, World &world) final;
 
-        Rectangle getCollisionRect() const override {
+        bool update(const ShotStep &step, World &world) final;
+
+        Rectangle getCollisionRect() const final {
             return Rectangle::fromCornerAndSize(getPosition(), getDimensions());
         }
 
-        bool requestCollision(Shot &shot) override;
+        bool requestCollision(Shot &shot) final;
 
         void onHitPlayer(Player &player, bool directHit, const Vector &hitPoint, World &world) override;
 
         void onKillPlayer(Player &player, bool directHit, const Vector &hitPoint, World &world) override;
 
-        ShotHit getShotHit() override;
+        ShotHit getShotHit() final;
+
+        void saveState(BinaryWriter &writer, const World &world) const final;
 
-        Vector getDimensions() const override {
+        void restoreState(const Weapon &weapon, BinaryReader &reader, World &world);
+
+        Vector getDimensions() const final {
             return collisionRect.getSize();
         }
 
-        Vector getCentre() const override {
+        Vector getCentre() const final {
             return getCollisionRect().getCentre();
         }
 
-        Vector getVelocity() const override {
+        Vector getVelocity() const final {
             return velocity * bulletSpeed;
         }
 
         virtual bool isColliding() const;
 
-        bool isPowerful() const override;
+        bool isPowerful() const final;
 
         Float32 getPowerFactor() const;
 
@@ -118,13 +128,17 @@ namespace Duel6 {
 
         void move(Float32 elapsedTime);
 
+        void moveTo(const Vector &position);
+
+        bool resolveHit(World &world, bool hitsWall);
+
         virtual Float32 getExplosionRange() const;
 
         Float32 getExplosionPower() const;
 
-        ShotHit evaluateShotHit(World &world);
+        ShotHit evaluateShotHit(World &world, bool hitsWall);
 
-        ShotHit checkPlayerCollision(std::vector<Player> &players);
+        ShotHit checkPlayerCollision(World &world);
 
         ShotHit checkWorldCollision(const Level &level);
 
@@ -136,9 +150,9 @@ namespace Duel6 {
 
         void addPlayerBlood(const Player &player, const Vector &point, World &world);
 
-        SpriteList::Iterator makeSprite(SpriteList &spriteList);
+        SpriteList::Handle makeSprite(SpriteList &spriteList);
 
-        virtual SpriteList::Iterator makeBoomSprite(SpriteList &spriteList);
+        virtual SpriteList::Handle makeBoomSprite(SpriteList &spriteList);
     };
 }
 
@@ -69,7 +69,15 @@ namespace Duel6 {
         samples.shot.play();
     }
 
-    SpriteList::Iterator LegacyWeapon::makeSprite(SpriteList &spriteList) const {
+    ShotArena::Pointer LegacyWeapon::restoreShot(const Weapon &weapon, Player &player, World &world,
+                                                 BinaryReader &reader) const {
+        // Every shot of a legacy weapon is a legacy shot, the state overwrites what the shot took from the player
+        ShotArena::Pointer shot = makeShot(player, world, Orientation::Left);
+        static_cast<LegacyShot &>(*shot).restoreState(weapon, reader, world);
+        return shot;
+    }
+
+    SpriteList::Handle LegacyWeapon::makeSprite(SpriteList &spriteList) const {
         auto sprite = spriteList.add(definition.animation, textures.gun);
         sprite->setFrame(6).setLooping(AnimationLooping::OnceAndStop);
         return sprite;
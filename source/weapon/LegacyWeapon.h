@@ -31,6 +31,7 @@
 #include <string>
 #include "WeaponBase.h"
 #include "../Shot.h"
+#include "../ShotArena.h"
 #include "../SpriteList.h"
 
 namespace Duel6 {
@@ -72,7 +73,10 @@ namespace Duel6 {
 
         void shoot(Player &player, Orientation orientation, World &world) const override;
 
-        SpriteList::Iterator makeSprite(SpriteList &spriteList) const override;
+        ShotArena::Pointer restoreShot(const Weapon &weapon, Player &player, World &world,
+                                       BinaryReader &reader) const override;
+
+        SpriteList::Handle makeSprite(SpriteList &spriteList) const override;
 
         Texture getBonusTexture() const override;
 
@@ -89,7 +93,7 @@ namespace Duel6 {
         virtual Float32 getBulletSpeed() const = 0;
 
     protected:
-        virtual std::unique_ptr<Shot> makeShot(Player &player, World &world, Orientation orientation) const = 0;
+        virtual ShotArena::Pointer makeShot(Player &player, World &world, Orientation orientation) const = 0;
     };
 }
 
@@ -29,11 +29,12 @@
 #define DUEL6_SHOTBASE_H
 
 #include "../Shot.h"
+#include "../Weapon.h"
 
 namespace Duel6 {
     class ShotBase : public Shot {
     protected:
-        const Weapon &weapon;
+        Weapon weapon;
         Player &player;
 
     public:
@@ -27,6 +27,7 @@
 
 #include "Bazooka.h"
 #include "BazookaShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -43,7 +44,7 @@ namespace Duel6 {
         return 6.1f;
     }
 
-    std::unique_ptr<Shot> Bazooka::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<BazookaShot>(player, world, *this, orientation);
+    ShotArena::Pointer Bazooka::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<BazookaShot>(player, world, *this, orientation);
     }
 }
@@ -61,7 +61,7 @@ namespace Duel6 {
         return 3.0f;
     }
 
-    SpriteList::Iterator BazookaShot::makeBoomSprite(SpriteList &spriteList) {
+    SpriteList::Handle BazookaShot::makeBoomSprite(SpriteList &spriteList) {
         auto sprite = LegacyShot::makeBoomSprite(spriteList);
         sprite->setAlpha(1.0f).setBlendFunc(BlendFunc::SrcColor).setNoDepth(true);
         sprite->setGrow(1.83f * getPowerFactor());
@@ -27,6 +27,7 @@
 
 #include "DoubleLaser.h"
 #include "DoubleLaserShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -42,7 +43,7 @@ namespace Duel6 {
         return 12.2f;
     }
 
-    std::unique_ptr<Shot> DoubleLaser::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<DoubleLaserShot>(player, world, *this, orientation);
+    ShotArena::Pointer DoubleLaser::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<DoubleLaserShot>(player, world, *this, orientation);
     }
 }
@@ -57,7 +57,7 @@ namespace Duel6 {
         return 2.0f;
     }
 
-    SpriteList::Iterator DoubleLaserShot::makeBoomSprite(SpriteList &spriteList) {
+    SpriteList::Handle DoubleLaserShot::makeBoomSprite(SpriteList &spriteList) {
         auto sprite = LegacyShot::makeBoomSprite(spriteList);
         sprite->setAlpha(1.0f).setBlendFunc(BlendFunc::SrcColor).setNoDepth(true);
         sprite->setGrow(0.3f * getPowerFactor());
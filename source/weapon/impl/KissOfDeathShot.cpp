@@ -54,7 +54,7 @@ namespace Duel6 {
         return Color::MAGENTA;
     }
 
-    SpriteList::Iterator KissOfDeathShot::makeBoomSprite(SpriteList &spriteList) {
+    SpriteList::Handle KissOfDeathShot::makeBoomSprite(SpriteList &spriteList) {
         auto sprite = LegacyShot::makeBoomSprite(spriteList);
         sprite->setGrow(0.61f * getPowerFactor());
         return sprite;
@@ -27,6 +27,7 @@
 
 #include "MachineGun.h"
 #include "MachineGunShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -43,7 +44,7 @@ namespace Duel6 {
         return 9.15f;
     }
 
-    std::unique_ptr<Shot> MachineGun::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<MachineGunShot>(player, world, *this, orientation);
+    ShotArena::Pointer MachineGun::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<MachineGunShot>(player, world, *this, orientation);
     }
 }
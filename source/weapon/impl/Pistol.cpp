@@ -27,6 +27,7 @@
 
 #include "Pistol.h"
 #include "PistolShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -43,7 +44,7 @@ namespace Duel6 {
         return 9.15f;
     }
 
-    std::unique_ptr<Shot> Pistol::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<PistolShot>(player, world, *this, orientation);
+    ShotArena::Pointer Pistol::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<PistolShot>(player, world, *this, orientation);
     }
 }
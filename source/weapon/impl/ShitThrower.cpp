@@ -26,6 +26,7 @@
 */
 
 #include "ShitThrowerShot.h"
+#include "../../World.h"
 #include "ShitThrower.h"
 
 namespace Duel6 {
@@ -50,7 +51,7 @@ namespace Duel6 {
         return 5.49f;
     }
 
-    std::unique_ptr<Shot> ShitThrower::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<ShitThrowerShot>(player, world, *this, orientation, *brownSkin);
+    ShotArena::Pointer ShitThrower::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<ShitThrowerShot>(player, world, *this, orientation, *brownSkin);
     }
 }
@@ -24,7 +24,8 @@
 * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
 * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
-
+#include "ShitThrowerShot.h"
+#include "../../World.h"
 #include "ShitThrowerShot.h"
 
 namespace Duel6 {
@@ -55,10 +56,10 @@ namespace Duel6 {
     }
 
     void ShitThrowerShot::onHitPlayer(Player &player, bool directHit, const Vector &point, World &world) {
-        player.useTemporarySkin(brownSkin);
+        player.useTemporarySkin(brownSkin, world.getRandom());
     }
 
-    SpriteList::Iterator ShitThrowerShot::makeBoomSprite(SpriteList &spriteList) {
+    SpriteList::Handle ShitThrowerShot::makeBoomSprite(SpriteList &spriteList) {
         auto sprite = LegacyShot::makeBoomSprite(spriteList);
         sprite->setNoDepth(true).setGrow(2.44f * getPowerFactor());
         return sprite;
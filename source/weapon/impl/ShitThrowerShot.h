@@ -49,7 +49,7 @@ namespace Duel6 {
 
         Float32 getExplosionRange() const override;
 
-        SpriteList::Iterator makeBoomSprite(SpriteList &spriteList) override;
+        SpriteList::Handle makeBoomSprite(SpriteList &spriteList) override;
     };
 }
 
@@ -27,6 +27,7 @@
 
 #include "Shotgun.h"
 #include "ShotgunShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -43,7 +44,7 @@ namespace Duel6 {
         return 9.15f;
     }
 
-    std::unique_ptr<Shot> Shotgun::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<ShotgunShot>(player, world, *this, orientation);
+    ShotArena::Pointer Shotgun::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<ShotgunShot>(player, world, *this, orientation);
     }
 }
@@ -27,6 +27,7 @@
 
 #include "Slime.h"
 #include "SlimeShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -43,7 +44,7 @@ namespace Duel6 {
         return 7.93f;
     }
 
-    std::unique_ptr<Shot> Slime::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<SlimeShot>(player, world, *this, orientation);
+    ShotArena::Pointer Slime::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<SlimeShot>(player, world, *this, orientation);
     }
 }
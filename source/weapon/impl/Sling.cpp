@@ -27,6 +27,7 @@
 
 #include "Sling.h"
 #include "SlingShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -47,7 +48,7 @@ namespace Duel6 {
         return true;
     }
 
-    std::unique_ptr<Shot> Sling::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<SlingShot>(player, world, *this, orientation);
+    ShotArena::Pointer Sling::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<SlingShot>(player, world, *this, orientation);
     }
 }
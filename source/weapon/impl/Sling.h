@@ -40,7 +40,7 @@ namespace Duel6 {
         bool isChargeable() const override;
 
     protected:
-        std::unique_ptr<Shot> makeShot(Player &player, World &world, Orientation orientation) const override;
+        ShotArena::Pointer makeShot(Player &player, World &world, Orientation orientation) const override;
     };
 }
 
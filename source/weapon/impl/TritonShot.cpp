@@ -61,7 +61,7 @@ namespace Duel6 {
         return 4.0f;
     }
 
-    SpriteList::Iterator TritonShot::makeBoomSprite(SpriteList &spriteList) {
+    SpriteList::Handle TritonShot::makeBoomSprite(SpriteList &spriteList) {
         auto sprite = LegacyShot::makeBoomSprite(spriteList);
         sprite->setAlpha(1.0f).setBlendFunc(BlendFunc::SrcColor).setNoDepth(true);
         sprite->setGrow(4.27f * getPowerFactor());
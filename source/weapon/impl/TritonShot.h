@@ -44,7 +44,7 @@ namespace Duel6 {
         bool isColliding() const override;
 
     protected:
-        SpriteList::Iterator makeBoomSprite(SpriteList &spriteList) override;
+        SpriteList::Handle makeBoomSprite(SpriteList &spriteList) override;
 
         Float32 getExplosionRange() const override;
     };
@@ -27,6 +27,7 @@
 
 #include "Uzi.h"
 #include "UziShot.h"
+#include "../../World.h"
 
 namespace Duel6 {
     namespace {
@@ -43,7 +44,7 @@ namespace Duel6 {
         return 10.98f;
     }
 
-    std::unique_ptr<Shot> Uzi::makeShot(Player &player, World &world, Orientation orientation) const {
-        return std::make_unique<UziShot>(player, world, *this, orientation);
+    ShotArena::Pointer Uzi::makeShot(Player &player, World &world, Orientation orientation) const {
+        return world.getShotList().makeShot<UziShot>(player, world, *this, orientation);
     }
 }